@@ -0,0 +1,116 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "instrumentation.h"
+
+/*
+ *	Hooks that replace the allocator of the whole process, so that
+ *	--check-steady-state sees the allocations of this program, GSL, and
+ *	glibc itself. They are linked into the application only, and not into
+ *	libaqpe.so, whose host program keeps its own allocator.
+ *
+ *	The hooks forward to the allocator of glibc, so every block is allocated
+ *	and freed by the same allocator.
+ */
+extern void *	__libc_malloc(size_t size);
+extern void *	__libc_calloc(size_t numberOfMembers, size_t size);
+extern void *	__libc_realloc(void *  pointer, size_t size);
+extern void *	__libc_memalign(size_t alignment, size_t size);
+extern void	__libc_free(void *  pointer);
+
+void *
+malloc(size_t size)
+{
+	recordHeapOperation(false);
+
+	return __libc_malloc(size);
+}
+
+void *
+calloc(size_t numberOfMembers, size_t size)
+{
+	recordHeapOperation(false);
+
+	return __libc_calloc(numberOfMembers, size);
+}
+
+void *
+realloc(void *  pointer, size_t size)
+{
+	recordHeapOperation(false);
+
+	return __libc_realloc(pointer, size);
+}
+
+void *
+aligned_alloc(size_t alignment, size_t size)
+{
+	recordHeapOperation(false);
+
+	return __libc_memalign(alignment, size);
+}
+
+int
+posix_memalign(void **  pointer, size_t alignment, size_t size)
+{
+	void *	block;
+
+	if ((alignment % sizeof(void *) != 0) || ((alignment & (alignment - 1)) != 0))
+	{
+		return EINVAL;
+	}
+
+	recordHeapOperation(false);
+	block = __libc_memalign(alignment, size);
+	if (block == NULL)
+	{
+		return ENOMEM;
+	}
+	*pointer = block;
+
+	return 0;
+}
+
+void
+free(void *  pointer)
+{
+	if (pointer != NULL)
+	{
+		recordHeapOperation(true);
+	}
+
+	__libc_free(pointer);
+}
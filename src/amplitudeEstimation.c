@@ -0,0 +1,315 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "amplitudeEstimation.h"
+
+/*
+ *	The odd power 2k + 1 of the next circuit is kGroverPowerWidthFactor / sigma,
+ *	so that the likelihood of N shots is about 0.4 sqrt(N) times narrower than
+ *	the prior, and its fringe is at least kGroverPowerMinimumSteepness steep at
+ *	the prior mean.
+ */
+static const double	kGroverPowerWidthFactor = 0.2;
+static const double	kGroverPowerMinimumSteepness = 0.7;
+
+uint64_t
+calculateGroverPower(double standardDeviation)
+{
+	double	oddPower = kGroverPowerWidthFactor / standardDeviation;
+
+	return (oddPower < 3.0) ? 0 : (uint64_t) floor((oddPower - 1) / 2);
+}
+
+double
+foldAmplitudeAngle(double theta)
+{
+	double	folded = fmod(fabs(theta), M_PI);
+
+	return (folded > M_PI / 2) ? M_PI - folded : folded;
+}
+
+/*
+ *	The likelihood sin^2((2k + 1) theta_a) is symmetric about the points
+ *	where sin(2 (2k + 1) theta_a) = 0, and a prior that reaches one of them
+ *	gets a mirror peak. Of the powers down to half of the scheduled one, the
+ *	largest that puts the prior mean on a steep part of the fringe is used.
+ */
+static uint64_t
+selectSteepGroverPower(uint64_t groverPower, double meanValue)
+{
+	uint64_t	k;
+
+	for (k = groverPower; 2 * k >= groverPower; k--)
+	{
+		if (fabs(sin(2 * (2 * k + 1) * meanValue)) >= kGroverPowerMinimumSteepness)
+		{
+			return k;
+		}
+		if (k == 0)
+		{
+			break;
+		}
+	}
+
+	return groverPower;
+}
+
+bool
+runAmplitudeEstimationExperiment(AmplitudeExperiment *  experiment, const CommandLineArguments *  arguments, RFPEPrecomputation *  precomputation, size_t experimentNo, gsl_rng *  gslRNG)
+{
+	const double	targetAngle = asin(sqrt(arguments->targetAmplitude));
+	uint64_t	evidenceSampleCounts[2];
+	uint64_t	previousGroverPower = 0;
+	double		M;
+	size_t		i;
+
+	/*
+	 *	The initial prior covers [0, pi / 2], where the first circuit, with
+	 *	no Grover iteration, has a likelihood without aliases.
+	 */
+	*experiment = (AmplitudeExperiment) {
+		.experimentNo		= experimentNo,
+		.meanValue		= M_PI / 4,
+		.standardDeviation	= M_PI / 4,
+	};
+
+	if (arguments->verbose)
+	{
+		printf("\nStarting amplitude estimation Experiment #%zu:\n", experimentNo);
+		printf("---------------------------------------\n");
+	}
+
+	while (!experiment->converged && (experiment->numberOfIterations < kMaxNumberOfIterations))
+	{
+		uint64_t	groverPower = calculateGroverPower(experiment->standardDeviation);
+
+		/*
+		 *	A posterior that shrinks too fast in one update would otherwise
+		 *	jump to a depth whose aliases it cannot tell apart.
+		 */
+		groverPower = (groverPower > 2 * previousGroverPower + 1) ? 2 * previousGroverPower + 1 : groverPower;
+		groverPower = selectSteepGroverPower(groverPower, experiment->meanValue);
+		previousGroverPower = groverPower;
+		M = 2.0 * (2 * groverPower + 1);
+
+		/*
+		 *	The circuit measures 0 with probability cos^2((2k + 1) theta_a),
+		 *	which is (1 + cos(M theta_a)) / 2 with theta = 0.
+		 */
+		precomputeRFPE(precomputation, experiment->meanValue, experiment->standardDeviation, M, 0.0, gslRNG);
+
+		/*
+		 *	theta_a lies in [0, pi / 2], so the prior samples are folded onto
+		 *	it. The likelihood is invariant under the folding, so their
+		 *	log-probabilities stay valid, but mirror images of theta_a no
+		 *	longer pull the mean value away.
+		 */
+		for (i = 0; i < precomputation->numberOfPriorSamples; i++)
+		{
+			precomputation->priorOffsets[i] = foldAmplitudeAngle(experiment->meanValue + precomputation->priorOffsets[i]) - experiment->meanValue;
+		}
+		runQPECircuit(targetAngle, M, 0.0, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+		finishRFPE(precomputation, evidenceSampleCounts, &experiment->meanValue, &experiment->standardDeviation);
+
+		experiment->numberOfOracleCalls += arguments->numberOfEvidenceSamplesPerIteration * (2 * groverPower + 1);
+		accountCircuitMapping(&experiment->resources, (double) (2 * groverPower + 1), arguments->numberOfEvidenceSamplesPerIteration);
+		experiment->numberOfIterations++;
+
+		if (arguments->verbose)
+		{
+			printf("Iteration %zu: k = %"PRIu64", mean value of theta_a: %le, standard deviation of theta_a: %le\n", experiment->numberOfIterations, groverPower, experiment->meanValue, experiment->standardDeviation);
+		}
+
+		/*
+		 *	|da / dtheta_a| = |sin(2 theta_a)| <= 1, so the amplitude is at
+		 *	least as precise as theta_a.
+		 */
+		if (experiment->standardDeviation < arguments->precision)
+		{
+			experiment->converged = true;
+		}
+	}
+
+	experiment->amplitude = pow(sin(foldAmplitudeAngle(experiment->meanValue)), 2);
+
+	if (arguments->verbose)
+	{
+		printf("Amplitude estimation Experiment #%zu: %s after %zu circuits and %"PRIu64" oracle calls with amplitude %le.\n", experimentNo, experiment->converged ? "Converged" : "Did not converge", experiment->numberOfIterations, experiment->numberOfOracleCalls, experiment->amplitude);
+	}
+
+	return experiment->converged;
+}
+
+/*
+ *	The log-likelihood is a sum of terms sin^2((2 m_k + 1) theta) and
+ *	cos^2((2 m_k + 1) theta), whose fastest term has period
+ *	pi / (2 m_max + 1). A grid with kMaximumLikelihoodGridPointsPerPeriod
+ *	points per period of that term finds the basin of the maximum, and a
+ *	golden-section search refines it between the neighbouring grid points.
+ */
+static double
+calculateAmplitudeLogLikelihood(double theta, const uint64_t *  groverPowers, const uint64_t *  countsOfOne, size_t numberOfStages, uint64_t numberOfShots)
+{
+	double	logLikelihood = 0.0;
+	size_t	k;
+
+	for (k = 0; k < numberOfStages; k++)
+	{
+		double	probabilityOfOne = pow(sin((2 * groverPowers[k] + 1) * theta), 2);
+
+		logLikelihood += countsOfOne[k] * log(fmax(probabilityOfOne, 1e-300)) + (numberOfShots - countsOfOne[k]) * log(fmax(1 - probabilityOfOne, 1e-300));
+	}
+
+	return logLikelihood;
+}
+
+double
+estimateAmplitudeAngleByMaximumLikelihood(const uint64_t *  groverPowers, const uint64_t *  countsOfOne, size_t numberOfStages, uint64_t numberOfShots)
+{
+	const double	goldenRatio = (sqrt(5.0) - 1) / 2;
+	double		bestTheta = M_PI / 4;
+	double		halfWidth = M_PI / 4;
+	size_t		numberOfUsedStages;
+
+	/*
+	 *	A grid over all of [0, pi / 2] would need a number of points
+	 *	proportional to the largest Grover power. Instead, the maximum of
+	 *	the likelihood of the first stages is searched for within half a
+	 *	period of the largest power so far around the maximum of one stage
+	 *	fewer, as the stages are added one at a time.
+	 */
+	for (numberOfUsedStages = 1; numberOfUsedStages <= numberOfStages; numberOfUsedStages++)
+	{
+		const uint64_t	oddPower = 2 * groverPowers[numberOfUsedStages - 1] + 1;
+		const double	lowerEnd = fmax(bestTheta - halfWidth, 0.0);
+		const double	upperEnd = fmin(bestTheta + halfWidth, M_PI / 2);
+		size_t		numberOfGridPoints = (size_t) ceil(kMaximumLikelihoodGridPointsPerPeriod * (upperEnd - lowerEnd) * oddPower / M_PI) + 1;
+		double		gridSpacing = (upperEnd - lowerEnd) / (numberOfGridPoints - 1);
+		double		bestLogLikelihood = -INFINITY;
+		double		lower;
+		double		upper;
+		size_t		i;
+
+		for (i = 0; i < numberOfGridPoints; i++)
+		{
+			double	theta = lowerEnd + i * gridSpacing;
+			double	logLikelihood = calculateAmplitudeLogLikelihood(theta, groverPowers, countsOfOne, numberOfUsedStages, numberOfShots);
+
+			if (logLikelihood > bestLogLikelihood)
+			{
+				bestLogLikelihood = logLikelihood;
+				bestTheta = theta;
+			}
+		}
+
+		lower = fmax(bestTheta - gridSpacing, lowerEnd);
+		upper = fmin(bestTheta + gridSpacing, upperEnd);
+		for (i = 0; i < kMaximumLikelihoodRefinementSteps; i++)
+		{
+			double	left = upper - goldenRatio * (upper - lower);
+			double	right = lower + goldenRatio * (upper - lower);
+
+			if (calculateAmplitudeLogLikelihood(left, groverPowers, countsOfOne, numberOfUsedStages, numberOfShots) < calculateAmplitudeLogLikelihood(right, groverPowers, countsOfOne, numberOfUsedStages, numberOfShots))
+			{
+				lower = left;
+			}
+			else
+			{
+				upper = right;
+			}
+		}
+
+		bestTheta = (lower + upper) / 2;
+		halfWidth = M_PI / (2 * oddPower);
+	}
+
+	return bestTheta;
+}
+
+int
+runAmplitudeEstimation(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	RFPEPrecomputation *	precomputation = allocRFPEPrecomputation(arguments->numberOfPriorTestSamplesPerIteration);
+	QuantumResources *	experimentResources = (QuantumResources *) malloc(arguments->numberOfRepetitions * sizeof(QuantumResources));
+	AmplitudeExperiment	experiment;
+	double			averageNumberOfIterations = 0.0;
+	double			averageNumberOfOracleCalls = 0.0;
+	double			averageError = 0.0;
+	double			sumOfSquaredErrors = 0.0;
+	size_t			wrongConvergenceCount = 0;
+	size_t			convergenceCount = 0;
+	size_t			i;
+
+	for (i = 0; i < arguments->numberOfRepetitions; i++)
+	{
+		if (runAmplitudeEstimationExperiment(&experiment, arguments, precomputation, i + 1, gslRNG))
+		{
+			double	error = fabs(arguments->targetAmplitude - experiment.amplitude);
+
+			averageNumberOfIterations += (double) experiment.numberOfIterations;
+			averageNumberOfOracleCalls += (double) experiment.numberOfOracleCalls;
+			averageError += error;
+			sumOfSquaredErrors += error * error;
+			wrongConvergenceCount += (error > 4 * arguments->precision);
+			convergenceCount++;
+		}
+		experimentResources[i] = experiment.resources;
+	}
+
+	if (convergenceCount == 0)
+	{
+		printf("\nConvergence failed for all %zu amplitude estimation experiments within the allowed maximum limit of %d circuits!\n", arguments->numberOfRepetitions, kMaxNumberOfIterations);
+	}
+	else
+	{
+		printf("\nConvergence achieved on average in %lf circuits and %le oracle calls in %zu of %zu amplitude estimation experiments, with an average amplitude estimation error of %le and a root mean square error of %le.\n",
+			averageNumberOfIterations / convergenceCount,
+			averageNumberOfOracleCalls / convergenceCount,
+			convergenceCount,
+			arguments->numberOfRepetitions,
+			averageError / convergenceCount,
+			sqrt(sumOfSquaredErrors / convergenceCount));
+		printf("\nIn %zu out of %zu converging experiments, the amplitude estimation error was greater than 4 times the input precision %le.\n", wrongConvergenceCount, convergenceCount, 4 * arguments->precision);
+	}
+
+	printQuantumResourcesSummary(experimentResources, arguments->numberOfRepetitions);
+	freeRFPEPrecomputation(precomputation);
+	free(experimentResources);
+
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+#include "quantumResources.h"
+#include "rfpeSplit.h"
+#include "utilities.h"
+
+typedef enum
+{
+	kMaximumLikelihoodMaximumNumberOfStages = 24,
+	kMaximumLikelihoodGridPointsPerPeriod = 32,
+	kMaximumLikelihoodRefinementSteps = 60,
+} AmplitudeEstimationConstants;
+
+/*
+ *	State of one Bayesian amplitude estimation experiment. The amplitude is
+ *	a = sin^2(theta_a), and the posterior over theta_a is a Gaussian. A
+ *	circuit with k Grover iterations measures 1 with probability
+ *	sin^2((2k + 1) theta_a), which is the RFPE likelihood with
+ *	M = 2 (2k + 1) and theta = 0, so the updates are RFPE updates.
+ */
+typedef struct AmplitudeExperiment
+{
+	size_t			experimentNo;
+	double			meanValue;
+	double			standardDeviation;
+	double			amplitude;
+	size_t			numberOfIterations;
+	bool			converged;
+	uint64_t		numberOfOracleCalls;
+	QuantumResources	resources;
+} AmplitudeExperiment;
+
+/**
+ *	@brief	Choose the number of Grover iterations of the next circuit from the width of the posterior, before any cap.
+ *
+ *	@param	standardDeviation	: standard deviation of the posterior over theta_a
+ *	@return	uint64_t		: number k of Grover iterations, with 2k + 1 inversely proportional to the standard deviation
+ */
+uint64_t	calculateGroverPower(double standardDeviation);
+
+/**
+ *	@brief	Fold an angle onto [0, pi / 2], where sin^2 is one-to-one.
+ *
+ *	@param	theta	: angle
+ *	@return	double	: angle in [0, pi / 2] with the same sin^2
+ */
+double	foldAmplitudeAngle(double theta);
+
+/**
+ *	@brief	Run one Bayesian amplitude estimation experiment until the standard deviation of theta_a is below the precision.
+ *
+ *	@param	experiment	: output experiment
+ *	@param	arguments	: command line arguments
+ *	@param	precomputation	: RFPE precomputation with -m prior samples
+ *	@param	experimentNo	: experiment number used in verbose output
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	bool		: true if the experiment converged
+ */
+bool	runAmplitudeEstimationExperiment(AmplitudeExperiment *  experiment, const CommandLineArguments *  arguments, RFPEPrecomputation *  precomputation, size_t experimentNo, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Estimate theta_a by maximum likelihood from the counts of a fixed schedule of increasing Grover powers, as MLE-QAE does.
+ *
+ *	@param	groverPowers		: number of Grover iterations of each stage
+ *	@param	countsOfOne		: count of outcome 1 of each stage
+ *	@param	numberOfStages		: number of stages
+ *	@param	numberOfShots		: number of shots of each stage
+ *	@return	double			: maximum likelihood estimate of theta_a in [0, pi / 2]
+ */
+double	estimateAmplitudeAngleByMaximumLikelihood(const uint64_t *  groverPowers, const uint64_t *  countsOfOne, size_t numberOfStages, uint64_t numberOfShots);
+
+/**
+ *	@brief	Run -r Bayesian amplitude estimation experiments and report the results across experiments.
+ *
+ *	@param	arguments	: command line arguments
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runAmplitudeEstimation(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
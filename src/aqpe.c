@@ -0,0 +1,790 @@
+/*
+ *	Authored 2023, Bilgesu Bilgin.
+ *
+ *	Copyright (c) 2023, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_randist.h>
+#include <sys/time.h>
+#include "aqpe.h"
+#include "convergenceCurves.h"
+#include "instrumentation.h"
+
+unsigned long
+initRNG(gsl_rng *  gslRNG)
+{
+	unsigned long	randomSeed = 0;
+
+	if (randomSeed == 0)
+	{
+		/*
+		 *	Set random seed from time of day.
+		 */
+		struct timeval	tv;
+		gettimeofday(&tv, 0);
+		randomSeed = ((tv.tv_sec>>10) ^ (tv.tv_usec<<10)) + 1;
+	}
+	fprintf(stderr, "Setting random seed to %lu.\n", randomSeed);
+	gsl_rng_set(gslRNG, randomSeed);
+
+	return randomSeed;
+}
+
+double
+calculateM(double standardDeviation, double alpha)
+{
+	if (standardDeviation == 0.0)
+	{
+		return 1.0;
+	}
+	else
+	{
+		return 1 / pow(standardDeviation, alpha);
+	}
+}
+
+double
+calculateTheta(double meanValue, double standardDeviation)
+{
+	return meanValue - standardDeviation;
+}
+
+void
+sampleFromRestrictedGaussian(double mu, double sigma, double *  samples, size_t  numberOfSamples, gsl_rng *  gslRNG)
+{
+	double	gaussianSample;
+	size_t	numberOfValidSamples = 0;
+	size_t	numberOfAttempts = 0;
+
+	while (numberOfValidSamples < numberOfSamples)
+	{
+		gaussianSample = gsl_ran_gaussian(gslRNG, sigma) + mu;
+		numberOfAttempts++;
+
+		if (numberOfAttempts == kRestrictedGaussianMaximumAttempts)
+		{
+			gaussianSample -= 2 * M_PI * round(gaussianSample / (2 * M_PI));
+		}
+
+		if ((fabs(gaussianSample) < M_PI) || (numberOfAttempts == kRestrictedGaussianMaximumAttempts))
+		{
+			samples[numberOfValidSamples] = gaussianSample;
+			numberOfValidSamples++;
+			numberOfAttempts = 0;
+		}
+	}
+
+	return;
+}
+
+void
+sampleOffsetsFromRestrictedGaussian(double mu, double sigma, double *  offsets, size_t  numberOfSamples, gsl_rng *  gslRNG)
+{
+	double	offset;
+	size_t	numberOfValidSamples = 0;
+	size_t	numberOfAttempts = 0;
+
+	while (numberOfValidSamples < numberOfSamples)
+	{
+		offset = gsl_ran_gaussian(gslRNG, sigma);
+		numberOfAttempts++;
+
+		if (numberOfAttempts == kRestrictedGaussianMaximumAttempts)
+		{
+			offset -= 2 * M_PI * round((mu + offset) / (2 * M_PI));
+		}
+
+		if ((fabs(mu + offset) < M_PI) || (numberOfAttempts == kRestrictedGaussianMaximumAttempts))
+		{
+			offsets[numberOfValidSamples] = offset;
+			numberOfValidSamples++;
+			numberOfAttempts = 0;
+		}
+	}
+
+	return;
+}
+
+void
+runQPECircuit(double phi, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+{
+	double		probabilityEvidence0GivenPhiPrior;
+	double		uniformSample;
+	uint64_t	i;
+
+	probabilityEvidence0GivenPhiPrior = (1 + cos(M * (phi - theta))) / 2;
+	evidenceSampleCounts[0] = 0;
+
+	for (i = 0; i < numberOfEvidenceSamples; i++)
+	{
+		uniformSample = gsl_ran_flat(gslRNG, 0.0, 1.0);
+		if (uniformSample < probabilityEvidence0GivenPhiPrior)
+		{
+			evidenceSampleCounts[0]++;
+		}
+	}
+	evidenceSampleCounts[1] = numberOfEvidenceSamples - evidenceSampleCounts[0];
+
+	return;
+}
+
+void
+runNoisyQPECircuit(double phi, double decoherenceRate, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+{
+	double		probabilityEvidence0GivenPhiPrior;
+	double		uniformSample;
+	uint64_t	i;
+
+	/*
+	 *	Decoherence reduces the visibility of the interference fringe exponentially with the depth.
+	 */
+	probabilityEvidence0GivenPhiPrior = (1 + exp(-decoherenceRate * M) * cos(M * (phi - theta))) / 2;
+	evidenceSampleCounts[0] = 0;
+
+	for (i = 0; i < numberOfEvidenceSamples; i++)
+	{
+		uniformSample = gsl_ran_flat(gslRNG, 0.0, 1.0);
+		if (uniformSample < probabilityEvidence0GivenPhiPrior)
+		{
+			evidenceSampleCounts[0]++;
+		}
+	}
+	evidenceSampleCounts[1] = numberOfEvidenceSamples - evidenceSampleCounts[0];
+
+	return;
+}
+
+void
+runShotRecordQPECircuit(const ShotRecordCircuitHeader *  circuit, const ShotNoise *  noise, uint64_t *  evidenceSampleCounts, uint64_t *  words, ShotRecordFile *  recordFile, gsl_rng *  gslRNG)
+{
+	ShotRecordGenerator	generator;
+	uint64_t		remainingShots = circuit->numberOfShots;
+	uint64_t		seed;
+
+	seed = (uint64_t) gsl_rng_get(gslRNG) << 32;
+	seed ^= gsl_rng_get(gslRNG);
+	seedShotRNG(&generator.rng, seed);
+	initShotRecordGenerator(&generator, 1 - circuit->probabilityOfZero, noise);
+	evidenceSampleCounts[1] = 0;
+
+	if (recordFile != NULL)
+	{
+		appendShotRecordCircuitHeader(recordFile, circuit);
+	}
+
+	/*
+	 *	Shots are drawn in chunks, so that any number of shots fits the buffer.
+	 */
+	while (remainingShots > 0)
+	{
+		uint64_t	chunkShots = (remainingShots < (uint64_t) kShotRecordChunkNumberOfWords * kShotRecordShotsPerWord) ? remainingShots : (uint64_t) kShotRecordChunkNumberOfWords * kShotRecordShotsPerWord;
+
+		generateShotRecord(&generator, words, chunkShots);
+		evidenceSampleCounts[1] += countShotRecordOnes(words, chunkShots);
+
+		if (recordFile != NULL)
+		{
+			appendShotRecordWords(recordFile, words, (chunkShots + kShotRecordShotsPerWord - 1) / kShotRecordShotsPerWord);
+		}
+		remainingShots -= chunkShots;
+	}
+	evidenceSampleCounts[0] = circuit->numberOfShots - evidenceSampleCounts[1];
+
+	return;
+}
+
+size_t
+doRFPE(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
+{
+	double		evidenceProbabilityGivenPriorSamples[numberOfPriorSamples];
+	double		logEvidenceProbabilityGivenPriorSamples[numberOfPriorSamples];
+	double		evidenceZeroProbabilityGivenPriorSamples[numberOfPriorSamples];
+	double		maxOfLogEvidenceProbability;
+	double		uniformSample;
+	double		currentMeanValue = *meanValue;
+	double		currentStandardDeviation = *standardDeviation;
+	size_t		numberOfAcceptedPriorSamples = 0;
+	size_t		i;
+	
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		evidenceZeroProbabilityGivenPriorSamples[i] = (1 + cos(M * (priorSamples[i] - theta))) / 2;
+		logEvidenceProbabilityGivenPriorSamples[i] = 0.0;
+	}
+	
+	for (size_t k = 0; k < 2; k++)
+	{
+		/*
+		 *	An outcome that was never observed contributes nothing, even
+		 *	where its probability is 0 and 0 * log(0) would give NaN.
+		 */
+		if (evidenceSampleCounts[k] == 0)
+		{
+			continue;
+		}
+
+		maxOfLogEvidenceProbability = -INFINITY;
+		
+		for (i = 0; i < numberOfPriorSamples; i++)
+		{
+			if (k == 0)
+			{
+				logEvidenceProbabilityGivenPriorSamples[i] += log(evidenceZeroProbabilityGivenPriorSamples[i]) * evidenceSampleCounts[k];
+			}
+			else
+			{
+				logEvidenceProbabilityGivenPriorSamples[i] += log(1 - evidenceZeroProbabilityGivenPriorSamples[i]) * evidenceSampleCounts[k];
+			}
+
+			if (logEvidenceProbabilityGivenPriorSamples[i] > maxOfLogEvidenceProbability)
+			{
+				maxOfLogEvidenceProbability = logEvidenceProbabilityGivenPriorSamples[i];
+			}
+		}
+
+		for (i = 0; i < numberOfPriorSamples; i++)
+		{
+			logEvidenceProbabilityGivenPriorSamples[i] -= maxOfLogEvidenceProbability;
+		}
+	}
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		evidenceProbabilityGivenPriorSamples[i] = exp(logEvidenceProbabilityGivenPriorSamples[i]);
+	}
+
+	*meanValue = 0.0;
+	*standardDeviation = 0.0;
+	
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		uniformSample = gsl_ran_flat(gslRNG, 0.0, 1.0);
+
+		if (uniformSample <= evidenceProbabilityGivenPriorSamples[i])
+		{
+			numberOfAcceptedPriorSamples += 1;
+			*meanValue += priorSamples[i];
+			*standardDeviation += priorSamples[i] * priorSamples[i];
+		}
+	}
+
+	/*
+	 *	Without accepted samples, e.g. when the likelihood is NaN for every
+	 *	sample, the prior is kept and the caller sees the zero count.
+	 */
+	if (numberOfAcceptedPriorSamples == 0)
+	{
+		*meanValue = currentMeanValue;
+		*standardDeviation = currentStandardDeviation;
+	}
+	else if (numberOfAcceptedPriorSamples == 1)
+	{
+		*standardDeviation = currentStandardDeviation / 2;
+	}
+	else
+	{
+		*meanValue /= numberOfAcceptedPriorSamples;
+		*standardDeviation = sqrt(fmax((*standardDeviation / numberOfAcceptedPriorSamples) - (*meanValue * *meanValue), 0.0));
+		*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+	}
+
+	return numberOfAcceptedPriorSamples;
+}
+
+AQPEWorkspace *
+allocAQPEWorkspace(const CommandLineArguments *  arguments)
+{
+	AQPEWorkspace *	workspace = (AQPEWorkspace *) calloc(1, sizeof(AQPEWorkspace));
+
+	if (arguments->numberOfAncillas > 1)
+	{
+		workspace->multiOutcomeRFPE = allocMultiOutcomeRFPE(arguments->numberOfAncillas, arguments->numberOfPriorTestSamplesPerIteration);
+	}
+	else if (arguments->posteriorEngine == kPosteriorEngineMesh)
+	{
+		workspace->meshPosterior = allocMeshPosterior();
+	}
+	else if (arguments->posteriorEngine == kPosteriorEngineTempered)
+	{
+		workspace->temperedRFPE = allocTemperedRFPE(arguments->numberOfPriorTestSamplesPerIteration);
+	}
+	else if (arguments->posteriorEngine == kPosteriorEngineStratified)
+	{
+		workspace->stratifiedRFPE = allocStratifiedRFPE(arguments->numberOfPriorTestSamplesPerIteration);
+	}
+	else
+	{
+		workspace->rfpePrecomputation = allocRFPEPrecomputation(arguments->numberOfPriorTestSamplesPerIteration);
+	}
+
+	if (arguments->simulateShotRecords)
+	{
+		workspace->shotWords = (uint64_t *) malloc(kShotRecordChunkNumberOfWords * sizeof(uint64_t));
+	}
+
+	if (arguments->convergenceCurvesPath != NULL)
+	{
+		workspace->convergenceCurves = allocConvergenceCurves();
+	}
+
+	return workspace;
+}
+
+void
+freeAQPEWorkspace(AQPEWorkspace *  workspace)
+{
+	if (workspace->meshPosterior != NULL)
+	{
+		freeMeshPosterior(workspace->meshPosterior);
+	}
+	if (workspace->rfpePrecomputation != NULL)
+	{
+		freeRFPEPrecomputation(workspace->rfpePrecomputation);
+	}
+	if (workspace->temperedRFPE != NULL)
+	{
+		freeTemperedRFPE(workspace->temperedRFPE);
+	}
+	if (workspace->stratifiedRFPE != NULL)
+	{
+		freeStratifiedRFPE(workspace->stratifiedRFPE);
+	}
+	if (workspace->multiOutcomeRFPE != NULL)
+	{
+		freeMultiOutcomeRFPE(workspace->multiOutcomeRFPE);
+	}
+	free(workspace->shotWords);
+	if (workspace->convergenceCurves != NULL)
+	{
+		freeConvergenceCurves(workspace->convergenceCurves);
+	}
+	free(workspace);
+}
+
+void
+initAQPEExperiment(AQPEExperiment *  experiment, double initialMeanValue, double initialStandardDeviation, size_t experimentNo, const CommandLineArguments *  arguments)
+{
+	*experiment = (AQPEExperiment) {
+		.experimentNo		= experimentNo,
+		.meanValue		= initialMeanValue,
+		.standardDeviation	= initialStandardDeviation,
+		.numberOfIterations	= 0,
+		.converged		= false,
+		.abortReason		= kAQPEAbortReasonNone,
+		.resources		= {0},
+		.efficiency		= {0},
+	};
+
+	if (arguments->measureEfficiency)
+	{
+		initEstimatorEfficiency(&experiment->efficiency, initialStandardDeviation);
+	}
+
+	if (arguments->verbose)
+	{
+		printf("\nStarting AQPE Experiment #%zu:\n", experimentNo);
+		printf("-------------------------------\n");
+		printf("Iteration 0: Mean value of estimate Phi: %le,\tStandard deviation of estimate Phi: %le\n", experiment->meanValue, experiment->standardDeviation);
+	}
+}
+
+/*
+ *	Abort an experiment whose posterior has diverged: it became NaN or no
+ *	prior sample was accepted, its width did not shrink for a window of
+ *	iterations, or the evidence contradicted the prior for a window of
+ *	iterations, which happens when the mean is stuck at a wrong mode.
+ */
+static void
+detectAQPEDivergence(AQPEExperiment *  experiment, const CommandLineArguments *  arguments, size_t numberOfAcceptedPriorSamples, const uint64_t *  evidenceSampleCounts, double M, double theta, double priorMeanValue, double priorStandardDeviation)
+{
+	double	numberOfEvidenceSamples = (double) arguments->numberOfEvidenceSamplesPerIteration;
+	double	offset = M * (priorMeanValue - theta);
+	double	damping = exp(-0.5 * M * M * priorStandardDeviation * priorStandardDeviation);
+	double	predictedProbability;
+	double	predictedVariance;
+	double	surprise;
+
+	if ((numberOfAcceptedPriorSamples == 0) || isnan(experiment->meanValue) || isnan(experiment->standardDeviation))
+	{
+		experiment->abortReason = kAQPEAbortReasonInvalidPosterior;
+
+		return;
+	}
+
+	experiment->numberOfGrowingIterations = (experiment->standardDeviation >= priorStandardDeviation) ? experiment->numberOfGrowingIterations + 1 : 0;
+
+	/*
+	 *	Under the Gaussian prior, E[cos(M (phi - theta))] = cos(x) exp(-M^2 sigma^2 / 2),
+	 *	with x = M (mu - theta), and similarly for cos^2, which gives the mean and
+	 *	variance of the predicted count of outcome 0 in closed form.
+	 */
+	predictedProbability = (1 + cos(offset) * damping) / 2;
+	predictedVariance = numberOfEvidenceSamples * predictedProbability * (1 - predictedProbability)
+			+ numberOfEvidenceSamples * numberOfEvidenceSamples * fmax((1 + cos(2 * offset) * pow(damping, 4)) / 8 - cos(offset) * cos(offset) * damping * damping / 4, 0.0);
+	surprise = fabs(evidenceSampleCounts[0] - numberOfEvidenceSamples * predictedProbability) / sqrt(fmax(predictedVariance, DBL_MIN));
+
+	experiment->numberOfSurprisingIterations = (surprise > arguments->divergenceSurpriseThreshold) ? experiment->numberOfSurprisingIterations + 1 : 0;
+
+	if (experiment->numberOfGrowingIterations >= arguments->divergenceWindow)
+	{
+		experiment->abortReason = kAQPEAbortReasonGrowingWidth;
+	}
+	else if (experiment->numberOfSurprisingIterations >= arguments->divergenceWindow)
+	{
+		experiment->abortReason = kAQPEAbortReasonInconsistentEvidence;
+	}
+}
+
+/*
+ *	Posterior mass within the precision of the estimate, taken from the
+ *	representation of the engine. An RFPE update that accepted too few
+ *	samples for a fraction to mean anything falls back to the mass of the
+ *	Gaussian with the same standard deviation.
+ */
+static double
+calculateAQPECredibleMass(const AQPEExperiment *  experiment, const CommandLineArguments *  arguments, const AQPEWorkspace *  workspace)
+{
+	if (arguments->numberOfAncillas > 1)
+	{
+		if (workspace->multiOutcomeRFPE->numberOfAcceptedOffsets >= kCredibleIntervalMinimumNumberOfSamples)
+		{
+			return multiOutcomeRFPEMassWithin(workspace->multiOutcomeRFPE, arguments->precision);
+		}
+
+		return erf(arguments->precision / (experiment->standardDeviation * M_SQRT2));
+	}
+
+	switch (arguments->posteriorEngine)
+	{
+		case kPosteriorEngineMesh:
+			return meshPosteriorMassWithin(workspace->meshPosterior, experiment->meanValue, arguments->precision);
+		case kPosteriorEngineTempered:
+			return temperedRFPEMassWithin(workspace->temperedRFPE, experiment->meanValue, arguments->precision);
+		case kPosteriorEngineStratified:
+			return stratifiedRFPEMassWithin(workspace->stratifiedRFPE, experiment->meanValue, arguments->precision);
+		default:
+			if (workspace->rfpePrecomputation->numberOfAcceptedOffsets >= kCredibleIntervalMinimumNumberOfSamples)
+			{
+				return rfpeAcceptedMassWithin(workspace->rfpePrecomputation, arguments->precision);
+			}
+
+			return erf(arguments->precision / (experiment->standardDeviation * M_SQRT2));
+	}
+}
+
+/*
+ *	The default rule stops once the standard deviation is below the
+ *	precision. With a stopping confidence, it stops once the posterior mass
+ *	within the precision of the estimate reaches that confidence.
+ */
+static bool
+hasAQPEExperimentConverged(const AQPEExperiment *  experiment, const CommandLineArguments *  arguments, const AQPEWorkspace *  workspace)
+{
+	if (arguments->stoppingConfidence > 0.0)
+	{
+		return calculateAQPECredibleMass(experiment, arguments, workspace) >= arguments->stoppingConfidence;
+	}
+
+	return experiment->standardDeviation < arguments->precision;
+}
+
+/*
+ *	Publish the state of an experiment to the result stream of the calling thread.
+ */
+static void
+publishAQPEExperiment(ResultStreamWriter *  resultStream, const AQPEExperiment *  experiment, ResultStreamRecordType type, double M, double theta)
+{
+	ResultStreamRecord	record = {
+		.type			= type,
+		.flags			= experiment->converged ? kResultStreamRecordFlagConverged : 0,
+		.experimentNo		= experiment->experimentNo,
+		.numberOfIterations	= experiment->numberOfIterations,
+		.meanValue		= experiment->meanValue,
+		.standardDeviation	= experiment->standardDeviation,
+		.M			= M,
+		.theta			= theta,
+		.totalShots		= experiment->resources.totalShots,
+	};
+
+	publishToResultStream(resultStream, &record);
+}
+
+bool
+stepAQPEExperiment(AQPEExperiment *  experiment, const CommandLineArguments *  arguments, size_t maximumNumberOfIterations, AQPEWorkspace *  workspace, gsl_rng *  gslRNG, ResultStreamWriter *  resultStream)
+{
+	uint64_t	evidenceSampleCounts[2];
+	double		currentM = 0.0;
+	double		currentTheta = 0.0;
+	double		priorMeanValue;
+	double		priorStandardDeviation;
+	size_t		numberOfAcceptedPriorSamples;
+	size_t		i;
+
+	/*
+	 *	Loop over RFPE iterations
+	 */
+	for (i = 0; (i < maximumNumberOfIterations) && !isAQPEExperimentFinished(experiment); i++)
+	{
+		enterInstrumentationPhase(kInstrumentationPhaseSchedule);
+		currentM = calculateM(experiment->standardDeviation, arguments->alpha);
+		currentTheta = calculateTheta(experiment->meanValue, experiment->standardDeviation);
+
+		enterInstrumentationPhase(kInstrumentationPhasePrecompute);
+
+		/*
+		 *	Everything of the RFPE update that does not depend on the
+		 *	outcome is computed while the circuit runs. On hardware, this
+		 *	overlaps with the circuit, and only finishRFPE() remains on the
+		 *	critical path once the counts arrive.
+		 */
+		if ((arguments->posteriorEngine == kPosteriorEngineRFPE) && (arguments->numberOfAncillas <= 1))
+		{
+			precomputeRFPE(workspace->rfpePrecomputation, experiment->meanValue, experiment->standardDeviation, currentM, currentTheta, gslRNG);
+		}
+
+		enterInstrumentationPhase(kInstrumentationPhaseCircuit);
+		if (arguments->numberOfAncillas > 1)
+		{
+			runMultiOutcomeQPECircuit(workspace->multiOutcomeRFPE, arguments->targetPhi, arguments->decoherenceRate, currentM, currentTheta, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+		}
+		else if (arguments->simulateShotRecords)
+		{
+			ShotRecordCircuitHeader	circuit = {
+				.experimentNo		= experiment->experimentNo,
+				.iteration		= experiment->numberOfIterations + 1,
+				.M			= currentM,
+				.theta			= currentTheta,
+				.probabilityOfZero	= (1 + exp(-arguments->decoherenceRate * currentM) * cos(currentM * (arguments->targetPhi - currentTheta))) / 2,
+				.numberOfShots		= arguments->numberOfEvidenceSamplesPerIteration,
+			};
+			ShotNoise		noise = {
+				.flipProbability	= arguments->readoutFlipProbability,
+				.correlation		= arguments->readoutFlipCorrelation,
+			};
+
+			runShotRecordQPECircuit(&circuit, &noise, evidenceSampleCounts, workspace->shotWords, workspace->shotRecordFile, gslRNG);
+		}
+		else if (arguments->decoherenceRate > 0.0)
+		{
+			runNoisyQPECircuit(arguments->targetPhi, arguments->decoherenceRate, currentM, currentTheta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+		}
+		else
+		{
+			runQPECircuit(arguments->targetPhi, currentM, currentTheta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+		}
+		/*
+		 *	The t ancillas of a K-outcome circuit control U^M, U^(2M), ...,
+		 *	U^(2^(t-1) M), for a depth of (K - 1) M. Arguments that were not
+		 *	set up by initCommandLineArguments() may have t = 0, which is the
+		 *	circuit with one ancilla.
+		 */
+		accountCircuitMapping(&experiment->resources, currentM * (double) (((size_t) 1 << ((arguments->numberOfAncillas > 1) ? arguments->numberOfAncillas : 1)) - 1), arguments->numberOfEvidenceSamplesPerIteration);
+		priorMeanValue = experiment->meanValue;
+		priorStandardDeviation = experiment->standardDeviation;
+
+		enterInstrumentationPhase(kInstrumentationPhaseUpdate);
+		if (arguments->numberOfAncillas > 1)
+		{
+			numberOfAcceptedPriorSamples = doMultiOutcomeRFPE(workspace->multiOutcomeRFPE, currentM, currentTheta, &experiment->meanValue, &experiment->standardDeviation, gslRNG);
+		}
+		else if (arguments->posteriorEngine == kPosteriorEngineMesh)
+		{
+			if (experiment->numberOfIterations == 0)
+			{
+				initMeshPosterior(workspace->meshPosterior, experiment->meanValue, experiment->standardDeviation);
+			}
+			updateMeshPosterior(workspace->meshPosterior, evidenceSampleCounts, currentM, currentTheta);
+			experiment->meanValue = workspace->meshPosterior->meanValue;
+			experiment->standardDeviation = workspace->meshPosterior->standardDeviation;
+			numberOfAcceptedPriorSamples = workspace->meshPosterior->numberOfCells;
+		}
+		else if (arguments->posteriorEngine == kPosteriorEngineTempered)
+		{
+			numberOfAcceptedPriorSamples = doTemperedRFPE(workspace->temperedRFPE, evidenceSampleCounts, currentM, currentTheta, &experiment->meanValue, &experiment->standardDeviation, gslRNG);
+		}
+		else if (arguments->posteriorEngine == kPosteriorEngineStratified)
+		{
+			numberOfAcceptedPriorSamples = doStratifiedRFPE(workspace->stratifiedRFPE, evidenceSampleCounts, currentM, currentTheta, &experiment->meanValue, &experiment->standardDeviation, gslRNG);
+		}
+		else
+		{
+			numberOfAcceptedPriorSamples = finishRFPE(workspace->rfpePrecomputation, evidenceSampleCounts, &experiment->meanValue, &experiment->standardDeviation);
+		}
+		experiment->numberOfIterations++;
+		enterInstrumentationPhase(kInstrumentationPhaseBookkeeping);
+
+		if (arguments->verbose)
+		{
+			printf("\nIteration %zu: Mean value of estimate Phi: %le,\tStandard deviation of estimate Phi: %le\n", experiment->numberOfIterations, experiment->meanValue, experiment->standardDeviation);
+		}
+
+		/*
+		 *	The information of the circuit is evaluated at the prior mean, with
+		 *	the visibility of the simulated hardware.
+		 */
+		if (arguments->measureEfficiency)
+		{
+			double	iterationEfficiency = accountCircuitInformation(&experiment->efficiency, arguments->numberOfEvidenceSamplesPerIteration, currentM, currentTheta, priorMeanValue, exp(-arguments->decoherenceRate * currentM), experiment->standardDeviation);
+
+			if (arguments->verbose)
+			{
+				printf("Iteration %zu: Cramer-Rao bound on std: %le,\tEfficiency: %lf\n", experiment->numberOfIterations, 1 / sqrt(experiment->efficiency.fisherInformation), iterationEfficiency);
+			}
+		}
+
+		if (workspace->convergenceCurves != NULL)
+		{
+			double	values[kConvergenceCurveNumberOfQuantities] = {
+				[kConvergenceCurveStandardDeviation]	= experiment->standardDeviation,
+				[kConvergenceCurveError]		= fabs(arguments->targetPhi - experiment->meanValue),
+				[kConvergenceCurveM]			= currentM,
+				[kConvergenceCurveAcceptedSamples]	= (double) numberOfAcceptedPriorSamples,
+			};
+
+			accumulateConvergenceCurves(workspace->convergenceCurves, experiment->numberOfIterations, values);
+		}
+
+		/*
+		 *	If the posterior is within the precision by the stopping rule, terminate.
+		 */
+		if (hasAQPEExperimentConverged(experiment, arguments, workspace))
+		{
+			experiment->converged = true;
+		}
+		else if (arguments->abortDivergent)
+		{
+			detectAQPEDivergence(experiment, arguments, numberOfAcceptedPriorSamples, evidenceSampleCounts, currentM, currentTheta, priorMeanValue, priorStandardDeviation);
+
+			if (arguments->verbose && (experiment->abortReason != kAQPEAbortReasonNone))
+			{
+				printf("Iteration %zu: Aborting the diverging experiment.\n", experiment->numberOfIterations);
+			}
+		}
+
+		if (resultStream != NULL)
+		{
+			publishAQPEExperiment(resultStream, experiment, kResultStreamRecordIteration, currentM, currentTheta);
+		}
+	}
+
+	if ((resultStream != NULL) && (i > 0) && isAQPEExperimentFinished(experiment))
+	{
+		publishAQPEExperiment(resultStream, experiment, kResultStreamRecordExperiment, currentM, currentTheta);
+	}
+
+	return isAQPEExperimentFinished(experiment);
+}
+
+bool
+isAQPEExperimentFinished(const AQPEExperiment *  experiment)
+{
+	return experiment->converged || (experiment->numberOfIterations >= kMaxNumberOfIterations) || (experiment->abortReason != kAQPEAbortReasonNone);
+}
+
+const char *
+aqpeAbortReasonName(AQPEAbortReason abortReason)
+{
+	switch (abortReason)
+	{
+		case kAQPEAbortReasonInvalidPosterior:
+			return "an invalid posterior";
+		case kAQPEAbortReasonGrowingWidth:
+			return "a posterior width that stopped shrinking";
+		case kAQPEAbortReasonInconsistentEvidence:
+			return "evidence inconsistent with the posterior";
+		default:
+			return "no divergence";
+	}
+}
+
+void
+reportAQPEExperiment(const AQPEExperiment *  experiment, const CommandLineArguments *  arguments)
+{
+	const QuantumResources *	resources = &experiment->resources;
+
+	if (!arguments->verbose)
+	{
+		return;
+	}
+
+	if (experiment->abortReason != kAQPEAbortReasonNone)
+	{
+		printf("\nAQPE Experiment #%zu: Aborted after %zu iterative circuit mappings to quantum hardware because of %s! The final estimate has mean value %le and standard deviation %le.\n", experiment->experimentNo, experiment->numberOfIterations, aqpeAbortReasonName(experiment->abortReason), experiment->meanValue, experiment->standardDeviation);
+	}
+	else if (experiment->converged)
+	{
+		printf("\nAQPE Experiment #%zu: Successfully acheieved precision in %zu iterative circuit mappings to quantum hardware! The final estimate has mean value %le and standard deviation %le.\n", experiment->experimentNo, experiment->numberOfIterations, experiment->meanValue, experiment->standardDeviation);
+	}
+	else
+	{
+		printf("\nAQPE Experiment #%zu: Could not converge within the maximum allowed number of %d iterative circuit mappings to quantum hardware! The final estimate has mean value %le and standard deviation %le.\n", experiment->experimentNo, kMaxNumberOfIterations, experiment->meanValue, experiment->standardDeviation);
+	}
+	printf("AQPE Experiment #%zu: Used %"PRIu64" shots, %le depth x shots, and a maximum depth of %"PRIu64" in %zu circuit mappings.\n", experiment->experimentNo, resources->totalShots, resources->depthShotProduct, resources->maximumDepth, resources->numberOfCircuitMappings);
+}
+
+bool
+runAQPEviaRFPEExperiment(double initialMeanValue, double initialStandardDeviation, CommandLineArguments *  arguments, size_t experimentNo, gsl_rng *  gslRNG, size_t *  convergenceIterationCount, double *  estimatedPhi, QuantumResources *  resources)
+{
+	AQPEExperiment	experiment;
+	AQPEWorkspace *	workspace;
+
+	/*
+	 *	Allocate arrays.
+	 */
+	workspace = allocAQPEWorkspace(arguments);
+
+	initAQPEExperiment(&experiment, initialMeanValue, initialStandardDeviation, experimentNo, arguments);
+	stepAQPEExperiment(&experiment, arguments, kMaxNumberOfIterations, workspace, gslRNG, NULL);
+
+	/*
+	 *	Report the results of the current experiment.
+	 */
+	reportAQPEExperiment(&experiment, arguments);
+
+	if (experiment.converged)
+	{
+		*estimatedPhi = experiment.meanValue;
+		*convergenceIterationCount = experiment.numberOfIterations;
+	}
+	*resources = experiment.resources;
+
+	/*
+	 *	Free allocated arrays.
+	 */
+	freeAQPEWorkspace(workspace);
+
+	return experiment.converged;
+}
@@ -0,0 +1,303 @@
+/*
+ *	Authored 2023, Bilgesu Bilgin.
+ *
+ *	Copyright (c) 2023, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <math.h>
+#include <gsl/gsl_rng.h>
+#include "estimatorEfficiency.h"
+#include "meshPosterior.h"
+#include "quantumResources.h"
+#include "resultStream.h"
+#include "rfpeMultiOutcome.h"
+#include "rfpeSplit.h"
+#include "rfpeStratified.h"
+#include "rfpeTempered.h"
+#include "shotRecord.h"
+#include "utilities.h"
+
+typedef enum
+{
+	kMaxNumberOfIterations = 100,
+	kPosteriorStandardDeviationIncreaseFactor = 1,
+	kRestrictedGaussianMaximumAttempts = 16,
+	kCredibleIntervalMinimumNumberOfSamples = 16,
+} Constants;
+
+/*
+ *	Initial prior of every experiment, which covers the whole circle.
+ */
+static const double	kInitialPriorMeanValue = 0.0;
+static const double	kInitialPriorStandardDeviation = M_PI / 2;
+
+typedef enum
+{
+	kAQPEAbortReasonNone,
+	kAQPEAbortReasonInvalidPosterior,
+	kAQPEAbortReasonGrowingWidth,
+	kAQPEAbortReasonInconsistentEvidence,
+	kAQPENumberOfAbortReasons,
+} AQPEAbortReason;
+
+/*
+ *	State of one AQPE experiment, which can be advanced a few iterations at a time.
+ *	An experiment finishes when it converges, reaches kMaxNumberOfIterations, or
+ *	is aborted by a divergence detector.
+ */
+typedef struct AQPEExperiment
+{
+	size_t			experimentNo;
+	double			meanValue;
+	double			standardDeviation;
+	size_t			numberOfIterations;
+	bool			converged;
+	AQPEAbortReason		abortReason;
+	size_t			numberOfGrowingIterations;
+	size_t			numberOfSurprisingIterations;
+	QuantumResources	resources;
+	EstimatorEfficiency	efficiency;
+} AQPEExperiment;
+
+/*
+ *	Signature of doRFPE() and of the kernels specialized for fixed numbers of
+ *	prior samples in rfpeKernels.h.
+ */
+typedef size_t (*RFPEKernel)(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+
+struct ConvergenceCurves;
+
+/*
+ *	Per-thread scratch state of the posterior engines. An experiment on the
+ *	mesh engine keeps its posterior in the workspace, so it must run to
+ *	completion on one workspace.
+ */
+typedef struct AQPEWorkspace
+{
+	RFPEPrecomputation *		rfpePrecomputation;
+	TemperedRFPE *			temperedRFPE;
+	StratifiedRFPE *		stratifiedRFPE;
+	MeshPosterior *			meshPosterior;
+	MultiOutcomeRFPE *		multiOutcomeRFPE;
+	uint64_t *			shotWords;
+	ShotRecordFile *		shotRecordFile;
+	struct ConvergenceCurves *	convergenceCurves;
+} AQPEWorkspace;
+
+/**
+ *	@brief	Seed a GSL random number generator from the time of day.
+ *
+ *	@param	gslRNG		: GSL random number generator to seed
+ *	@return	unsigned long	: the random seed
+ */
+unsigned long	initRNG(gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Calculate the number of applications M of the unitary for the next circuit.
+ *
+ *	@param	standardDeviation	: standard deviation of the current prior
+ *	@param	alpha			: AQPE depth / number of samples trade-off parameter
+ *	@return	double			: M = 1 / standardDeviation^{alpha}
+ */
+double	calculateM(double standardDeviation, double alpha);
+
+/**
+ *	@brief	Calculate the phase shift theta of the next circuit.
+ *
+ *	@param	meanValue		: mean value of the current prior
+ *	@param	standardDeviation	: standard deviation of the current prior
+ *	@return	double			: theta = meanValue - standardDeviation
+ */
+double	calculateTheta(double meanValue, double standardDeviation);
+
+/**
+ *	@brief	Draw samples from a Gaussian restricted to (-pi, pi).
+ *
+ *	A sample that misses (-pi, pi) kRestrictedGaussianMaximumAttempts times
+ *	in a row is wrapped into [-pi, pi] instead, so that the time per sample
+ *	is bounded even for a NaN prior.
+ *
+ *	@param	mu		: mean value of the Gaussian
+ *	@param	sigma		: standard deviation of the Gaussian
+ *	@param	samples		: output array of numberOfSamples samples
+ *	@param	numberOfSamples	: number of samples to draw
+ *	@param	gslRNG		: GSL random number generator
+ */
+void	sampleFromRestrictedGaussian(double mu, double sigma, double *  samples, size_t  numberOfSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Draw samples from a Gaussian restricted to (-pi, pi) as offsets from its mean value, which keep their precision when sigma is far below the resolution of mu.
+ *
+ *	@param	mu		: mean value of the Gaussian
+ *	@param	sigma		: standard deviation of the Gaussian
+ *	@param	offsets		: output array of numberOfSamples offsets of the samples from mu
+ *	@param	numberOfSamples	: number of samples to draw
+ *	@param	gslRNG		: GSL random number generator
+ */
+void	sampleOffsetsFromRestrictedGaussian(double mu, double sigma, double *  offsets, size_t  numberOfSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Simulate the AQPE quantum circuit and count the measured outcomes.
+ *
+ *	@param	phi			: eigenphase of the unitary
+ *	@param	M			: number of applications of the unitary
+ *	@param	theta			: phase shift of the circuit
+ *	@param	evidenceSampleCounts	: output counts of outcomes 0 and 1
+ *	@param	numberOfEvidenceSamples	: number of measurements of the circuit
+ *	@param	gslRNG			: GSL random number generator
+ */
+void	runQPECircuit(double phi, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Simulate the AQPE quantum circuit under decoherence and count the measured outcomes.
+ *
+ *	@param	phi			: eigenphase of the unitary
+ *	@param	decoherenceRate		: decay rate of the visibility per application of the unitary
+ *	@param	M			: number of applications of the unitary
+ *	@param	theta			: phase shift of the circuit
+ *	@param	evidenceSampleCounts	: output counts of outcomes 0 and 1
+ *	@param	numberOfEvidenceSamples	: number of measurements of the circuit
+ *	@param	gslRNG			: GSL random number generator
+ */
+void	runNoisyQPECircuit(double phi, double decoherenceRate, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Simulate the shots of the AQPE quantum circuit as packed records and count the measured outcomes.
+ *
+ *	@param	circuit			: circuit, with its probability of outcome 0 and number of shots
+ *	@param	noise			: readout noise of the shots
+ *	@param	evidenceSampleCounts	: output counts of outcomes 0 and 1
+ *	@param	words			: buffer of kShotRecordChunkNumberOfWords words
+ *	@param	recordFile		: file to append the records to, or NULL
+ *	@param	gslRNG			: GSL random number generator, which seeds the shot generator
+ */
+void	runShotRecordQPECircuit(const ShotRecordCircuitHeader *  circuit, const ShotNoise *  noise, uint64_t *  evidenceSampleCounts, uint64_t *  words, ShotRecordFile *  recordFile, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Update the Gaussian prior with the circuit evidence via rejection filtering.
+ *
+ *	@param	priorSamples		: samples drawn from the current prior
+ *	@param	numberOfPriorSamples	: number of prior samples
+ *	@param	evidenceSampleCounts	: counts of outcomes 0 and 1
+ *	@param	numberOfEvidenceSamples	: number of measurements of the circuit
+ *	@param	M			: number of applications of the unitary
+ *	@param	theta			: phase shift of the circuit
+ *	@param	meanValue		: in: prior mean, out: posterior mean
+ *	@param	standardDeviation	: in: prior standard deviation, out: posterior standard deviation
+ *	@param	gslRNG			: GSL random number generator
+ *	@return	size_t			: number of accepted prior samples, 0 if the prior was kept
+ */
+size_t	doRFPE(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Allocate the workspace of one thread for the configured posterior engine.
+ *
+ *	@param	arguments		: command line arguments
+ *	@return	AQPEWorkspace *		: workspace, release with freeAQPEWorkspace()
+ */
+AQPEWorkspace *	allocAQPEWorkspace(const CommandLineArguments *  arguments);
+
+/**
+ *	@brief	Release a workspace.
+ *
+ *	@param	workspace	: workspace to release
+ */
+void	freeAQPEWorkspace(AQPEWorkspace *  workspace);
+
+/**
+ *	@brief	Initialize an AQPE experiment from its initial prior.
+ *
+ *	@param	experiment			: experiment to initialize
+ *	@param	initialMeanValue		: mean value of the initial prior
+ *	@param	initialStandardDeviation	: standard deviation of the initial prior
+ *	@param	experimentNo			: experiment number used in verbose output
+ *	@param	arguments			: command line arguments
+ */
+void	initAQPEExperiment(AQPEExperiment *  experiment, double initialMeanValue, double initialStandardDeviation, size_t experimentNo, const CommandLineArguments *  arguments);
+
+/**
+ *	@brief	Advance an AQPE experiment by up to maximumNumberOfIterations iterations of the posterior engine.
+ *
+ *	@param	experiment			: experiment to advance
+ *	@param	arguments			: command line arguments
+ *	@param	maximumNumberOfIterations	: maximum number of iterations to run in this call
+ *	@param	workspace			: workspace of the calling thread
+ *	@param	gslRNG				: GSL random number generator
+ *	@param	resultStream			: writer of the calling thread to publish each iteration to, or NULL
+ *	@return	bool				: true if the experiment has finished
+ */
+bool	stepAQPEExperiment(AQPEExperiment *  experiment, const CommandLineArguments *  arguments, size_t maximumNumberOfIterations, AQPEWorkspace *  workspace, gsl_rng *  gslRNG, ResultStreamWriter *  resultStream);
+
+/**
+ *	@brief	Check whether an AQPE experiment has converged or run out of iterations.
+ *
+ *	@param	experiment	: experiment to check
+ *	@return	bool		: true if the experiment has finished
+ */
+bool	isAQPEExperimentFinished(const AQPEExperiment *  experiment);
+
+/**
+ *	@brief	Describe why a divergence detector aborted an experiment.
+ *
+ *	@param	abortReason	: reason for the abort
+ *	@return	const char *	: description of the reason
+ */
+const char *	aqpeAbortReasonName(AQPEAbortReason abortReason);
+
+/**
+ *	@brief	Report the results of a finished AQPE experiment in verbose mode.
+ *
+ *	@param	experiment	: finished experiment
+ *	@param	arguments	: command line arguments
+ */
+void	reportAQPEExperiment(const AQPEExperiment *  experiment, const CommandLineArguments *  arguments);
+
+/**
+ *	@brief	Run one AQPE experiment, iterating RFPE until the precision is achieved.
+ *
+ *	@param	initialMeanValue		: mean value of the initial prior
+ *	@param	initialStandardDeviation	: standard deviation of the initial prior
+ *	@param	arguments			: command line arguments
+ *	@param	experimentNo			: experiment number used in verbose output
+ *	@param	gslRNG				: GSL random number generator
+ *	@param	convergenceIterationCount	: output number of iterations to convergence
+ *	@param	estimatedPhi			: output estimate of the eigenphase
+ *	@param	resources			: output quantum resources consumed by the experiment
+ *	@return	bool				: true if the experiment converged
+ */
+bool	runAQPEviaRFPEExperiment(double initialMeanValue, double initialStandardDeviation, CommandLineArguments *  arguments, size_t experimentNo, gsl_rng *  gslRNG, size_t *  convergenceIterationCount, double *  estimatedPhi, QuantumResources *  resources);
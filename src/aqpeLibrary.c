@@ -0,0 +1,209 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "aqpeLibrary.h"
+#include "utilities.h"
+
+struct AQPERun
+{
+	CommandLineArguments	arguments;
+	AQPEWorkspace *		workspace;
+	gsl_rng *		gslRNG;
+	AQPERunResults		results;
+};
+
+struct AQPERun *
+createAQPERun(int argc, char *  argv[])
+{
+	struct AQPERun *	run;
+	AQPERunResults *	results;
+	size_t			numberOfTrajectoryValues;
+
+	run = (struct AQPERun *) calloc(1, sizeof(struct AQPERun));
+
+	/*
+	 *	An optind of 0 makes getopt_long() reinitialize, so that options
+	 *	parse the same in every run of a process.
+	 */
+	optind = 0;
+	initCommandLineArguments(&run->arguments);
+	run->arguments.quiet = true;
+	if (getCommandLineArguments(argc, argv, &run->arguments))
+	{
+		free(run);
+
+		return NULL;
+	}
+
+	if ((run->arguments.numberOfMixturePhases > 0) || run->arguments.estimateDecoherence)
+	{
+		fprintf(stderr, "\nError: Runs estimate a single eigenphase, without --mixture-phases or --estimate-decoherence.\n");
+		free(run);
+
+		return NULL;
+	}
+
+	if (run->arguments.estimateAmplitude || (run->arguments.costTableRefreshPath != NULL) || (run->arguments.costTableQueryPath != NULL))
+	{
+		fprintf(stderr, "\nError: Runs estimate an eigenphase, and do not support --amplitude, --predict-cost or --refresh-cost-table.\n");
+		free(run);
+
+		return NULL;
+	}
+
+	if (run->arguments.benchmarkPipelines || run->arguments.benchmarkKernels || run->arguments.checkSteadyState || run->arguments.benchmarkAmplitude || run->arguments.benchmarkStopping || run->arguments.benchmarkRealTime || run->arguments.benchmarkOverlap || run->arguments.benchmarkBatch || run->arguments.benchmarkShotRecords)
+	{
+		fprintf(stderr, "\nError: Runs do not support the --benchmark-* options or --check-steady-state.\n");
+		free(run);
+
+		return NULL;
+	}
+
+	run->arguments.numberOfThreads = 1;
+	run->arguments.realTime = false;
+	run->arguments.resultLogPath = NULL;
+	run->arguments.resultStreamName = NULL;
+	run->arguments.shotRecordPath = NULL;
+	run->arguments.convergenceCurvesPath = NULL;
+
+	run->workspace = allocAQPEWorkspace(&run->arguments);
+	run->gslRNG = gsl_rng_alloc(gsl_rng_default);
+
+	results = &run->results;
+	results->numberOfExperiments = run->arguments.numberOfRepetitions;
+	results->maximumNumberOfIterations = kMaxNumberOfIterations;
+	numberOfTrajectoryValues = results->numberOfExperiments * results->maximumNumberOfIterations;
+	results->meanValues = (double *) calloc(results->numberOfExperiments, sizeof(double));
+	results->standardDeviations = (double *) calloc(results->numberOfExperiments, sizeof(double));
+	results->numbersOfIterations = (uint64_t *) calloc(results->numberOfExperiments, sizeof(uint64_t));
+	results->converged = (uint8_t *) calloc(results->numberOfExperiments, sizeof(uint8_t));
+	results->abortReasons = (uint8_t *) calloc(results->numberOfExperiments, sizeof(uint8_t));
+	results->totalShots = (uint64_t *) calloc(results->numberOfExperiments, sizeof(uint64_t));
+	results->depthShotProducts = (double *) calloc(results->numberOfExperiments, sizeof(double));
+	results->trajectoryMeanValues = (double *) calloc(numberOfTrajectoryValues, sizeof(double));
+	results->trajectoryStandardDeviations = (double *) calloc(numberOfTrajectoryValues, sizeof(double));
+	results->trajectoryMs = (double *) calloc(numberOfTrajectoryValues, sizeof(double));
+	results->trajectoryThetas = (double *) calloc(numberOfTrajectoryValues, sizeof(double));
+
+	return run;
+}
+
+int
+runAQPE(struct AQPERun *  run, unsigned long randomSeed)
+{
+	const CommandLineArguments *	arguments = &run->arguments;
+	AQPERunResults *		results = &run->results;
+	AQPEExperiment			experiment;
+	size_t				i;
+	size_t				j;
+
+	if (randomSeed == 0)
+	{
+		initRNG(run->gslRNG);
+	}
+	else
+	{
+		gsl_rng_set(run->gslRNG, randomSeed);
+	}
+
+	/*
+	 *	Step each experiment one iteration at a time to record its
+	 *	trajectory. The M and theta of an iteration follow from the posterior
+	 *	before it, as in stepAQPEExperiment().
+	 */
+	for (i = 0; i < results->numberOfExperiments; i++)
+	{
+		size_t	row = i * results->maximumNumberOfIterations;
+
+		initAQPEExperiment(&experiment, kInitialPriorMeanValue, kInitialPriorStandardDeviation, i + 1, arguments);
+		for (j = 0; !isAQPEExperimentFinished(&experiment); j++)
+		{
+			results->trajectoryMs[row + j] = calculateM(experiment.standardDeviation, arguments->alpha);
+			results->trajectoryThetas[row + j] = calculateTheta(experiment.meanValue, experiment.standardDeviation);
+			stepAQPEExperiment(&experiment, arguments, 1, run->workspace, run->gslRNG, NULL);
+			results->trajectoryMeanValues[row + j] = experiment.meanValue;
+			results->trajectoryStandardDeviations[row + j] = experiment.standardDeviation;
+		}
+		for (; j < results->maximumNumberOfIterations; j++)
+		{
+			results->trajectoryMs[row + j] = NAN;
+			results->trajectoryThetas[row + j] = NAN;
+			results->trajectoryMeanValues[row + j] = NAN;
+			results->trajectoryStandardDeviations[row + j] = NAN;
+		}
+		reportAQPEExperiment(&experiment, arguments);
+
+		results->meanValues[i] = experiment.meanValue;
+		results->standardDeviations[i] = experiment.standardDeviation;
+		results->numbersOfIterations[i] = experiment.numberOfIterations;
+		results->converged[i] = experiment.converged;
+		results->abortReasons[i] = (uint8_t) experiment.abortReason;
+		results->totalShots[i] = experiment.resources.totalShots;
+		results->depthShotProducts[i] = experiment.resources.depthShotProduct;
+	}
+
+	return 0;
+}
+
+const AQPERunResults *
+getAQPERunResults(const struct AQPERun *  run)
+{
+	return &run->results;
+}
+
+void
+destroyAQPERun(struct AQPERun *  run)
+{
+	AQPERunResults *	results = &run->results;
+
+	freeAQPEWorkspace(run->workspace);
+	gsl_rng_free(run->gslRNG);
+	free(results->meanValues);
+	free(results->standardDeviations);
+	free(results->numbersOfIterations);
+	free(results->converged);
+	free(results->abortReasons);
+	free(results->totalShots);
+	free(results->depthShotProducts);
+	free(results->trajectoryMeanValues);
+	free(results->trajectoryStandardDeviations);
+	free(results->trajectoryMs);
+	free(results->trajectoryThetas);
+	free(run);
+}
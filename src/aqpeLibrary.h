@@ -0,0 +1,110 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+/*
+ *	Results of the experiments of a run, in buffers owned by the run. Arrays
+ *	have one element per experiment. The trajectories have
+ *	maximumNumberOfIterations elements per experiment, row by row, with the
+ *	M and theta of each circuit and the posterior after its update, and NaN
+ *	after the last iteration of the experiment. The layout is stable, so
+ *	that bindings can alias the buffers without copying them.
+ */
+typedef struct AQPERunResults
+{
+	uint64_t	numberOfExperiments;
+	uint64_t	maximumNumberOfIterations;
+	double *	meanValues;
+	double *	standardDeviations;
+	uint64_t *	numbersOfIterations;
+	uint8_t *	converged;
+	uint8_t *	abortReasons;
+	uint64_t *	totalShots;
+	double *	depthShotProducts;
+	double *	trajectoryMeanValues;
+	double *	trajectoryStandardDeviations;
+	double *	trajectoryMs;
+	double *	trajectoryThetas;
+} AQPERunResults;
+
+struct AQPERun;
+
+/**
+ *	@brief	Create a run of AQPE experiments from command line options, as the application would parse them.
+ *
+ *	The run keeps its workspace, random number generator and result
+ *	buffers, so that repeated calls of runAQPE() do not allocate. The -r
+ *	experiments run one after the other on the calling thread, whatever
+ *	--threads, and the options for output files and streams are ignored.
+ *	Options that select another estimator, a benchmark, the steady state
+ *	check or the cost table are rejected. Options are parsed with
+ *	getopt(), so calls must not overlap.
+ *	Nothing is printed to stdout, and -h is an invalid option, since the
+ *	run must not print into or end the process of its host.
+ *
+ *	@param	argc		: number of options, including a program name in argv[0]
+ *	@param	argv		: options
+ *	@return	struct AQPERun *	: the run, or NULL if the options are invalid
+ */
+struct AQPERun *	createAQPERun(int argc, char *  argv[]);
+
+/**
+ *	@brief	Run all experiments of a run, overwriting its results.
+ *
+ *	Different runs can run concurrently on different threads.
+ *
+ *	@param	run		: run to run
+ *	@param	randomSeed	: seed of the random number generator, or 0 to seed from the time of day
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runAQPE(struct AQPERun *  run, unsigned long randomSeed);
+
+/**
+ *	@brief	Get the result buffers of a run, valid until destroyAQPERun().
+ *
+ *	@param	run			: run
+ *	@return	const AQPERunResults *	: results of the last runAQPE()
+ */
+const AQPERunResults *	getAQPERunResults(const struct AQPERun *  run);
+
+/**
+ *	@brief	Free a run and its result buffers.
+ *
+ *	@param	run	: run to free
+ */
+void	destroyAQPERun(struct AQPERun *  run);
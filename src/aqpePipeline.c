@@ -0,0 +1,49 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "aqpePipeline.h"
+
+/*
+ *	Restricted Gaussian prior samples, per-shot circuit simulation, rejection
+ *	filtering, and the AQPE design. This is the update of doRFPE(), with
+ *	absolute prior samples drawn after the circuit. runAQPEviaRFPEExperiment()
+ *	instead draws offsets from the mean during the circuit, with
+ *	precomputeRFPE() and finishRFPE(), so the two differ in their random
+ *	streams and in their precision below 1e-10.
+ */
+AQPE_DEFINE_PIPELINE(runAQPEPipelineShotByShotRFPE, aqpeSamplerRestrictedGaussian, aqpeBackendShotByShot, aqpeEngineRejectionFilter, aqpeDesignAQPE)
+
+/*
+ *	As above, with the circuit counts drawn from a binomial distribution.
+ */
+AQPE_DEFINE_PIPELINE(runAQPEPipelineBinomialRFPE, aqpeSamplerRestrictedGaussian, aqpeBackendBinomial, aqpeEngineRejectionFilter, aqpeDesignAQPE)
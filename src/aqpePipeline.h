@@ -0,0 +1,213 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include "aqpe.h"
+#include "quantumResources.h"
+#include "utilities.h"
+
+/*
+ *	Compile-time composition of the AQPE estimator. A pipeline is built from
+ *	four policies, each a static inline function with a fixed signature:
+ *
+ *	Sampler	: void (double mu, double sigma, double *  samples, size_t numberOfSamples, gsl_rng *  gslRNG)
+ *	Backend	: void (double phi, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+ *	Engine	: void (const double *  priorSamples, size_t numberOfPriorSamples, const uint64_t *  evidenceSampleCounts, double M, double theta, double *  workspace, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
+ *	Design	: void (double meanValue, double standardDeviation, double alpha, double *  M, double *  theta)
+ *
+ *	AQPE_DEFINE_PIPELINE() expands to one specialized iteration loop in which
+ *	the compiler can inline all four policies. Pipelines are instantiated in
+ *	aqpePipeline.c, so only the common combinations are compiled.
+ */
+
+/*
+ *	The sampler of the C path, which wraps a sample into [-pi, pi] after a
+ *	bounded number of draws outside it.
+ */
+static inline void
+aqpeSamplerRestrictedGaussian(double mu, double sigma, double *  samples, size_t numberOfSamples, gsl_rng *  gslRNG)
+{
+	sampleFromRestrictedGaussian(mu, sigma, samples, numberOfSamples, gslRNG);
+}
+
+/*
+ *	Per-shot simulation of the circuit, as in runQPECircuit().
+ */
+static inline void
+aqpeBackendShotByShot(double phi, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+{
+	double		probabilityEvidence0 = (1 + cos(M * (phi - theta))) / 2;
+	uint64_t	count0 = 0;
+	uint64_t	i;
+
+	for (i = 0; i < numberOfEvidenceSamples; i++)
+	{
+		count0 += (gsl_rng_uniform(gslRNG) < probabilityEvidence0);
+	}
+	evidenceSampleCounts[0] = count0;
+	evidenceSampleCounts[1] = numberOfEvidenceSamples - count0;
+}
+
+/*
+ *	The counts of a circuit are binomially distributed, so they can be drawn
+ *	in one step instead of shot by shot.
+ */
+static inline void
+aqpeBackendBinomial(double phi, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+{
+	double	probabilityEvidence0 = (1 + cos(M * (phi - theta))) / 2;
+
+	evidenceSampleCounts[0] = gsl_ran_binomial(gslRNG, probabilityEvidence0, (unsigned int) numberOfEvidenceSamples);
+	evidenceSampleCounts[1] = numberOfEvidenceSamples - evidenceSampleCounts[0];
+}
+
+/*
+ *	Rejection filtering as in doRFPE(), with the log-likelihood accumulated
+ *	in a single pass over the prior samples.
+ */
+static inline void
+aqpeEngineRejectionFilter(const double *  priorSamples, size_t numberOfPriorSamples, const uint64_t *  evidenceSampleCounts, double M, double theta, double *  workspace, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
+{
+	double	count0 = (double) evidenceSampleCounts[0];
+	double	count1 = (double) evidenceSampleCounts[1];
+	double	maxOfLogEvidenceProbability = -INFINITY;
+	double	currentStandardDeviation = *standardDeviation;
+	double	sum = 0.0;
+	double	sumOfSquares = 0.0;
+	size_t	numberOfAcceptedPriorSamples = 0;
+	size_t	i;
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		double	p0 = (1 + cos(M * (priorSamples[i] - theta))) / 2;
+		double	logEvidenceProbability = ((count0 > 0) ? count0 * log(p0) : 0.0) + ((count1 > 0) ? count1 * log(1 - p0) : 0.0);
+
+		workspace[i] = logEvidenceProbability;
+		maxOfLogEvidenceProbability = fmax(maxOfLogEvidenceProbability, logEvidenceProbability);
+	}
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		if (gsl_rng_uniform(gslRNG) <= exp(workspace[i] - maxOfLogEvidenceProbability))
+		{
+			numberOfAcceptedPriorSamples++;
+			sum += priorSamples[i];
+			sumOfSquares += priorSamples[i] * priorSamples[i];
+		}
+	}
+
+	if (numberOfAcceptedPriorSamples == 0)
+	{
+		return;
+	}
+
+	*meanValue = sum / numberOfAcceptedPriorSamples;
+
+	if (numberOfAcceptedPriorSamples == 1)
+	{
+		*standardDeviation = currentStandardDeviation / 2;
+	}
+	else
+	{
+		*standardDeviation = sqrt(fmax((sumOfSquares / numberOfAcceptedPriorSamples) - (*meanValue * *meanValue), 0.0));
+		*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+	}
+}
+
+static inline void
+aqpeDesignAQPE(double meanValue, double standardDeviation, double alpha, double *  M, double *  theta)
+{
+	*M = (standardDeviation == 0.0) ? 1.0 : 1 / pow(standardDeviation, alpha);
+	*theta = meanValue - standardDeviation;
+}
+
+/*
+ *	Signature of an instantiated pipeline. The workspace holds
+ *	2 * numberOfPriorTestSamplesPerIteration doubles.
+ */
+#define AQPE_PIPELINE_SIGNATURE(name) \
+	bool \
+	name(double initialMeanValue, double initialStandardDeviation, const CommandLineArguments *  arguments, double *  workspace, gsl_rng *  gslRNG, size_t *  convergenceIterationCount, double *  estimatedPhi, QuantumResources *  resources)
+
+#define AQPE_DECLARE_PIPELINE(name) \
+	AQPE_PIPELINE_SIGNATURE(name);
+
+#define AQPE_DEFINE_PIPELINE(name, Sampler, Backend, Engine, Design) \
+	AQPE_PIPELINE_SIGNATURE(name) \
+	{ \
+		const size_t	numberOfPriorSamples = arguments->numberOfPriorTestSamplesPerIteration; \
+		const uint64_t	numberOfEvidenceSamples = arguments->numberOfEvidenceSamplesPerIteration; \
+		double *	priorSamples = workspace; \
+		double *	engineWorkspace = workspace + numberOfPriorSamples; \
+		uint64_t	evidenceSampleCounts[2]; \
+		double		meanValue = initialMeanValue; \
+		double		standardDeviation = initialStandardDeviation; \
+		double		M; \
+		double		theta; \
+		size_t		i; \
+	\
+		*resources = (QuantumResources) {0}; \
+	\
+		for (i = 0; i < kMaxNumberOfIterations; i++) \
+		{ \
+			Design(meanValue, standardDeviation, arguments->alpha, &M, &theta); \
+			Backend(arguments->targetPhi, M, theta, evidenceSampleCounts, numberOfEvidenceSamples, gslRNG); \
+			accountCircuitMapping(resources, M, numberOfEvidenceSamples); \
+			Sampler(meanValue, standardDeviation, priorSamples, numberOfPriorSamples, gslRNG); \
+			Engine(priorSamples, numberOfPriorSamples, evidenceSampleCounts, M, theta, engineWorkspace, &meanValue, &standardDeviation, gslRNG); \
+	\
+			if (standardDeviation < arguments->precision) \
+			{ \
+				*estimatedPhi = meanValue; \
+				*convergenceIterationCount = i + 1; \
+	\
+				return true; \
+			} \
+		} \
+	\
+		return false; \
+	}
+
+/*
+ *	Explicitly instantiated pipelines.
+ */
+AQPE_DECLARE_PIPELINE(runAQPEPipelineShotByShotRFPE)
+AQPE_DECLARE_PIPELINE(runAQPEPipelineBinomialRFPE)
@@ -0,0 +1,930 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <gsl/gsl_rng.h>
+#include "amplitudeEstimation.h"
+#include "aqpe.h"
+#include "aqpePipeline.h"
+#include "benchmarks.h"
+#include "realTime.h"
+#include "rfpeBatch.h"
+#include "rfpeKernels.h"
+#include "rfpeSplit.h"
+#include "shotRecord.h"
+
+typedef enum
+{
+	kShotBenchmarkNumberOfShots = 1 << 30,
+	kShotBenchmarkNumberOfReferenceShots = 1 << 24,
+} ShotBenchmarkConstants;
+
+typedef enum
+{
+	kKernelBenchmarkNumberOfUpdates = 100000,
+} KernelBenchmarkConstants;
+
+typedef enum
+{
+	kBatchBenchmarkNumberOfQubits = 1000,
+	kBatchBenchmarkNumberOfRounds = 20,
+} BatchBenchmarkConstants;
+
+typedef enum
+{
+	kRealTimeBenchmarkNumberOfIterations = 200000,
+	kRealTimeBenchmarkLoadBufferSize = 16 * 1024 * 1024,
+} RealTimeBenchmarkConstants;
+
+typedef enum
+{
+	kStoppingBenchmarkNumberOfConfidences = 3,
+	kStoppingBenchmarkOutlierFactor = 4,
+} StoppingBenchmarkConstants;
+
+typedef struct BackgroundLoad
+{
+	atomic_bool	stop;
+	unsigned char *	buffer;
+} BackgroundLoad;
+
+typedef struct BenchmarkResult
+{
+	double	wallTime;
+	double	averageNumberOfIterations;
+	double	averageDistanceFromTarget;
+	size_t	convergenceCount;
+} BenchmarkResult;
+
+static double
+monotonicTime(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void
+accumulateBenchmarkExperiment(BenchmarkResult *  result, const CommandLineArguments *  arguments, bool converged, size_t convergenceIterationCount, double estimatedPhi)
+{
+	if (converged)
+	{
+		result->averageNumberOfIterations += (double) convergenceIterationCount;
+		result->averageDistanceFromTarget += fabs(arguments->targetPhi - estimatedPhi);
+		result->convergenceCount++;
+	}
+}
+
+static void
+printBenchmarkResult(const char *  name, BenchmarkResult *  result, size_t numberOfExperiments, double referenceWallTime)
+{
+	if (result->convergenceCount > 0)
+	{
+		result->averageNumberOfIterations /= result->convergenceCount;
+		result->averageDistanceFromTarget /= result->convergenceCount;
+	}
+
+	printf("%-28s %14.6le %10.3lf %12zu %12.6lf %14.6le\n",
+		name,
+		result->wallTime / numberOfExperiments,
+		referenceWallTime / result->wallTime,
+		result->convergenceCount,
+		result->averageNumberOfIterations,
+		result->averageDistanceFromTarget);
+}
+
+int
+runPipelineBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	typedef AQPE_PIPELINE_SIGNATURE((*AQPEPipeline));
+
+	const struct
+	{
+		const char *	name;
+		AQPEPipeline	pipeline;
+	}				pipelines[] = {
+						{"pipeline shot-by-shot doRFPE",	runAQPEPipelineShotByShotRFPE},
+						{"pipeline binomial doRFPE",	runAQPEPipelineBinomialRFPE},
+					};
+	CommandLineArguments		benchmarkArguments = *arguments;
+	BenchmarkResult			reference = {0};
+	unsigned long			randomSeed = gsl_rng_get(gslRNG) + 1;
+	double *			workspace;
+	size_t				convergenceIterationCount = 0;
+	double				estimatedPhi = 0.0;
+	QuantumResources		resources;
+	double				startTime;
+	size_t				p;
+	size_t				i;
+
+	benchmarkArguments.verbose = false;
+	workspace = (double *) malloc(2 * arguments->numberOfPriorTestSamplesPerIteration * sizeof(double));
+
+	/*
+	 *	The pipelines implement the update of doRFPE(), while the C path
+	 *	uses the split update of precomputeRFPE() and finishRFPE(). The
+	 *	speedup therefore compares two implementations of rejection
+	 *	filtering, and not only the composition of the same one. The C path
+	 *	runs the RFPE engine with one ancilla whatever --engine and
+	 *	--ancillas, so that both sides filter the same two-outcome evidence.
+	 */
+	benchmarkArguments.posteriorEngine = kPosteriorEngineRFPE;
+	benchmarkArguments.numberOfAncillas = 1;
+	printf("\nBenchmark of %zu AQPE experiments per estimator path:\n", arguments->numberOfRepetitions);
+	printf("%-28s %14s %10s %12s %12s %14s\n", "", "s/experiment", "speedup", "converged", "iterations", "error");
+
+	/*
+	 *	Every path starts from the same seed.
+	 */
+	gsl_rng_set(gslRNG, randomSeed);
+	startTime = monotonicTime();
+	for (i = 0; i < arguments->numberOfRepetitions; i++)
+	{
+		bool	converged = runAQPEviaRFPEExperiment(kInitialPriorMeanValue, kInitialPriorStandardDeviation, &benchmarkArguments, i + 1, gslRNG, &convergenceIterationCount, &estimatedPhi, &resources);
+
+		accumulateBenchmarkExperiment(&reference, arguments, converged, convergenceIterationCount, estimatedPhi);
+	}
+	reference.wallTime = monotonicTime() - startTime;
+	printBenchmarkResult("C path (split RFPE)", &reference, arguments->numberOfRepetitions, reference.wallTime);
+
+	for (p = 0; p < sizeof(pipelines) / sizeof(pipelines[0]); p++)
+	{
+		BenchmarkResult	result = {0};
+
+		gsl_rng_set(gslRNG, randomSeed);
+		startTime = monotonicTime();
+		for (i = 0; i < arguments->numberOfRepetitions; i++)
+		{
+			bool	converged = pipelines[p].pipeline(kInitialPriorMeanValue, kInitialPriorStandardDeviation, &benchmarkArguments, workspace, gslRNG, &convergenceIterationCount, &estimatedPhi, &resources);
+
+			accumulateBenchmarkExperiment(&result, arguments, converged, convergenceIterationCount, estimatedPhi);
+		}
+		result.wallTime = monotonicTime() - startTime;
+		printBenchmarkResult(pipelines[p].name, &result, arguments->numberOfRepetitions, reference.wallTime);
+	}
+
+	free(workspace);
+
+	return 0;
+}
+
+/*
+ *	Lag-1 autocorrelation of the outcomes of independent shots with
+ *	probability of outcome 1 probabilityOfOne under Markov readout flips,
+ *	from the means of the +1/-1 spins of the shots and of the flips.
+ */
+static double
+expectedShotCorrelation(double probabilityOfOne, const ShotNoise *  noise)
+{
+	double	shotSpin = 1 - 2 * probabilityOfOne;
+	double	flipSpin = 1 - 2 * noise->flipProbability;
+	double	flipSpinProduct = noise->correlation * 4 * noise->flipProbability * (1 - noise->flipProbability) + flipSpin * flipSpin;
+	double	outcomeSpin = shotSpin * flipSpin;
+
+	if (outcomeSpin * outcomeSpin >= 1.0)
+	{
+		return 0.0;
+	}
+
+	return (shotSpin * shotSpin * flipSpinProduct - outcomeSpin * outcomeSpin) / (1 - outcomeSpin * outcomeSpin);
+}
+
+int
+runShotRecordBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const struct
+	{
+		const char *	name;
+		double		probabilityOfOne;
+		ShotNoise	noise;
+	}			cases[] = {
+					{"independent, p = 0.5",		0.5,	{0.0,	0.0}},
+					{"independent, p = 0.3",		0.3,	{0.0,	0.0}},
+					{"independent, p = 1e-6",		1e-6,	{0.0,	0.0}},
+					{"independent flips 0.05, p = 0.3",	0.3,	{0.05,	0.0}},
+					{"Markov flips 0.05/0.9, p = 0",	0.0,	{0.05,	0.9}},
+					{"Markov flips 0.05/0.9, p = 0.3",	0.3,	{0.05,	0.9}},
+				};
+	ShotRecordGenerator	generator;
+	uint64_t *		words;
+	uint64_t		evidenceSampleCounts[2];
+	double			referenceRate;
+	double			startTime;
+	size_t			c;
+
+	words = (uint64_t *) malloc(kShotRecordChunkNumberOfWords * sizeof(uint64_t));
+	seedShotRNG(&generator.rng, gsl_rng_get(gslRNG));
+
+	/*
+	 *	The per-shot loop of runQPECircuit() draws one GSL uniform per shot.
+	 */
+	startTime = monotonicTime();
+	runQPECircuit(0.0, 1.0, acos(0.4), evidenceSampleCounts, kShotBenchmarkNumberOfReferenceShots, gslRNG);
+	referenceRate = kShotBenchmarkNumberOfReferenceShots / (monotonicTime() - startTime);
+
+	printf("\nBenchmark of the shot record generator with %d shots per case:\n", kShotBenchmarkNumberOfShots);
+	printf("%-34s %12s %10s %12s %12s %12s %12s\n", "", "shots/s", "speedup", "P(1)", "expected", "lag-1 corr", "expected");
+	printf("%-34s %12.4le %10.3lf %12.6lf %12.6lf %12s %12s\n", "per-shot GSL uniforms, p = 0.3", referenceRate, 1.0, (double) evidenceSampleCounts[1] / kShotBenchmarkNumberOfReferenceShots, 0.3, "", "");
+
+	for (c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		const uint64_t	chunkShots = (uint64_t) kShotRecordChunkNumberOfWords * kShotRecordShotsPerWord;
+		double		expectedProbabilityOfOne = cases[c].probabilityOfOne * (1 - cases[c].noise.flipProbability) + (1 - cases[c].probabilityOfOne) * cases[c].noise.flipProbability;
+		double		probabilityOfOne;
+		double		elapsedTime;
+		uint64_t	numberOfOnes = 0;
+		uint64_t	numberOfOnePairs = 0;
+		uint64_t	shots;
+
+		initShotRecordGenerator(&generator, cases[c].probabilityOfOne, &cases[c].noise);
+
+		startTime = monotonicTime();
+		for (shots = 0; shots < kShotBenchmarkNumberOfShots; shots += chunkShots)
+		{
+			generateShotRecord(&generator, words, chunkShots);
+			numberOfOnes += countShotRecordOnes(words, chunkShots);
+			numberOfOnePairs += countShotRecordOnePairs(words, chunkShots);
+		}
+		elapsedTime = monotonicTime() - startTime;
+
+		/*
+		 *	Pairs that straddle two chunks are not counted, which is a
+		 *	relative bias of one pair in chunkShots.
+		 */
+		probabilityOfOne = (double) numberOfOnes / kShotBenchmarkNumberOfShots;
+
+		printf("%-34s %12.4le %10.3lf %12.6lf %12.6lf %12.6lf %12.6lf\n",
+			cases[c].name,
+			kShotBenchmarkNumberOfShots / elapsedTime,
+			kShotBenchmarkNumberOfShots / elapsedTime / referenceRate,
+			probabilityOfOne,
+			expectedProbabilityOfOne,
+			(probabilityOfOne > 0.0) ? ((double) numberOfOnePairs / kShotBenchmarkNumberOfShots - probabilityOfOne * probabilityOfOne) / (probabilityOfOne * (1 - probabilityOfOne)) : 0.0,
+			expectedShotCorrelation(cases[c].probabilityOfOne, &cases[c].noise));
+	}
+
+	free(words);
+
+	return 0;
+}
+
+/*
+ *	Time numberOfUpdates updates of the same prior and evidence with a
+ *	kernel, recording the number of accepted samples of every update.
+ */
+static double
+timeRFPEKernel(RFPEKernel kernel, double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double priorMeanValue, double priorStandardDeviation, size_t *  numbersOfAcceptedSamples, unsigned long randomSeed, gsl_rng *  gslRNG)
+{
+	double	startTime;
+	size_t	i;
+
+	gsl_rng_set(gslRNG, randomSeed);
+	startTime = monotonicTime();
+	for (i = 0; i < kKernelBenchmarkNumberOfUpdates; i++)
+	{
+		double	meanValue = priorMeanValue;
+		double	standardDeviation = priorStandardDeviation;
+
+		numbersOfAcceptedSamples[i] = kernel(priorSamples, numberOfPriorSamples, evidenceSampleCounts, numberOfEvidenceSamples, M, theta, &meanValue, &standardDeviation, gslRNG);
+	}
+
+	return (monotonicTime() - startTime) / kKernelBenchmarkNumberOfUpdates;
+}
+
+int
+runRFPEKernelBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const size_t	numbersOfPriorSamples[] = {64, 128, 256};
+	const double	priorMeanValue = arguments->targetPhi;
+	const double	priorStandardDeviation = 1e-2;
+	const double	M = calculateM(priorStandardDeviation, arguments->alpha);
+	const double	theta = calculateTheta(priorMeanValue, priorStandardDeviation);
+	unsigned long	randomSeed = gsl_rng_get(gslRNG) + 1;
+	uint64_t	evidenceSampleCounts[2];
+	size_t *	genericAcceptedSamples;
+	size_t *	fixedAcceptedSamples;
+	size_t		n;
+	size_t		i;
+
+	genericAcceptedSamples = (size_t *) malloc(kKernelBenchmarkNumberOfUpdates * sizeof(size_t));
+	fixedAcceptedSamples = (size_t *) malloc(kKernelBenchmarkNumberOfUpdates * sizeof(size_t));
+	runQPECircuit(arguments->targetPhi, M, theta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+
+	printf("\nBenchmark of %d RFPE updates per kernel with M = %lf and counts (%" PRIu64 ", %" PRIu64 "):\n", kKernelBenchmarkNumberOfUpdates, M, evidenceSampleCounts[0], evidenceSampleCounts[1]);
+	printf("%-8s %16s %16s %10s %18s\n", "m", "doRFPE ns/update", "fixed ns/update", "speedup", "same accepted");
+
+	for (n = 0; n < sizeof(numbersOfPriorSamples) / sizeof(numbersOfPriorSamples[0]); n++)
+	{
+		size_t		numberOfPriorSamples = numbersOfPriorSamples[n];
+		double		priorSamples[numberOfPriorSamples];
+		double		genericTime;
+		double		fixedTime;
+		size_t		numberOfAgreements = 0;
+
+		sampleFromRestrictedGaussian(priorMeanValue, priorStandardDeviation, priorSamples, numberOfPriorSamples, gslRNG);
+
+		/*
+		 *	Both kernels draw the same uniforms, so they should accept the
+		 *	same samples up to rounding of the likelihoods.
+		 */
+		genericTime = timeRFPEKernel(doRFPE, priorSamples, numberOfPriorSamples, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, M, theta, priorMeanValue, priorStandardDeviation, genericAcceptedSamples, randomSeed, gslRNG);
+		fixedTime = timeRFPEKernel(selectRFPEKernel(numberOfPriorSamples), priorSamples, numberOfPriorSamples, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, M, theta, priorMeanValue, priorStandardDeviation, fixedAcceptedSamples, randomSeed, gslRNG);
+
+		for (i = 0; i < kKernelBenchmarkNumberOfUpdates; i++)
+		{
+			numberOfAgreements += (genericAcceptedSamples[i] == fixedAcceptedSamples[i]);
+		}
+
+		printf("%-8zu %16.1lf %16.1lf %10.3lf %17.3lf%%\n", numberOfPriorSamples, genericTime * 1e9, fixedTime * 1e9, genericTime / fixedTime, 100.0 * numberOfAgreements / kKernelBenchmarkNumberOfUpdates);
+	}
+
+	free(genericAcceptedSamples);
+	free(fixedAcceptedSamples);
+
+	return 0;
+}
+
+int
+runRFPEOverlapBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const size_t	numbersOfPriorSamples[] = {64, 128, 256};
+	const double	priorMeanValue = arguments->targetPhi;
+	const double	priorStandardDeviation = 1e-2;
+	const double	M = calculateM(priorStandardDeviation, arguments->alpha);
+	const double	theta = calculateTheta(priorMeanValue, priorStandardDeviation);
+	uint64_t	evidenceSampleCounts[2];
+	size_t		n;
+	size_t		i;
+
+	runQPECircuit(arguments->targetPhi, M, theta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+
+	printf("\nBenchmark of %d RFPE updates with M = %lf and counts (%" PRIu64 ", %" PRIu64 "), in ns/update:\n", kKernelBenchmarkNumberOfUpdates, M, evidenceSampleCounts[0], evidenceSampleCounts[1]);
+	printf("%-8s %14s %14s %14s %10s %16s %16s\n", "m", "whole update", "precompute", "finish", "speedup", "accepted whole", "accepted split");
+
+	for (n = 0; n < sizeof(numbersOfPriorSamples) / sizeof(numbersOfPriorSamples[0]); n++)
+	{
+		size_t			numberOfPriorSamples = numbersOfPriorSamples[n];
+		RFPEKernel		kernel = selectRFPEKernel(numberOfPriorSamples);
+		RFPEPrecomputation *	precomputation = allocRFPEPrecomputation(numberOfPriorSamples);
+		double			priorSamples[numberOfPriorSamples];
+		double			wholeTime = 0.0;
+		double			precomputeTime = 0.0;
+		double			finishTime = 0.0;
+		double			startTime;
+		size_t			wholeAcceptedSamples = 0;
+		size_t			splitAcceptedSamples = 0;
+
+		/*
+		 *	The whole update is what remains on the critical path when the
+		 *	prior is only sampled once the counts are known; the split update
+		 *	leaves only finishRFPE() on it.
+		 */
+		startTime = monotonicTime();
+		for (i = 0; i < kKernelBenchmarkNumberOfUpdates; i++)
+		{
+			double	meanValue = priorMeanValue;
+			double	standardDeviation = priorStandardDeviation;
+
+			sampleFromRestrictedGaussian(priorMeanValue, priorStandardDeviation, priorSamples, numberOfPriorSamples, gslRNG);
+			wholeAcceptedSamples += kernel(priorSamples, numberOfPriorSamples, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, M, theta, &meanValue, &standardDeviation, gslRNG);
+		}
+		wholeTime = monotonicTime() - startTime;
+
+		for (i = 0; i < kKernelBenchmarkNumberOfUpdates; i++)
+		{
+			double	meanValue;
+			double	standardDeviation;
+
+			startTime = monotonicTime();
+			precomputeRFPE(precomputation, priorMeanValue, priorStandardDeviation, M, theta, gslRNG);
+			precomputeTime += monotonicTime() - startTime;
+
+			startTime = monotonicTime();
+			splitAcceptedSamples += finishRFPE(precomputation, evidenceSampleCounts, &meanValue, &standardDeviation);
+			finishTime += monotonicTime() - startTime;
+		}
+
+		printf("%-8zu %14.1lf %14.1lf %14.1lf %10.3lf %16.2lf %16.2lf\n",
+			numberOfPriorSamples,
+			1e9 * wholeTime / kKernelBenchmarkNumberOfUpdates,
+			1e9 * precomputeTime / kKernelBenchmarkNumberOfUpdates,
+			1e9 * finishTime / kKernelBenchmarkNumberOfUpdates,
+			wholeTime / finishTime,
+			(double) wholeAcceptedSamples / kKernelBenchmarkNumberOfUpdates,
+			(double) splitAcceptedSamples / kKernelBenchmarkNumberOfUpdates);
+
+		freeRFPEPrecomputation(precomputation);
+	}
+
+	return 0;
+}
+
+int
+runRFPEBatchBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const size_t		numberOfQubits = kBatchBenchmarkNumberOfQubits;
+	const size_t		numberOfPriorSamples = arguments->numberOfPriorTestSamplesPerIteration;
+	RFPEKernel		kernel = selectRFPEKernel(numberOfPriorSamples);
+	RFPEBatch *		batch;
+	gsl_rng *		sequentialRNG;
+	double *		targetPhis;
+	double *		meanValues;
+	double *		standardDeviations;
+	double *		sequentialMeanValues;
+	double *		sequentialStandardDeviations;
+	double *		Ms;
+	double *		thetas;
+	uint64_t *		evidenceSampleCounts;
+	uint64_t *		shotWords;
+	double *		priorSamples;
+	double			sequentialTime = 0.0;
+	double			batchTime = 0.0;
+	size_t			numberOfConvergedQubits = 0;
+	size_t			round;
+	size_t			i;
+
+	targetPhis = (double *) malloc(numberOfQubits * sizeof(double));
+	meanValues = (double *) malloc(numberOfQubits * sizeof(double));
+	standardDeviations = (double *) malloc(numberOfQubits * sizeof(double));
+	sequentialMeanValues = (double *) malloc(numberOfQubits * sizeof(double));
+	sequentialStandardDeviations = (double *) malloc(numberOfQubits * sizeof(double));
+	Ms = (double *) malloc(numberOfQubits * sizeof(double));
+	thetas = (double *) malloc(numberOfQubits * sizeof(double));
+	evidenceSampleCounts = (uint64_t *) malloc(2 * numberOfQubits * sizeof(uint64_t));
+	shotWords = (uint64_t *) malloc(kShotRecordChunkNumberOfWords * sizeof(uint64_t));
+	priorSamples = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	sequentialRNG = gsl_rng_alloc(gsl_rng_default);
+	gsl_rng_set(sequentialRNG, gsl_rng_get(gslRNG) + 1);
+	batch = allocRFPEBatch(arguments->numberOfThreads, numberOfPriorSamples, gslRNG);
+
+	for (i = 0; i < numberOfQubits; i++)
+	{
+		targetPhis[i] = gsl_ran_flat(gslRNG, -M_PI / 2, M_PI / 2);
+		meanValues[i] = kInitialPriorMeanValue;
+		standardDeviations[i] = kInitialPriorStandardDeviation;
+	}
+
+	/*
+	 *	Each round designs and simulates one circuit per qubit, and then
+	 *	updates all posteriors, once qubit by qubit on the calling thread and
+	 *	once with the batch updater. Only the updates are timed, and the
+	 *	posteriors of the batch updater carry over to the next round.
+	 */
+	for (round = 0; round < kBatchBenchmarkNumberOfRounds; round++)
+	{
+		RFPEBatchUpdate	update = {
+			.numberOfQubits			= numberOfQubits,
+			.meanValues			= meanValues,
+			.standardDeviations		= standardDeviations,
+			.Ms				= Ms,
+			.thetas				= thetas,
+			.evidenceSampleCounts		= evidenceSampleCounts,
+			.numbersOfAcceptedPriorSamples	= NULL,
+		};
+		double		startTime;
+
+		for (i = 0; i < numberOfQubits; i++)
+		{
+			ShotRecordCircuitHeader	circuit;
+
+			Ms[i] = calculateM(standardDeviations[i], arguments->alpha);
+			thetas[i] = calculateTheta(meanValues[i], standardDeviations[i]);
+			circuit = (ShotRecordCircuitHeader) {
+				.M			= Ms[i],
+				.theta			= thetas[i],
+				.probabilityOfZero	= (1 + cos(Ms[i] * (targetPhis[i] - thetas[i]))) / 2,
+				.numberOfShots		= arguments->numberOfEvidenceSamplesPerIteration,
+			};
+			runShotRecordQPECircuit(&circuit, NULL, &evidenceSampleCounts[2 * i], shotWords, NULL, gslRNG);
+			sequentialMeanValues[i] = meanValues[i];
+			sequentialStandardDeviations[i] = standardDeviations[i];
+		}
+
+		startTime = monotonicTime();
+		for (i = 0; i < numberOfQubits; i++)
+		{
+			sampleFromRestrictedGaussian(sequentialMeanValues[i], sequentialStandardDeviations[i], priorSamples, numberOfPriorSamples, sequentialRNG);
+			kernel(priorSamples, numberOfPriorSamples, &evidenceSampleCounts[2 * i], arguments->numberOfEvidenceSamplesPerIteration, Ms[i], thetas[i], &sequentialMeanValues[i], &sequentialStandardDeviations[i], sequentialRNG);
+		}
+		sequentialTime += monotonicTime() - startTime;
+
+		startTime = monotonicTime();
+		updateRFPEBatch(batch, &update);
+		batchTime += monotonicTime() - startTime;
+	}
+
+	for (i = 0; i < numberOfQubits; i++)
+	{
+		numberOfConvergedQubits += (standardDeviations[i] < arguments->precision);
+	}
+
+	printf("\nBenchmark of %d rounds of RFPE updates of %d qubits with -m %zu on %zu threads:\n", kBatchBenchmarkNumberOfRounds, kBatchBenchmarkNumberOfQubits, numberOfPriorSamples, batch->numberOfThreads);
+	printf("%-24s %14s %14s %10s\n", "", "us/round", "ns/qubit", "speedup");
+	printf("%-24s %14.1lf %14.1lf %10.3lf\n", "qubit by qubit", 1e6 * sequentialTime / kBatchBenchmarkNumberOfRounds, 1e9 * sequentialTime / (kBatchBenchmarkNumberOfRounds * numberOfQubits), 1.0);
+	printf("%-24s %14.1lf %14.1lf %10.3lf\n", "batch", 1e6 * batchTime / kBatchBenchmarkNumberOfRounds, 1e9 * batchTime / (kBatchBenchmarkNumberOfRounds * numberOfQubits), sequentialTime / batchTime);
+	printf("\nAfter %d rounds, %zu of %zu qubits reached the precision %le.\n", kBatchBenchmarkNumberOfRounds, numberOfConvergedQubits, numberOfQubits, arguments->precision);
+
+	freeRFPEBatch(batch);
+	gsl_rng_free(sequentialRNG);
+	free(targetPhis);
+	free(meanValues);
+	free(standardDeviations);
+	free(sequentialMeanValues);
+	free(sequentialStandardDeviations);
+	free(Ms);
+	free(thetas);
+	free(evidenceSampleCounts);
+	free(shotWords);
+	free(priorSamples);
+
+	return 0;
+}
+
+/*
+ *	Background load: sweeps over a buffer larger than the caches, so that it
+ *	competes for the CPU, the caches and the memory bandwidth.
+ */
+static void *
+backgroundLoadThread(void *  argument)
+{
+	BackgroundLoad *	load = (BackgroundLoad *) argument;
+	unsigned char		value = 0;
+
+	while (!atomic_load_explicit(&load->stop, memory_order_relaxed))
+	{
+		memset(load->buffer, value++, kRealTimeBenchmarkLoadBufferSize);
+	}
+
+	return NULL;
+}
+
+static int
+compareDoubles(const void *  a, const void *  b)
+{
+	double	x = *(const double *) a;
+	double	y = *(const double *) b;
+
+	return (x > y) - (x < y);
+}
+
+static void
+printLatencyQuantiles(const char *  name, double *  latencies, size_t numberOfLatencies)
+{
+	qsort(latencies, numberOfLatencies, sizeof(double), compareDoubles);
+	printf("%-28s %12.3lf %12.3lf %12.3lf %12.3lf\n",
+		name,
+		1e6 * latencies[numberOfLatencies / 2],
+		1e6 * latencies[(size_t) (0.99 * (numberOfLatencies - 1))],
+		1e6 * latencies[(size_t) (0.999 * (numberOfLatencies - 1))],
+		1e6 * latencies[numberOfLatencies - 1]);
+}
+
+int
+runRealTimeBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const size_t		numberOfLoadThreads = arguments->numberOfBackgroundLoadThreads;
+	RFPEPrecomputation *	precomputation = allocRFPEPrecomputation(arguments->numberOfPriorTestSamplesPerIteration);
+	BackgroundLoad *	loads = (BackgroundLoad *) calloc((numberOfLoadThreads > 0) ? numberOfLoadThreads : 1, sizeof(BackgroundLoad));
+	pthread_t *		loadThreads = (pthread_t *) calloc((numberOfLoadThreads > 0) ? numberOfLoadThreads : 1, sizeof(pthread_t));
+	double *		criticalPathLatencies = (double *) malloc(kRealTimeBenchmarkNumberOfIterations * sizeof(double));
+	double *		precomputeLatencies = (double *) malloc(kRealTimeBenchmarkNumberOfIterations * sizeof(double));
+	double *		updateLatencies = (double *) malloc(kRealTimeBenchmarkNumberOfIterations * sizeof(double));
+	pthread_attr_t		loadAttributes;
+	struct sched_param	loadParameters = {.sched_priority = 0};
+	uint64_t		evidenceSampleCounts[2];
+	double			meanValue = kInitialPriorMeanValue;
+	double			standardDeviation = kInitialPriorStandardDeviation;
+	double			M;
+	double			theta;
+	size_t			numberOfIterationsOfExperiment = 0;
+	size_t			numberOfExperiments = 1;
+	size_t			i;
+	int			status = 0;
+
+	/*
+	 *	The load threads run under SCHED_OTHER, whatever the policy of the
+	 *	benchmark thread, and on the same CPUs.
+	 */
+	pthread_attr_init(&loadAttributes);
+	pthread_attr_setinheritsched(&loadAttributes, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&loadAttributes, SCHED_OTHER);
+	pthread_attr_setschedparam(&loadAttributes, &loadParameters);
+	for (i = 0; i < numberOfLoadThreads; i++)
+	{
+		atomic_init(&loads[i].stop, false);
+		loads[i].buffer = (unsigned char *) malloc(kRealTimeBenchmarkLoadBufferSize);
+		pthread_create(&loadThreads[i], &loadAttributes, backgroundLoadThread, &loads[i]);
+	}
+	pthread_attr_destroy(&loadAttributes);
+
+	if (arguments->realTime && enterRealTimeMode(arguments))
+	{
+		status = 1;
+		numberOfExperiments = 0;
+	}
+
+	/*
+	 *	Back-to-back AQPE experiments. The latency that a feedback loop sees
+	 *	runs from the arrival of the counts to the design of the next circuit:
+	 *	finishRFPE() and the next M and theta. The precomputation overlaps
+	 *	with the circuit on hardware, and is timed separately. Nothing on this
+	 *	path allocates, prints, or makes a system call.
+	 */
+	M = calculateM(standardDeviation, arguments->alpha);
+	theta = calculateTheta(meanValue, standardDeviation);
+	for (i = 0; (i < kRealTimeBenchmarkNumberOfIterations) && (status == 0); i++)
+	{
+		double	precomputeStartTime = monotonicTime();
+		double	countsTime;
+		double	designTime;
+
+		precomputeRFPE(precomputation, meanValue, standardDeviation, M, theta, gslRNG);
+		precomputeLatencies[i] = monotonicTime() - precomputeStartTime;
+		runQPECircuit(arguments->targetPhi, M, theta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+
+		countsTime = monotonicTime();
+		finishRFPE(precomputation, evidenceSampleCounts, &meanValue, &standardDeviation);
+		numberOfIterationsOfExperiment++;
+		if ((standardDeviation < arguments->precision) || (numberOfIterationsOfExperiment >= kMaxNumberOfIterations) || isnan(standardDeviation))
+		{
+			meanValue = kInitialPriorMeanValue;
+			standardDeviation = kInitialPriorStandardDeviation;
+			numberOfIterationsOfExperiment = 0;
+			numberOfExperiments++;
+		}
+		M = calculateM(standardDeviation, arguments->alpha);
+		theta = calculateTheta(meanValue, standardDeviation);
+		designTime = monotonicTime();
+
+		criticalPathLatencies[i] = designTime - countsTime;
+		updateLatencies[i] = criticalPathLatencies[i] + precomputeLatencies[i];
+	}
+
+	for (i = 0; i < numberOfLoadThreads; i++)
+	{
+		atomic_store(&loads[i].stop, true);
+		pthread_join(loadThreads[i], NULL);
+		free(loads[i].buffer);
+	}
+
+	if (status == 0)
+	{
+		printf("\nBenchmark of %d AQPE iterations in %zu experiments with -m %zu, %s, under %zu background load threads, in us:\n",
+			kRealTimeBenchmarkNumberOfIterations,
+			numberOfExperiments,
+			arguments->numberOfPriorTestSamplesPerIteration,
+			arguments->realTime ? "in real-time mode" : "without real-time mode",
+			numberOfLoadThreads);
+		printf("%-28s %12s %12s %12s %12s\n", "", "p50", "p99", "p99.9", "max");
+		printLatencyQuantiles("counts to next circuit", criticalPathLatencies, kRealTimeBenchmarkNumberOfIterations);
+		printLatencyQuantiles("precomputation", precomputeLatencies, kRealTimeBenchmarkNumberOfIterations);
+		printLatencyQuantiles("whole update", updateLatencies, kRealTimeBenchmarkNumberOfIterations);
+	}
+
+	freeRFPEPrecomputation(precomputation);
+	free(loads);
+	free(loadThreads);
+	free(criticalPathLatencies);
+	free(precomputeLatencies);
+	free(updateLatencies);
+
+	return status;
+}
+
+int
+runStoppingRuleBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const double		confidences[kStoppingBenchmarkNumberOfConfidences] = {0.68, 0.95, 0.99};
+	CommandLineArguments	benchmarkArguments = *arguments;
+	AQPEWorkspace *		workspace;
+	AQPEExperiment		experiment;
+	unsigned long		randomSeed = gsl_rng_get(gslRNG) + 1;
+	size_t			r;
+	size_t			i;
+
+	benchmarkArguments.verbose = false;
+	benchmarkArguments.convergenceCurvesPath = NULL;
+	workspace = allocAQPEWorkspace(&benchmarkArguments);
+
+	printf("\nBenchmark of %zu AQPE experiments per stopping rule with -p %le:\n", arguments->numberOfRepetitions, arguments->precision);
+	printf("%-28s %10s %12s %16s %14s %10s %10s\n", "", "converged", "iterations", "depth x shots", "error", "within p", "beyond 4p");
+
+	/*
+	 *	Rule 0 is the standard deviation, the others are the confidences.
+	 *	Every rule starts from the same seed, so the experiments see the same
+	 *	random numbers until their stopping decisions differ.
+	 */
+	for (r = 0; r <= kStoppingBenchmarkNumberOfConfidences; r++)
+	{
+		char	name[32];
+		size_t	numberOfConverged = 0;
+		size_t	numberWithinPrecision = 0;
+		size_t	numberOfOutliers = 0;
+		double	sumOfIterations = 0.0;
+		double	sumOfDepthShotProducts = 0.0;
+		double	sumOfErrors = 0.0;
+
+		benchmarkArguments.stoppingConfidence = (r == 0) ? 0.0 : confidences[r - 1];
+		if (r == 0)
+		{
+			snprintf(name, sizeof(name), "std < p");
+		}
+		else
+		{
+			snprintf(name, sizeof(name), "mass within p >= %.2lf", confidences[r - 1]);
+		}
+
+		gsl_rng_set(gslRNG, randomSeed);
+		for (i = 0; i < arguments->numberOfRepetitions; i++)
+		{
+			double	error;
+
+			initAQPEExperiment(&experiment, kInitialPriorMeanValue, kInitialPriorStandardDeviation, i + 1, &benchmarkArguments);
+			stepAQPEExperiment(&experiment, &benchmarkArguments, kMaxNumberOfIterations, workspace, gslRNG, NULL);
+			if (!experiment.converged)
+			{
+				continue;
+			}
+
+			error = fabs(arguments->targetPhi - experiment.meanValue);
+			numberOfConverged++;
+			numberWithinPrecision += (error <= arguments->precision);
+			numberOfOutliers += (error > kStoppingBenchmarkOutlierFactor * arguments->precision);
+			sumOfIterations += (double) experiment.numberOfIterations;
+			sumOfDepthShotProducts += experiment.resources.depthShotProduct;
+			sumOfErrors += error;
+		}
+
+		printf("%-28s %10zu %12.3lf %16.6le %14.6le %10.3lf %10zu\n",
+			name,
+			numberOfConverged,
+			(numberOfConverged > 0) ? sumOfIterations / numberOfConverged : 0.0,
+			(numberOfConverged > 0) ? sumOfDepthShotProducts / numberOfConverged : 0.0,
+			(numberOfConverged > 0) ? sumOfErrors / numberOfConverged : 0.0,
+			(numberOfConverged > 0) ? (double) numberWithinPrecision / numberOfConverged : 0.0,
+			numberOfOutliers);
+	}
+
+	freeAQPEWorkspace(workspace);
+
+	return 0;
+}
+
+static double
+calculateMedianAbsoluteError(double *  absoluteErrors, size_t numberOfErrors)
+{
+	qsort(absoluteErrors, numberOfErrors, sizeof(double), compareDoubles);
+
+	return absoluteErrors[numberOfErrors / 2];
+}
+
+int
+runAmplitudeEstimationBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	CommandLineArguments	benchmarkArguments = *arguments;
+	RFPEPrecomputation *	precomputation = allocRFPEPrecomputation(arguments->numberOfPriorTestSamplesPerIteration);
+	double *		absoluteErrors = (double *) malloc(arguments->numberOfRepetitions * sizeof(double));
+	AmplitudeExperiment	experiment;
+	uint64_t		groverPowers[kMaximumLikelihoodMaximumNumberOfStages];
+	uint64_t		countsOfOne[kMaximumLikelihoodMaximumNumberOfStages];
+	const double		targetAngle = asin(sqrt(arguments->targetAmplitude));
+	const uint64_t		numberOfShots = arguments->numberOfEvidenceSamplesPerIteration;
+	double			bayesianSumOfSquaredErrors = 0.0;
+	double			bayesianNumberOfOracleCalls = 0.0;
+	double			bayesianNumberOfCircuits = 0.0;
+	double			bayesianRootMeanSquareError;
+	double			bayesianMedianAbsoluteError;
+	bool			isMedianMatched = false;
+	bool			isRootMeanSquareMatched = false;
+	size_t			numberOfStages;
+	size_t			i;
+
+	benchmarkArguments.verbose = false;
+
+	/*
+	 *	Bayesian amplitude estimation until the standard deviation of
+	 *	theta_a is below the precision. Errors of experiments that did not
+	 *	converge count as well.
+	 */
+	for (i = 0; i < arguments->numberOfRepetitions; i++)
+	{
+		double	error;
+
+		runAmplitudeEstimationExperiment(&experiment, &benchmarkArguments, precomputation, i + 1, gslRNG);
+		error = arguments->targetAmplitude - experiment.amplitude;
+		absoluteErrors[i] = fabs(error);
+		bayesianSumOfSquaredErrors += error * error;
+		bayesianNumberOfOracleCalls += (double) experiment.numberOfOracleCalls;
+		bayesianNumberOfCircuits += (double) experiment.numberOfIterations;
+	}
+	bayesianRootMeanSquareError = sqrt(bayesianSumOfSquaredErrors / arguments->numberOfRepetitions);
+	bayesianMedianAbsoluteError = calculateMedianAbsoluteError(absoluteErrors, arguments->numberOfRepetitions);
+	bayesianNumberOfOracleCalls /= arguments->numberOfRepetitions;
+
+	printf("\nBenchmark of %zu amplitude estimation experiments of amplitude %lf with %"PRIu64" shots per circuit:\n", arguments->numberOfRepetitions, arguments->targetAmplitude, numberOfShots);
+	printf("%-28s %12s %16s %16s %16s\n", "", "circuits", "oracle calls", "median error", "rms error");
+	printf("%-28s %12.3lf %16.6le %16.6le %16.6le\n", "Bayesian (RFPE updates)", bayesianNumberOfCircuits / arguments->numberOfRepetitions, bayesianNumberOfOracleCalls, bayesianMedianAbsoluteError, bayesianRootMeanSquareError);
+
+	/*
+	 *	Maximum likelihood amplitude estimation on the Grover powers 0, 1,
+	 *	2, 4, ..., with one more stage at a time until it matches both the
+	 *	median and the root mean square error. The root mean square error
+	 *	of a few thousand experiments is dominated by the rare ones that
+	 *	locked onto a wrong fringe, so both are reported.
+	 */
+	for (numberOfStages = 1; numberOfStages <= kMaximumLikelihoodMaximumNumberOfStages; numberOfStages++)
+	{
+		char		name[32];
+		double		sumOfSquaredErrors = 0.0;
+		uint64_t	numberOfOracleCalls = 0;
+		double		rootMeanSquareError;
+		double		medianAbsoluteError;
+		size_t		k;
+
+		for (k = 0; k < numberOfStages; k++)
+		{
+			groverPowers[k] = (k == 0) ? 0 : (uint64_t) 1 << (k - 1);
+			numberOfOracleCalls += numberOfShots * (2 * groverPowers[k] + 1);
+		}
+
+		for (i = 0; i < arguments->numberOfRepetitions; i++)
+		{
+			double	error;
+
+			for (k = 0; k < numberOfStages; k++)
+			{
+				uint64_t	evidenceSampleCounts[2];
+
+				runQPECircuit(targetAngle, 2.0 * (2 * groverPowers[k] + 1), 0.0, evidenceSampleCounts, numberOfShots, gslRNG);
+				countsOfOne[k] = evidenceSampleCounts[1];
+			}
+			error = arguments->targetAmplitude - pow(sin(estimateAmplitudeAngleByMaximumLikelihood(groverPowers, countsOfOne, numberOfStages, numberOfShots)), 2);
+			absoluteErrors[i] = fabs(error);
+			sumOfSquaredErrors += error * error;
+		}
+		rootMeanSquareError = sqrt(sumOfSquaredErrors / arguments->numberOfRepetitions);
+		medianAbsoluteError = calculateMedianAbsoluteError(absoluteErrors, arguments->numberOfRepetitions);
+
+		snprintf(name, sizeof(name), "MLE, %zu stages", numberOfStages);
+		printf("%-28s %12zu %16.6le %16.6le %16.6le\n", name, numberOfStages, (double) numberOfOracleCalls, medianAbsoluteError, rootMeanSquareError);
+
+		if (!isMedianMatched && medianAbsoluteError <= bayesianMedianAbsoluteError)
+		{
+			printf("\nMaximum likelihood amplitude estimation needs %.2lf times the oracle calls of Bayesian amplitude estimation for the same median error.\n\n", numberOfOracleCalls / bayesianNumberOfOracleCalls);
+			isMedianMatched = true;
+		}
+		if (!isRootMeanSquareMatched && rootMeanSquareError <= bayesianRootMeanSquareError)
+		{
+			printf("\nMaximum likelihood amplitude estimation needs %.2lf times the oracle calls of Bayesian amplitude estimation for the same rms error.\n\n", numberOfOracleCalls / bayesianNumberOfOracleCalls);
+			isRootMeanSquareMatched = true;
+		}
+		if (isMedianMatched && isRootMeanSquareMatched)
+		{
+			break;
+		}
+	}
+
+	free(absoluteErrors);
+	freeRFPEPrecomputation(precomputation);
+
+	return 0;
+}
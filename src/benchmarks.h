@@ -0,0 +1,110 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <gsl/gsl_rng.h>
+#include "utilities.h"
+
+/**
+ *	@brief	Compare the C estimator path with the compile-time composed pipelines.
+ *
+ *	@param	arguments	: command line arguments, -r sets the number of experiments per path
+ *	@param	gslRNG		: GSL random number generator used to seed every path identically
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runPipelineBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Measure the throughput and the statistics of the shot record generator.
+ *
+ *	@param	arguments	: command line arguments
+ *	@param	gslRNG		: GSL random number generator used to seed the shot generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runShotRecordBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Compare the latency of doRFPE() with the kernels specialized for fixed numbers of prior samples.
+ *
+ *	@param	arguments	: command line arguments, -t, -a and -n set the simulated update
+ *	@param	gslRNG		: GSL random number generator used to seed every kernel identically
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runRFPEKernelBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Compare the latency of a whole RFPE update with the part of a split update that needs the counts.
+ *
+ *	@param	arguments	: command line arguments, -n, -a and -t set the evidence
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runRFPEOverlapBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Compare batch RFPE updates of many qubits with updating them one by one.
+ *
+ *	@param	arguments	: command line arguments, -m, -n, -a, -p and --threads set the rounds
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runRFPEBatchBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Measure the quantiles of the latency of AQPE iterations under background load, in real-time mode with --realtime.
+ *
+ *	@param	arguments	: command line arguments, -m, -n, -a, -p, --background-load and the real-time options set the run
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runRealTimeBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Compare the iterations, cost and errors of AQPE experiments stopped by the standard deviation and by the posterior mass within the precision.
+ *
+ *	@param	arguments	: command line arguments, -r experiments of the --engine with -m, -n, -a and -p per stopping rule
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runStoppingRuleBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Compare the oracle calls of Bayesian amplitude estimation with those of maximum likelihood amplitude estimation on the Grover powers 0, 1, 2, 4, ... at the same root mean square error.
+ *
+ *	@param	arguments	: command line arguments, -r experiments with --amplitude, -m, -n, -a and -p
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runAmplitudeEstimationBenchmark(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
@@ -3,8 +3,33 @@
 # Explicitly specify which files to compile
 SOURCES = \
 	main.c \
+	allocationHooks.c \
+	amplitudeEstimation.c \
+	aqpe.c \
+	aqpeLibrary.c \
+	aqpePipeline.c \
+	benchmarks.c \
+	convergenceCurves.c \
+	costPredictor.c \
+	decoherence.c \
+	estimatorEfficiency.c \
+	instrumentation.c \
+	meshPosterior.c \
+	mixture.c \
+	quantumResources.c \
+	realTime.c \
+	resultLog.c \
+	resultStream.c \
+	rfpeBatch.c \
+	rfpeKernels.c \
+	rfpeMultiOutcome.c \
+	rfpeSplit.c \
+	rfpeStratified.c \
+	rfpeTempered.c \
+	scheduler.c \
+	shotRecord.c \
 	utilities.c\
 
 CFLAGS = -I../include/
 LDFLAGS	= -L../libs/
-LIBS	= -lgsl -lgslcblas
+LIBS	= -lgsl -lgslcblas -lpthread -lrt
@@ -0,0 +1,225 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "convergenceCurves.h"
+
+static const char *	kConvergenceCurveNames[kConvergenceCurveNumberOfQuantities] = {
+	"std",
+	"error",
+	"M",
+	"accepted",
+};
+
+static const double	kConvergenceCurveQuantiles[] = {0.1, 0.5, 0.9};
+
+/*
+ *	10^kConvergenceCurveMinimumDecade
+ */
+static const double	kConvergenceCurveMinimumValue = 1e-16;
+
+static size_t
+convergenceCurveBin(double value)
+{
+	double	position;
+
+	if (!(value >= kConvergenceCurveMinimumValue))
+	{
+		return 0;
+	}
+
+	position = (log10(value) - kConvergenceCurveMinimumDecade) * kConvergenceCurveBinsPerDecade;
+
+	return (position >= kConvergenceCurveNumberOfBins - 1) ? kConvergenceCurveNumberOfBins - 1 : 1 + (size_t) position;
+}
+
+/*
+ *	Quantile of a histogram, interpolated log-linearly within its bin. Values
+ *	in the first bin are reported as 0.
+ */
+static double
+convergenceCurveQuantile(const uint32_t *  counts, uint64_t numberOfValues, double quantile)
+{
+	double	rank = quantile * numberOfValues;
+	double	cumulativeCount = 0.0;
+	size_t	i;
+
+	for (i = 0; i < kConvergenceCurveNumberOfBins; i++)
+	{
+		if ((counts[i] > 0) && (cumulativeCount + counts[i] >= rank))
+		{
+			double	fraction = (rank - cumulativeCount) / counts[i];
+
+			if (i == 0)
+			{
+				return 0.0;
+			}
+
+			return pow(10, kConvergenceCurveMinimumDecade + (i - 1 + fraction) / kConvergenceCurveBinsPerDecade);
+		}
+		cumulativeCount += counts[i];
+	}
+
+	return NAN;
+}
+
+ConvergenceCurves *
+allocConvergenceCurves(void)
+{
+	return (ConvergenceCurves *) calloc(1, sizeof(ConvergenceCurves));
+}
+
+void
+freeConvergenceCurves(ConvergenceCurves *  curves)
+{
+	free(curves);
+}
+
+void
+accumulateConvergenceCurves(ConvergenceCurves *  curves, size_t iteration, const double values[kConvergenceCurveNumberOfQuantities])
+{
+	size_t	q;
+
+	if ((iteration == 0) || (iteration > kMaxNumberOfIterations))
+	{
+		return;
+	}
+
+	for (q = 0; q < kConvergenceCurveNumberOfQuantities; q++)
+	{
+		bool	first = (curves->numberOfExperiments[iteration - 1] == 0);
+
+		curves->minima[iteration - 1][q] = first ? values[q] : fmin(curves->minima[iteration - 1][q], values[q]);
+		curves->maxima[iteration - 1][q] = first ? values[q] : fmax(curves->maxima[iteration - 1][q], values[q]);
+		curves->sums[iteration - 1][q] += values[q];
+		curves->counts[iteration - 1][q][convergenceCurveBin(values[q])]++;
+	}
+	curves->numberOfExperiments[iteration - 1]++;
+}
+
+void
+mergeConvergenceCurves(ConvergenceCurves *  curves, const ConvergenceCurves *  otherCurves)
+{
+	size_t	i;
+	size_t	q;
+	size_t	b;
+
+	for (i = 0; i < kMaxNumberOfIterations; i++)
+	{
+		if (otherCurves->numberOfExperiments[i] == 0)
+		{
+			continue;
+		}
+
+		for (q = 0; q < kConvergenceCurveNumberOfQuantities; q++)
+		{
+			bool	first = (curves->numberOfExperiments[i] == 0);
+
+			curves->minima[i][q] = first ? otherCurves->minima[i][q] : fmin(curves->minima[i][q], otherCurves->minima[i][q]);
+			curves->maxima[i][q] = first ? otherCurves->maxima[i][q] : fmax(curves->maxima[i][q], otherCurves->maxima[i][q]);
+			curves->sums[i][q] += otherCurves->sums[i][q];
+
+			for (b = 0; b < kConvergenceCurveNumberOfBins; b++)
+			{
+				curves->counts[i][q][b] += otherCurves->counts[i][q][b];
+			}
+		}
+		curves->numberOfExperiments[i] += otherCurves->numberOfExperiments[i];
+	}
+}
+
+int
+writeConvergenceCurves(const ConvergenceCurves *  curves, const char *  path)
+{
+	FILE *	file = (strcmp(path, "-") == 0) ? stdout : fopen(path, "w");
+	size_t	i;
+	size_t	q;
+	size_t	k;
+	int	status = 0;
+
+	if (file == NULL)
+	{
+		fprintf(stderr, "\nError: Could not open convergence curves file '%s'.\n", path);
+
+		return 1;
+	}
+
+	fprintf(file, "# iteration experiments");
+	for (q = 0; q < kConvergenceCurveNumberOfQuantities; q++)
+	{
+		fprintf(file, " %s_mean", kConvergenceCurveNames[q]);
+		for (k = 0; k < sizeof(kConvergenceCurveQuantiles) / sizeof(kConvergenceCurveQuantiles[0]); k++)
+		{
+			fprintf(file, " %s_p%02d", kConvergenceCurveNames[q], (int) lround(100 * kConvergenceCurveQuantiles[k]));
+		}
+	}
+	fprintf(file, "\n");
+
+	for (i = 0; i < kMaxNumberOfIterations; i++)
+	{
+		uint64_t	numberOfExperiments = curves->numberOfExperiments[i];
+
+		if (numberOfExperiments == 0)
+		{
+			continue;
+		}
+
+		fprintf(file, "%zu %" PRIu64, i + 1, numberOfExperiments);
+		for (q = 0; q < kConvergenceCurveNumberOfQuantities; q++)
+		{
+			fprintf(file, " %le", curves->sums[i][q] / numberOfExperiments);
+			for (k = 0; k < sizeof(kConvergenceCurveQuantiles) / sizeof(kConvergenceCurveQuantiles[0]); k++)
+			{
+				double	quantile = convergenceCurveQuantile(curves->counts[i][q], numberOfExperiments, kConvergenceCurveQuantiles[k]);
+
+				fprintf(file, " %le", fmin(fmax(quantile, curves->minima[i][q]), curves->maxima[i][q]));
+			}
+		}
+		fprintf(file, "\n");
+	}
+
+	if (file != stdout)
+	{
+		status = (fclose(file) == 0) ? 0 : 1;
+		if (status)
+		{
+			fprintf(stderr, "\nError: Could not write convergence curves file '%s'.\n", path);
+		}
+	}
+
+	return status;
+}
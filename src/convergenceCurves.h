@@ -0,0 +1,113 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include "aqpe.h"
+
+typedef enum
+{
+	kConvergenceCurveStandardDeviation,
+	kConvergenceCurveError,
+	kConvergenceCurveM,
+	kConvergenceCurveAcceptedSamples,
+	kConvergenceCurveNumberOfQuantities,
+} ConvergenceCurveQuantity;
+
+typedef enum
+{
+	kConvergenceCurveBinsPerDecade = 16,
+	kConvergenceCurveMinimumDecade = -16,
+	kConvergenceCurveMaximumDecade = 16,
+	kConvergenceCurveNumberOfBins = 1 + (kConvergenceCurveMaximumDecade - kConvergenceCurveMinimumDecade) * kConvergenceCurveBinsPerDecade,
+} ConvergenceCurveConstants;
+
+/*
+ *	Distribution of each quantity across experiments, per iteration index, in
+ *	constant memory. Each distribution is a histogram with logarithmic bins
+ *	over [1e-16, 1e16), whose first bin collects the values below 1e-16 and
+ *	zero, so that histograms of different threads merge by addition. Means,
+ *	minima and maxima are kept exactly, quantiles to within a bin, i.e.,
+ *	about 7%, and within the minimum and maximum.
+ */
+typedef struct ConvergenceCurves
+{
+	uint64_t	numberOfExperiments[kMaxNumberOfIterations];
+	double		sums[kMaxNumberOfIterations][kConvergenceCurveNumberOfQuantities];
+	double		minima[kMaxNumberOfIterations][kConvergenceCurveNumberOfQuantities];
+	double		maxima[kMaxNumberOfIterations][kConvergenceCurveNumberOfQuantities];
+	uint32_t	counts[kMaxNumberOfIterations][kConvergenceCurveNumberOfQuantities][kConvergenceCurveNumberOfBins];
+} ConvergenceCurves;
+
+/**
+ *	@brief	Allocate empty convergence curves.
+ *
+ *	@return	ConvergenceCurves *	: curves, release with freeConvergenceCurves()
+ */
+ConvergenceCurves *	allocConvergenceCurves(void);
+
+/**
+ *	@brief	Release convergence curves.
+ *
+ *	@param	curves	: curves to release
+ */
+void	freeConvergenceCurves(ConvergenceCurves *  curves);
+
+/**
+ *	@brief	Add the state of one experiment after an iteration to the curves.
+ *
+ *	@param	curves			: curves to add to
+ *	@param	iteration		: iteration number, from 1
+ *	@param	values			: value of every ConvergenceCurveQuantity
+ */
+void	accumulateConvergenceCurves(ConvergenceCurves *  curves, size_t iteration, const double values[kConvergenceCurveNumberOfQuantities]);
+
+/**
+ *	@brief	Add the curves of another thread.
+ *
+ *	@param	curves		: curves to add to
+ *	@param	otherCurves	: curves to add
+ */
+void	mergeConvergenceCurves(ConvergenceCurves *  curves, const ConvergenceCurves *  otherCurves);
+
+/**
+ *	@brief	Write the curves as a whitespace-separated table, one row per iteration.
+ *
+ *	@param	curves	: curves to write
+ *	@param	path	: path of the table, or "-" for stdout
+ *	@return	int	: 0 if successful, else 1
+ */
+int	writeConvergenceCurves(const ConvergenceCurves *  curves, const char *  path);
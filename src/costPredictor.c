@@ -0,0 +1,404 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "costPredictor.h"
+
+static const char	kCostTableMagic[8] = {'A', 'Q', 'P', 'E', 'C', 'S', 'T', '1'};
+static const size_t	kCostTableValuesPerCell = 3;
+static const double	kMinimumCPUTimePerExperiment = 1e-9;
+
+/*
+ *	Grid used when refreshing the table.
+ */
+static const double	kRefreshLogPrecisions[] = {-1.0, -2.0, -3.0, -4.0, -5.0, -6.0};
+static const double	kRefreshAlphas[] = {0.0, 0.25, 0.5, 0.75, 1.0};
+static const double	kRefreshLogEvidenceSamples[] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+static const double	kRefreshLogPriorSamples[] = {1.0, 2.0, 3.0, 4.0};
+
+typedef struct CostTableRefreshJob
+{
+	CostTable *	table;
+	double		targetPhi;
+	size_t		numberOfRepetitionsPerCell;
+	size_t		numberOfCells;
+	atomic_size_t	nextCell;
+} CostTableRefreshJob;
+
+typedef struct CostTableRefreshWorker
+{
+	CostTableRefreshJob *	job;
+	unsigned long		randomSeed;
+} CostTableRefreshWorker;
+
+static size_t
+numberOfCostTableCells(const CostTable *  table)
+{
+	size_t	numberOfCells = 1;
+	size_t	axis;
+
+	for (axis = 0; axis < kCostTableNumberOfAxes; axis++)
+	{
+		numberOfCells *= table->axisLengths[axis];
+	}
+
+	return numberOfCells;
+}
+
+/*
+ *	Cells are stored with the last axis varying fastest.
+ */
+static void
+cellIndexToAxisIndices(const CostTable *  table, size_t cellIndex, size_t *  axisIndices)
+{
+	int	axis;
+
+	for (axis = kCostTableNumberOfAxes - 1; axis >= 0; axis--)
+	{
+		axisIndices[axis] = cellIndex % table->axisLengths[axis];
+		cellIndex /= table->axisLengths[axis];
+	}
+}
+
+static double
+threadCPUTime(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int
+loadCostTable(const char *  path, CostTable *  table)
+{
+	FILE *	file;
+	char	magic[sizeof(kCostTableMagic)];
+	size_t	numberOfCells;
+	size_t	axis;
+	bool	ok;
+
+	memset(table, 0, sizeof(*table));
+
+	file = fopen(path, "rb");
+	if (file == NULL)
+	{
+		fprintf(stderr, "\nError: Could not open cost table '%s'. Use '--refresh-cost-table %s' to generate it.\n", path, path);
+
+		return 1;
+	}
+
+	ok = (fread(magic, sizeof(magic), 1, file) == 1) && (memcmp(magic, kCostTableMagic, sizeof(magic)) == 0);
+	ok = ok && (fread(table->axisLengths, sizeof(table->axisLengths), 1, file) == 1);
+
+	for (axis = 0; ok && (axis < kCostTableNumberOfAxes); axis++)
+	{
+		ok = (table->axisLengths[axis] > 0);
+		table->axisValues[axis] = ok ? (double *) malloc(table->axisLengths[axis] * sizeof(double)) : NULL;
+		ok = ok && (fread(table->axisValues[axis], sizeof(double), table->axisLengths[axis], file) == table->axisLengths[axis]);
+	}
+
+	if (ok)
+	{
+		numberOfCells = numberOfCostTableCells(table);
+		table->cells = (float *) malloc(numberOfCells * kCostTableValuesPerCell * sizeof(float));
+		ok = (fread(table->cells, sizeof(float), numberOfCells * kCostTableValuesPerCell, file) == numberOfCells * kCostTableValuesPerCell);
+	}
+
+	fclose(file);
+
+	if (!ok)
+	{
+		fprintf(stderr, "\nError: '%s' is not a valid cost table.\n", path);
+		freeCostTable(table);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+void
+freeCostTable(CostTable *  table)
+{
+	size_t	axis;
+
+	for (axis = 0; axis < kCostTableNumberOfAxes; axis++)
+	{
+		free(table->axisValues[axis]);
+		table->axisValues[axis] = NULL;
+	}
+	free(table->cells);
+	table->cells = NULL;
+}
+
+CostPrediction
+predictCost(const CostTable *  table, double precision, double alpha, uint64_t numberOfEvidenceSamples, size_t numberOfPriorTestSamples)
+{
+	CostPrediction	prediction = {0};
+	double		query[kCostTableNumberOfAxes];
+	size_t		lowerIndex[kCostTableNumberOfAxes];
+	double		fraction[kCostTableNumberOfAxes];
+	double		logCPUTime = 0.0;
+	size_t		corner;
+	size_t		axis;
+
+	query[kCostTableAxisLogPrecision] = log10(precision);
+	query[kCostTableAxisAlpha] = alpha;
+	query[kCostTableAxisLogEvidenceSamples] = log10((double) numberOfEvidenceSamples);
+	query[kCostTableAxisLogPriorSamples] = log10((double) numberOfPriorTestSamples);
+
+	/*
+	 *	Locate the query on each axis, clamping to the range of the grid.
+	 *	Axis values may be stored in increasing or decreasing order.
+	 */
+	for (axis = 0; axis < kCostTableNumberOfAxes; axis++)
+	{
+		const double *	values = table->axisValues[axis];
+		size_t		length = table->axisLengths[axis];
+		double		direction = (length > 1 && values[length - 1] < values[0]) ? -1.0 : 1.0;
+		size_t		i = 0;
+
+		lowerIndex[axis] = 0;
+		fraction[axis] = 0.0;
+
+		if (length == 1 || direction * (query[axis] - values[0]) <= 0)
+		{
+			continue;
+		}
+		if (direction * (query[axis] - values[length - 1]) >= 0)
+		{
+			lowerIndex[axis] = length - 1;
+			continue;
+		}
+		while (direction * (query[axis] - values[i + 1]) > 0)
+		{
+			i++;
+		}
+		lowerIndex[axis] = i;
+		fraction[axis] = (query[axis] - values[i]) / (values[i + 1] - values[i]);
+	}
+
+	/*
+	 *	Multilinear interpolation over the 2^4 corners of the enclosing cell.
+	 *	CPU time spans orders of magnitude, so it is interpolated in log space.
+	 */
+	for (corner = 0; corner < (1u << kCostTableNumberOfAxes); corner++)
+	{
+		double		weight = 1.0;
+		size_t		cellIndex = 0;
+		const float *	cell;
+
+		for (axis = 0; axis < kCostTableNumberOfAxes; axis++)
+		{
+			size_t	upper = (corner >> axis) & 1;
+			size_t	index = lowerIndex[axis] + ((fraction[axis] > 0.0) ? upper : 0);
+
+			weight *= upper ? fraction[axis] : (1.0 - fraction[axis]);
+			cellIndex = cellIndex * table->axisLengths[axis] + index;
+		}
+
+		if (weight == 0.0)
+		{
+			continue;
+		}
+
+		cell = &table->cells[cellIndex * kCostTableValuesPerCell];
+		prediction.expectedNumberOfIterations += weight * cell[0];
+		prediction.convergenceProbability += weight * cell[1];
+		logCPUTime += weight * log(fmax(cell[2], kMinimumCPUTimePerExperiment));
+	}
+	prediction.cpuTimePerExperiment = exp(logCPUTime);
+
+	return prediction;
+}
+
+static void *
+costTableRefreshWorker(void *  argument)
+{
+	CostTableRefreshWorker *	worker = (CostTableRefreshWorker *) argument;
+	CostTableRefreshJob *		job = worker->job;
+	CostTable *			table = job->table;
+	gsl_rng *			gslRNG;
+	size_t				axisIndices[kCostTableNumberOfAxes];
+	size_t				cellIndex;
+	size_t				i;
+
+	gslRNG = gsl_rng_alloc(gsl_rng_default);
+	gsl_rng_set(gslRNG, worker->randomSeed);
+
+	while ((cellIndex = atomic_fetch_add(&job->nextCell, 1)) < job->numberOfCells)
+	{
+		CommandLineArguments	arguments;
+		double			totalIterations = 0.0;
+		double			totalCPUTime = 0.0;
+		size_t			convergenceCount = 0;
+		float *			cell = &table->cells[cellIndex * kCostTableValuesPerCell];
+
+		initCommandLineArguments(&arguments);
+		cellIndexToAxisIndices(table, cellIndex, axisIndices);
+		arguments.targetPhi = job->targetPhi;
+		arguments.precision = pow(10.0, table->axisValues[kCostTableAxisLogPrecision][axisIndices[kCostTableAxisLogPrecision]]);
+		arguments.alpha = table->axisValues[kCostTableAxisAlpha][axisIndices[kCostTableAxisAlpha]];
+		arguments.numberOfEvidenceSamplesPerIteration = (uint64_t) llround(pow(10.0, table->axisValues[kCostTableAxisLogEvidenceSamples][axisIndices[kCostTableAxisLogEvidenceSamples]]));
+		arguments.numberOfPriorTestSamplesPerIteration = (size_t) llround(pow(10.0, table->axisValues[kCostTableAxisLogPriorSamples][axisIndices[kCostTableAxisLogPriorSamples]]));
+		arguments.numberOfRepetitions = job->numberOfRepetitionsPerCell;
+		arguments.verbose = false;
+
+		for (i = 0; i < job->numberOfRepetitionsPerCell; i++)
+		{
+			size_t			convergenceIterationCount = kMaxNumberOfIterations;
+			double			estimatedPhi;
+			QuantumResources	resources;
+			double			startTime = threadCPUTime();
+
+			if (runAQPEviaRFPEExperiment(kInitialPriorMeanValue, kInitialPriorStandardDeviation, &arguments, i + 1, gslRNG, &convergenceIterationCount, &estimatedPhi, &resources))
+			{
+				convergenceCount++;
+			}
+			else
+			{
+				convergenceIterationCount = kMaxNumberOfIterations;
+			}
+
+			totalCPUTime += threadCPUTime() - startTime;
+			totalIterations += (double) convergenceIterationCount;
+		}
+
+		cell[0] = (float) (totalIterations / job->numberOfRepetitionsPerCell);
+		cell[1] = (float) ((double) convergenceCount / job->numberOfRepetitionsPerCell);
+		cell[2] = (float) fmax(totalCPUTime / job->numberOfRepetitionsPerCell, kMinimumCPUTimePerExperiment);
+	}
+
+	gsl_rng_free(gslRNG);
+
+	return NULL;
+}
+
+int
+refreshCostTable(const char *  path, double targetPhi, size_t numberOfRepetitionsPerCell, size_t numberOfThreads, gsl_rng *  gslRNG)
+{
+	const double *			refreshAxisValues[kCostTableNumberOfAxes] = {
+						kRefreshLogPrecisions,
+						kRefreshAlphas,
+						kRefreshLogEvidenceSamples,
+						kRefreshLogPriorSamples,
+					};
+	const size_t			refreshAxisLengths[kCostTableNumberOfAxes] = {
+						sizeof(kRefreshLogPrecisions) / sizeof(double),
+						sizeof(kRefreshAlphas) / sizeof(double),
+						sizeof(kRefreshLogEvidenceSamples) / sizeof(double),
+						sizeof(kRefreshLogPriorSamples) / sizeof(double),
+					};
+	CostTable			table = {0};
+	CostTableRefreshJob		job;
+	CostTableRefreshWorker *	workers;
+	pthread_t *			threads;
+	FILE *				file;
+	size_t				axis;
+	size_t				i;
+	bool				ok;
+
+	for (axis = 0; axis < kCostTableNumberOfAxes; axis++)
+	{
+		table.axisLengths[axis] = (uint32_t) refreshAxisLengths[axis];
+		table.axisValues[axis] = (double *) malloc(refreshAxisLengths[axis] * sizeof(double));
+		memcpy(table.axisValues[axis], refreshAxisValues[axis], refreshAxisLengths[axis] * sizeof(double));
+	}
+
+	job.table = &table;
+	job.targetPhi = targetPhi;
+	job.numberOfRepetitionsPerCell = numberOfRepetitionsPerCell;
+	job.numberOfCells = numberOfCostTableCells(&table);
+	atomic_init(&job.nextCell, 0);
+	table.cells = (float *) malloc(job.numberOfCells * kCostTableValuesPerCell * sizeof(float));
+
+	fprintf(stderr, "Refreshing cost table '%s': %zu cells, %zu experiments per cell, %zu threads.\n", path, job.numberOfCells, numberOfRepetitionsPerCell, numberOfThreads);
+
+	/*
+	 *	Cells are handed out dynamically since their cost varies by orders of magnitude.
+	 */
+	workers = (CostTableRefreshWorker *) malloc(numberOfThreads * sizeof(CostTableRefreshWorker));
+	threads = (pthread_t *) malloc(numberOfThreads * sizeof(pthread_t));
+
+	for (i = 0; i < numberOfThreads; i++)
+	{
+		workers[i].job = &job;
+		workers[i].randomSeed = gsl_rng_get(gslRNG) + 1;
+		pthread_create(&threads[i], NULL, costTableRefreshWorker, &workers[i]);
+	}
+	for (i = 0; i < numberOfThreads; i++)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	free(threads);
+	free(workers);
+
+	file = fopen(path, "wb");
+	ok = (file != NULL);
+	ok = ok && (fwrite(kCostTableMagic, sizeof(kCostTableMagic), 1, file) == 1);
+	ok = ok && (fwrite(table.axisLengths, sizeof(table.axisLengths), 1, file) == 1);
+
+	for (axis = 0; ok && (axis < kCostTableNumberOfAxes); axis++)
+	{
+		ok = (fwrite(table.axisValues[axis], sizeof(double), table.axisLengths[axis], file) == table.axisLengths[axis]);
+	}
+
+	ok = ok && (fwrite(table.cells, sizeof(float), job.numberOfCells * kCostTableValuesPerCell, file) == job.numberOfCells * kCostTableValuesPerCell);
+
+	if (file != NULL)
+	{
+		ok = (fclose(file) == 0) && ok;
+	}
+
+	freeCostTable(&table);
+
+	if (!ok)
+	{
+		fprintf(stderr, "\nError: Could not write cost table '%s'.\n", path);
+
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+
+typedef enum
+{
+	kCostTableAxisLogPrecision,
+	kCostTableAxisAlpha,
+	kCostTableAxisLogEvidenceSamples,
+	kCostTableAxisLogPriorSamples,
+	kCostTableNumberOfAxes,
+} CostTableAxis;
+
+typedef struct CostPrediction
+{
+	double	expectedNumberOfIterations;
+	double	convergenceProbability;
+	double	cpuTimePerExperiment;
+} CostPrediction;
+
+/*
+ *	Table of simulated costs on a regular grid over (log10 precision, alpha,
+ *	log10 N, log10 m). Each cell holds three floats: the mean number of
+ *	iterations, the fraction of converging experiments, and the mean CPU time
+ *	in seconds per experiment.
+ */
+typedef struct CostTable
+{
+	uint32_t	axisLengths[kCostTableNumberOfAxes];
+	double *	axisValues[kCostTableNumberOfAxes];
+	float *		cells;
+} CostTable;
+
+/**
+ *	@brief	Load a cost table from a file written by refreshCostTable().
+ *
+ *	@param	path	: path of the cost table file
+ *	@param	table	: table to fill, release with freeCostTable()
+ *	@return	int	: 0 if successful, else 1
+ */
+int	loadCostTable(const char *  path, CostTable *  table);
+
+/**
+ *	@brief	Release the memory held by a cost table.
+ *
+ *	@param	table	: table to release
+ */
+void	freeCostTable(CostTable *  table);
+
+/**
+ *	@brief	Predict the cost of an AQPE experiment by multilinear interpolation in the table.
+ *
+ *	@param	table				: loaded cost table
+ *	@param	precision			: precision in phase estimation
+ *	@param	alpha				: AQPE alpha
+ *	@param	numberOfEvidenceSamples		: number of evidence samples per iteration
+ *	@param	numberOfPriorTestSamples	: number of prior test samples per iteration
+ *	@return	CostPrediction			: predicted iterations, convergence probability and CPU time
+ */
+CostPrediction	predictCost(const CostTable *  table, double precision, double alpha, uint64_t numberOfEvidenceSamples, size_t numberOfPriorTestSamples);
+
+/**
+ *	@brief	Regenerate the cost table by simulating every grid cell in parallel.
+ *
+ *	@param	path				: path of the cost table file to write
+ *	@param	targetPhi			: eigenphase used in the simulations
+ *	@param	numberOfRepetitionsPerCell	: number of AQPE experiments per grid cell
+ *	@param	numberOfThreads			: number of worker threads
+ *	@param	gslRNG				: GSL random number generator used to seed the workers
+ *	@return	int				: 0 if successful, else 1
+ */
+int	refreshCostTable(const char *  path, double targetPhi, size_t numberOfRepetitionsPerCell, size_t numberOfThreads, gsl_rng *  gslRNG);
@@ -0,0 +1,409 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "decoherence.h"
+
+/*
+ *	Normalize the log-density to a maximum of 0 and compute the marginal moments.
+ */
+static void
+computePhaseDecoherenceMoments(PhaseDecoherencePosterior *  posterior)
+{
+	double	maxOfLogDensity = -INFINITY;
+	double	total = 0.0;
+	double	phaseSum = 0.0;
+	double	phaseSumOfSquares = 0.0;
+	double	rateSum = 0.0;
+	double	rateSumOfSquares = 0.0;
+	size_t	i;
+	size_t	k;
+
+	for (i = 0; i < kDecoherenceGridNumberOfPhases * kDecoherenceGridNumberOfRates; i++)
+	{
+		maxOfLogDensity = fmax(maxOfLogDensity, posterior->logDensity[i]);
+	}
+
+	for (i = 0; i < kDecoherenceGridNumberOfPhases; i++)
+	{
+		double *	row = &posterior->logDensity[i * kDecoherenceGridNumberOfRates];
+		double		rowTotal = 0.0;
+
+		for (k = 0; k < kDecoherenceGridNumberOfRates; k++)
+		{
+			double	density;
+
+			row[k] -= maxOfLogDensity;
+			density = exp(row[k]);
+			rowTotal += density;
+			rateSum += density * posterior->rates[k];
+			rateSumOfSquares += density * posterior->rates[k] * posterior->rates[k];
+		}
+
+		total += rowTotal;
+		phaseSum += rowTotal * posterior->phases[i];
+		phaseSumOfSquares += rowTotal * posterior->phases[i] * posterior->phases[i];
+	}
+
+	/*
+	 *	A posterior within one grid cell is resolved no finer than the cell,
+	 *	so the standard deviations are floored at the spacing of the axes.
+	 */
+	posterior->phaseMeanValue = phaseSum / total;
+	posterior->phaseStandardDeviation = fmax(sqrt(fmax(phaseSumOfSquares / total - posterior->phaseMeanValue * posterior->phaseMeanValue, 0.0)), posterior->phases[1] - posterior->phases[0]);
+	posterior->rateMeanValue = rateSum / total;
+	posterior->rateStandardDeviation = fmax(sqrt(fmax(rateSumOfSquares / total - posterior->rateMeanValue * posterior->rateMeanValue, 0.0)), posterior->rates[1] - posterior->rates[0]);
+}
+
+/*
+ *	Linearly interpolate the density of one line of the grid from oldAxis to
+ *	newAxis. Points outside the old axis get zero density. An old axis of
+ *	zero width has all its density at one point, which the new axis keeps.
+ */
+static void
+interpolateLogDensity(const double *  oldAxis, const double *  newAxis, size_t length, const double *  oldLogDensity, double *  newLogDensity, size_t stride)
+{
+	double	oldSpacing = oldAxis[1] - oldAxis[0];
+	size_t	i;
+
+	for (i = 0; i < length; i++)
+	{
+		double	position = (newAxis[i] - oldAxis[0]) / oldSpacing;
+
+		if (!(oldSpacing > 0.0))
+		{
+			newLogDensity[i * stride] = oldLogDensity[i * stride];
+		}
+		else if ((position < 0.0) || (position > length - 1))
+		{
+			newLogDensity[i * stride] = -INFINITY;
+		}
+		else
+		{
+			size_t	lower = (size_t) fmin(floor(position), length - 2);
+			double	fraction = position - lower;
+
+			newLogDensity[i * stride] = log((1 - fraction) * exp(oldLogDensity[lower * stride]) + fraction * exp(oldLogDensity[(lower + 1) * stride]));
+		}
+	}
+}
+
+/*
+ *	Compute a narrower axis around the posterior once it covers less than half
+ *	of the current axis. Returns false if the axis should be kept, which
+ *	includes a posterior that would give the new axis no width.
+ */
+static bool
+zoomAxis(const double *  axis, size_t length, double meanValue, double standardDeviation, double minimum, double maximum, double *  newAxis)
+{
+	double	halfWidth = kDecoherenceGridHalfWidthInStandardDeviations * standardDeviation;
+	double	lower = fmax(meanValue - halfWidth, minimum);
+	double	upper = fmin(meanValue + halfWidth, maximum);
+	size_t	i;
+
+	if (!(upper > lower) || (2 * (upper - lower) > axis[length - 1] - axis[0]))
+	{
+		return false;
+	}
+
+	for (i = 0; i < length; i++)
+	{
+		newAxis[i] = lower + i * (upper - lower) / (length - 1);
+	}
+
+	return true;
+}
+
+/*
+ *	Zoom both axes in on the posterior as it narrows, so that the grid keeps
+ *	resolving it. The density is interpolated along one axis at a time.
+ */
+static void
+regridPhaseDecoherencePosterior(PhaseDecoherencePosterior *  posterior, double maximumDecoherenceRate)
+{
+	double		newPhases[kDecoherenceGridNumberOfPhases];
+	double		newRates[kDecoherenceGridNumberOfRates];
+	double *	newLogDensity = posterior->nextLogDensity;
+	size_t		i;
+	size_t		k;
+
+	if (zoomAxis(posterior->phases, kDecoherenceGridNumberOfPhases, posterior->phaseMeanValue, posterior->phaseStandardDeviation, -M_PI, M_PI, newPhases))
+	{
+		for (k = 0; k < kDecoherenceGridNumberOfRates; k++)
+		{
+			interpolateLogDensity(posterior->phases, newPhases, kDecoherenceGridNumberOfPhases, &posterior->logDensity[k], &newLogDensity[k], kDecoherenceGridNumberOfRates);
+		}
+		for (i = 0; i < kDecoherenceGridNumberOfPhases; i++)
+		{
+			posterior->phases[i] = newPhases[i];
+		}
+		for (i = 0; i < kDecoherenceGridNumberOfPhases * kDecoherenceGridNumberOfRates; i++)
+		{
+			posterior->logDensity[i] = newLogDensity[i];
+		}
+	}
+
+	if (zoomAxis(posterior->rates, kDecoherenceGridNumberOfRates, posterior->rateMeanValue, posterior->rateStandardDeviation, 0.0, maximumDecoherenceRate, newRates))
+	{
+		for (i = 0; i < kDecoherenceGridNumberOfPhases; i++)
+		{
+			interpolateLogDensity(posterior->rates, newRates, kDecoherenceGridNumberOfRates, &posterior->logDensity[i * kDecoherenceGridNumberOfRates], &newLogDensity[i * kDecoherenceGridNumberOfRates], 1);
+		}
+		for (k = 0; k < kDecoherenceGridNumberOfRates; k++)
+		{
+			posterior->rates[k] = newRates[k];
+		}
+		for (i = 0; i < kDecoherenceGridNumberOfPhases * kDecoherenceGridNumberOfRates; i++)
+		{
+			posterior->logDensity[i] = newLogDensity[i];
+		}
+	}
+}
+
+void
+initPhaseDecoherencePosterior(PhaseDecoherencePosterior *  posterior, double maximumDecoherenceRate)
+{
+	size_t	i;
+
+	for (i = 0; i < kDecoherenceGridNumberOfPhases; i++)
+	{
+		posterior->phases[i] = -M_PI + i * 2 * M_PI / kDecoherenceGridNumberOfPhases;
+	}
+	for (i = 0; i < kDecoherenceGridNumberOfRates; i++)
+	{
+		posterior->rates[i] = i * maximumDecoherenceRate / (kDecoherenceGridNumberOfRates - 1);
+	}
+	for (i = 0; i < kDecoherenceGridNumberOfPhases * kDecoherenceGridNumberOfRates; i++)
+	{
+		posterior->logDensity[i] = 0.0;
+	}
+
+	computePhaseDecoherenceMoments(posterior);
+}
+
+void
+updatePhaseDecoherencePosterior(PhaseDecoherencePosterior *  posterior, const uint64_t *  evidenceSampleCounts, double M, double theta, double maximumDecoherenceRate)
+{
+	double	visibility[kDecoherenceGridNumberOfRates];
+	double	count0 = (double) evidenceSampleCounts[0];
+	double	count1 = (double) evidenceSampleCounts[1];
+	size_t	i;
+	size_t	k;
+
+	/*
+	 *	The likelihood (1 + exp(-lambda M) cos(M (phi - theta))) / 2 separates
+	 *	into a cosine per phase and a visibility per rate, so the transcendental
+	 *	functions are evaluated once per axis point and the inner loop over
+	 *	rates is branch-free. Probabilities are clamped away from zero so that
+	 *	a zero count never multiplies log(0).
+	 */
+	for (k = 0; k < kDecoherenceGridNumberOfRates; k++)
+	{
+		visibility[k] = exp(-posterior->rates[k] * M);
+	}
+
+	for (i = 0; i < kDecoherenceGridNumberOfPhases; i++)
+	{
+		double		cosine = cos(M * (posterior->phases[i] - theta));
+		double *	row = &posterior->logDensity[i * kDecoherenceGridNumberOfRates];
+
+		for (k = 0; k < kDecoherenceGridNumberOfRates; k++)
+		{
+			double	p0 = fmax(0.5 * (1 + visibility[k] * cosine), DBL_MIN);
+			double	p1 = fmax(0.5 * (1 - visibility[k] * cosine), DBL_MIN);
+
+			row[k] += count0 * log(p0) + count1 * log(p1);
+		}
+	}
+
+	computePhaseDecoherenceMoments(posterior);
+	regridPhaseDecoherencePosterior(posterior, maximumDecoherenceRate);
+	computePhaseDecoherenceMoments(posterior);
+}
+
+bool
+runPhaseDecoherenceAQPEExperiment(PhaseDecoherenceExperiment *  experiment, const CommandLineArguments *  arguments, size_t experimentNo, PhaseDecoherencePosterior *  posterior, gsl_rng *  gslRNG)
+{
+	uint64_t	evidenceSampleCounts[2];
+	size_t		i;
+
+	initPhaseDecoherencePosterior(posterior, arguments->maximumDecoherenceRate);
+	*experiment = (PhaseDecoherenceExperiment) {
+		.experimentNo	= experimentNo,
+	};
+
+	if (arguments->verbose)
+	{
+		printf("\nStarting joint phase and decoherence AQPE Experiment #%zu:\n", experimentNo);
+		printf("----------------------------------------------------------\n");
+		printf("Iteration 0: Phi: %le +- %le,\tDecoherence rate: %le +- %le\n", posterior->phaseMeanValue, posterior->phaseStandardDeviation, posterior->rateMeanValue, posterior->rateStandardDeviation);
+	}
+
+	/*
+	 *	Loop over iterations
+	 */
+	for (i = 0; i < kMaxNumberOfIterations; i++)
+	{
+		double	currentM = calculateM(posterior->phaseStandardDeviation, arguments->alpha);
+		double	currentTheta;
+
+		/*
+		 *	The Fisher information M^2 exp(-2 lambda M) of a circuit peaks at M = 1 / lambda,
+		 *	so deeper circuits than that only lose visibility.
+		 */
+		if (posterior->rateMeanValue > 0.0)
+		{
+			currentM = fmin(currentM, 1 / posterior->rateMeanValue);
+		}
+
+		/*
+		 *	With reduced visibility, a circuit only carries information about phi
+		 *	away from the extrema of the fringe, so theta is offset from the mean
+		 *	by an eighth of a fringe period. With a fixed offset the outcome
+		 *	probability would only constrain a ridge in (phi, lambda), since a
+		 *	shift of phi and a change of visibility have the same effect, so the
+		 *	sign of the offset alternates, which flips the effect of phi but not
+		 *	that of lambda.
+		 */
+		currentTheta = posterior->phaseMeanValue + ((i % 2 == 0) ? -1.0 : 1.0) * M_PI / (4 * currentM);
+
+		runNoisyQPECircuit(arguments->targetPhi, arguments->decoherenceRate, currentM, currentTheta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+		accountCircuitMapping(&experiment->resources, currentM, arguments->numberOfEvidenceSamplesPerIteration);
+		updatePhaseDecoherencePosterior(posterior, evidenceSampleCounts, currentM, currentTheta, arguments->maximumDecoherenceRate);
+		experiment->numberOfIterations++;
+
+		if (arguments->verbose)
+		{
+			printf("\nIteration %zu: Phi: %le +- %le,\tDecoherence rate: %le +- %le\n", i + 1, posterior->phaseMeanValue, posterior->phaseStandardDeviation, posterior->rateMeanValue, posterior->rateStandardDeviation);
+		}
+
+		/*
+		 *	A posterior whose density vanished on the whole grid has NaN
+		 *	moments, and is not converged.
+		 */
+		if (isnan(posterior->phaseMeanValue) || isnan(posterior->phaseStandardDeviation))
+		{
+			break;
+		}
+
+		if (posterior->phaseStandardDeviation < arguments->precision)
+		{
+			experiment->converged = true;
+			break;
+		}
+	}
+
+	experiment->phaseMeanValue = posterior->phaseMeanValue;
+	experiment->phaseStandardDeviation = posterior->phaseStandardDeviation;
+	experiment->rateMeanValue = posterior->rateMeanValue;
+	experiment->rateStandardDeviation = posterior->rateStandardDeviation;
+
+	if (arguments->verbose)
+	{
+		if (experiment->converged)
+		{
+			printf("\nJoint phase and decoherence AQPE Experiment #%zu: Successfully acheieved precision in %zu iterative circuit mappings to quantum hardware!\n", experimentNo, experiment->numberOfIterations);
+		}
+		else
+		{
+			printf("\nJoint phase and decoherence AQPE Experiment #%zu: Could not converge within the maximum allowed number of %d iterative circuit mappings to quantum hardware!\n", experimentNo, kMaxNumberOfIterations);
+		}
+	}
+
+	return experiment->converged;
+}
+
+int
+runPhaseDecoherenceAQPE(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	PhaseDecoherencePosterior *	posterior;
+	PhaseDecoherenceExperiment	experiment;
+	QuantumResources *		experimentResources;
+	double				averageNumberOfTotalIterations = 0.0;
+	double				averageDistanceFromTarget = 0.0;
+	double				averageEstimatedDecoherenceRate = 0.0;
+	double				xSigmaValue = 4.0;
+	size_t				wrongConvergenceCount = 0;
+	size_t				convergenceCount = 0;
+	size_t				i;
+
+	posterior = (PhaseDecoherencePosterior *) malloc(sizeof(PhaseDecoherencePosterior));
+	experimentResources = (QuantumResources *) malloc(arguments->numberOfRepetitions * sizeof(QuantumResources));
+
+	/*
+	 *	Loop over AQPE experiments
+	 */
+	for (i = 0; i < arguments->numberOfRepetitions; i++)
+	{
+		if (runPhaseDecoherenceAQPEExperiment(&experiment, arguments, i + 1, posterior, gslRNG))
+		{
+			averageNumberOfTotalIterations += (double) experiment.numberOfIterations;
+			averageDistanceFromTarget += fabs(arguments->targetPhi - experiment.phaseMeanValue);
+			averageEstimatedDecoherenceRate += experiment.rateMeanValue;
+
+			if (fabs(arguments->targetPhi - experiment.phaseMeanValue) > xSigmaValue * arguments->precision)
+			{
+				wrongConvergenceCount++;
+			}
+
+			convergenceCount++;
+		}
+		experimentResources[i] = experiment.resources;
+	}
+
+	/*
+	 *	Report results across all experiments.
+	 */
+	if (convergenceCount == 0)
+	{
+		printf("\nConvergence failed for all %zu joint phase and decoherence AQPE experiments within the allowed maximum limit of %d iterative circuit mappings to quantum hardware!\n", arguments->numberOfRepetitions, kMaxNumberOfIterations);
+	}
+	else
+	{
+		printf("\nConvergence achieved on average in %lf iterative circuit mappings to quantum hardware in %zu of %zu joint phase and decoherence AQPE experiments and yielded an average phase estimation error of %le.\n", averageNumberOfTotalIterations / convergenceCount, convergenceCount, arguments->numberOfRepetitions, averageDistanceFromTarget / convergenceCount);
+		printf("\nIn %zu out of %zu converging experiments, the phase estimation error was greater than %d times the input precision %le.\n", wrongConvergenceCount, convergenceCount, (int) xSigmaValue, xSigmaValue * arguments->precision);
+		printf("\nThe average estimated decoherence rate was %le (simulated decoherence rate %le).\n", averageEstimatedDecoherenceRate / convergenceCount, arguments->decoherenceRate);
+	}
+
+	printQuantumResourcesSummary(experimentResources, arguments->numberOfRepetitions);
+
+	free(experimentResources);
+	free(posterior);
+
+	return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+#include "quantumResources.h"
+#include "utilities.h"
+
+typedef enum
+{
+	kDecoherenceGridNumberOfPhases = 256,
+	kDecoherenceGridNumberOfRates = 64,
+	kDecoherenceGridHalfWidthInStandardDeviations = 6,
+} DecoherenceGridConstants;
+
+/*
+ *	Joint posterior over the eigenphase phi and the decoherence rate lambda
+ *	on a grid of kDecoherenceGridNumberOfPhases x kDecoherenceGridNumberOfRates
+ *	points, stored as unnormalized log-density with the rate varying fastest.
+ *	Both axes zoom in on the posterior as it narrows, and the regridding
+ *	interpolates into nextLogDensity. The standard deviations are at least
+ *	the spacing of their axis, which is all the grid resolves.
+ */
+typedef struct PhaseDecoherencePosterior
+{
+	double	phases[kDecoherenceGridNumberOfPhases];
+	double	rates[kDecoherenceGridNumberOfRates];
+	double	logDensity[kDecoherenceGridNumberOfPhases * kDecoherenceGridNumberOfRates];
+	double	nextLogDensity[kDecoherenceGridNumberOfPhases * kDecoherenceGridNumberOfRates];
+	double	phaseMeanValue;
+	double	phaseStandardDeviation;
+	double	rateMeanValue;
+	double	rateStandardDeviation;
+} PhaseDecoherencePosterior;
+
+typedef struct PhaseDecoherenceExperiment
+{
+	size_t			experimentNo;
+	double			phaseMeanValue;
+	double			phaseStandardDeviation;
+	double			rateMeanValue;
+	double			rateStandardDeviation;
+	size_t			numberOfIterations;
+	bool			converged;
+	QuantumResources	resources;
+} PhaseDecoherenceExperiment;
+
+/**
+ *	@brief	Initialize the joint posterior to a uniform prior over [-pi, pi) x [0, maximumDecoherenceRate].
+ *
+ *	@param	posterior		: posterior to initialize
+ *	@param	maximumDecoherenceRate	: upper end of the decoherence rate axis
+ */
+void	initPhaseDecoherencePosterior(PhaseDecoherencePosterior *  posterior, double maximumDecoherenceRate);
+
+/**
+ *	@brief	Update the joint posterior with the evidence of one circuit.
+ *
+ *	@param	posterior		: posterior to update
+ *	@param	evidenceSampleCounts	: counts of outcomes 0 and 1
+ *	@param	M			: number of applications of the unitary
+ *	@param	theta			: phase shift of the circuit
+ *	@param	maximumDecoherenceRate	: upper end of the decoherence rate axis
+ */
+void	updatePhaseDecoherencePosterior(PhaseDecoherencePosterior *  posterior, const uint64_t *  evidenceSampleCounts, double M, double theta, double maximumDecoherenceRate);
+
+/**
+ *	@brief	Run one AQPE experiment estimating the eigenphase jointly with the decoherence rate.
+ *
+ *	@param	experiment	: output experiment
+ *	@param	arguments	: command line arguments
+ *	@param	experimentNo	: experiment number used in verbose output
+ *	@param	posterior	: workspace for the joint posterior
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	bool		: true if the eigenphase achieved the precision
+ */
+bool	runPhaseDecoherenceAQPEExperiment(PhaseDecoherenceExperiment *  experiment, const CommandLineArguments *  arguments, size_t experimentNo, PhaseDecoherencePosterior *  posterior, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Run -r joint phase and decoherence AQPE experiments and report the results across experiments.
+ *
+ *	@param	arguments	: command line arguments
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runPhaseDecoherenceAQPE(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
@@ -0,0 +1,125 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <math.h>
+
+/*
+ *	Double-double numbers hold a value as the unevaluated sum hi + lo of two
+ *	doubles with |lo| <= ulp(hi) / 2, which carries about 106 bits. The
+ *	operations below are branch-free sequences of double operations and
+ *	fma(), so that loops over arrays of them vectorize.
+ */
+typedef struct DoubleDouble
+{
+	double	hi;
+	double	lo;
+} DoubleDouble;
+
+/*
+ *	2 pi as a double-double.
+ */
+static const DoubleDouble	kTwoPiDoubleDouble = {6.283185307179586232e+00, 2.449293598294706414e-16};
+
+/*
+ *	a + b exactly, for |a| >= |b|.
+ */
+static inline DoubleDouble
+quickTwoSum(double a, double b)
+{
+	double	sum = a + b;
+
+	return (DoubleDouble) {sum, b - (sum - a)};
+}
+
+/*
+ *	a + b exactly.
+ */
+static inline DoubleDouble
+twoSum(double a, double b)
+{
+	double	sum = a + b;
+	double	bVirtual = sum - a;
+
+	return (DoubleDouble) {sum, (a - (sum - bVirtual)) + (b - bVirtual)};
+}
+
+/*
+ *	a * b exactly.
+ */
+static inline DoubleDouble
+twoProduct(double a, double b)
+{
+	double	product = a * b;
+
+	return (DoubleDouble) {product, fma(a, b, -product)};
+}
+
+/*
+ *	a * b for a double a and a double-double b.
+ */
+static inline DoubleDouble
+multiplyDoubleDouble(double a, DoubleDouble b)
+{
+	DoubleDouble	product = twoProduct(a, b.hi);
+
+	return quickTwoSum(product.hi, product.lo + a * b.lo);
+}
+
+/*
+ *	x - 2 pi k for the k that brings x into [-pi, pi].
+ */
+static inline DoubleDouble
+reducePhaseDoubleDouble(DoubleDouble x)
+{
+	double		k = nearbyint(x.hi / kTwoPiDoubleDouble.hi);
+	DoubleDouble	multiple = twoProduct(k, kTwoPiDoubleDouble.hi);
+	DoubleDouble	difference = twoSum(x.hi, -multiple.hi);
+
+	return quickTwoSum(difference.hi, difference.lo + x.lo - multiple.lo - k * kTwoPiDoubleDouble.lo);
+}
+
+/*
+ *	sin and cos of a reduced double-double phase, to first order in lo.
+ */
+static inline void
+sinCosDoubleDouble(DoubleDouble x, double *  sine, double *  cosine)
+{
+	double	sineOfHi = sin(x.hi);
+	double	cosineOfHi = cos(x.hi);
+
+	*sine = sineOfHi + cosineOfHi * x.lo;
+	*cosine = cosineOfHi - sineOfHi * x.lo;
+}
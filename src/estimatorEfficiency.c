@@ -0,0 +1,151 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "estimatorEfficiency.h"
+#include "quantumResources.h"
+
+double
+circuitFisherInformation(uint64_t numberOfShots, double M, double theta, double phi, double visibility)
+{
+	double	x = M * (phi - theta);
+	double	cosine = visibility * cos(x);
+	double	sine = visibility * sin(x);
+
+	/*
+	 *	For P(0) = (1 + v cos(M (phi - theta))) / 2, the information of one shot is
+	 *	P'(0)^2 / (P(0) P(1)) = M^2 v^2 sin^2(x) / (1 - v^2 cos^2(x)), which is M^2
+	 *	at any theta for v = 1, including its limit at x = 0.
+	 */
+	if (visibility >= 1.0)
+	{
+		return numberOfShots * M * M;
+	}
+
+	return numberOfShots * M * M * sine * sine / (1 - cosine * cosine);
+}
+
+void
+initEstimatorEfficiency(EstimatorEfficiency *  efficiency, double initialStandardDeviation)
+{
+	*efficiency = (EstimatorEfficiency) {
+		.fisherInformation	= 1 / (initialStandardDeviation * initialStandardDeviation),
+		.posteriorVariance	= initialStandardDeviation * initialStandardDeviation,
+	};
+}
+
+double
+accountCircuitInformation(EstimatorEfficiency *  efficiency, uint64_t numberOfShots, double M, double theta, double priorMeanValue, double visibility, double posteriorStandardDeviation)
+{
+	double	information = circuitFisherInformation(numberOfShots, M, theta, priorMeanValue, visibility);
+	double	iterationEfficiency;
+
+	/*
+	 *	The design efficiency compares the information with that of the best
+	 *	theta for the same M, which puts the mean on a slope of the fringe.
+	 */
+	efficiency->designEfficiencySum += information / (numberOfShots * M * M * visibility * visibility);
+	efficiency->fisherInformation += information;
+	efficiency->posteriorVariance = posteriorStandardDeviation * posteriorStandardDeviation;
+
+	iterationEfficiency = 1 / (efficiency->fisherInformation * efficiency->posteriorVariance);
+	efficiency->efficiencySum += iterationEfficiency;
+	efficiency->numberOfCircuits++;
+
+	return iterationEfficiency;
+}
+
+void
+printEstimatorEfficiencySummary(const EstimatorEfficiency *  efficiencies, const double *  squaredErrors, size_t numberOfExperiments)
+{
+	double *	values;
+	double		meanSquaredError = 0.0;
+	double		meanCramerRaoBound = 0.0;
+	size_t		i;
+
+	if (numberOfExperiments == 0)
+	{
+		return;
+	}
+
+	values = (double *) malloc(numberOfExperiments * sizeof(double));
+
+	printf("\nEstimator efficiency per AQPE experiment across %zu experiments:\n", numberOfExperiments);
+	printf("%-36s %12s %12s %12s %12s %12s %12s\n", "", "mean", "min", "25%", "median", "75%", "max");
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = 1 / sqrt(efficiencies[i].fisherInformation);
+	}
+	printDistribution("Cramer-Rao bound on std", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = sqrt(efficiencies[i].posteriorVariance);
+	}
+	printDistribution("Posterior std", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = 1 / (efficiencies[i].fisherInformation * efficiencies[i].posteriorVariance);
+	}
+	printDistribution("Final efficiency", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = (efficiencies[i].numberOfCircuits > 0) ? efficiencies[i].efficiencySum / efficiencies[i].numberOfCircuits : 1.0;
+	}
+	printDistribution("Mean efficiency over iterations", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = (efficiencies[i].numberOfCircuits > 0) ? efficiencies[i].designEfficiencySum / efficiencies[i].numberOfCircuits : 1.0;
+	}
+	printDistribution("Mean theta design efficiency", values, numberOfExperiments);
+
+	/*
+	 *	The Bayesian Cramer-Rao bound applies to the mean squared error over
+	 *	experiments, so the two are also compared directly.
+	 */
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		meanSquaredError += squaredErrors[i] / numberOfExperiments;
+		meanCramerRaoBound += 1 / (efficiencies[i].fisherInformation * numberOfExperiments);
+	}
+
+	printf("\nThe mean squared phase estimation error was %le against a mean Cramer-Rao bound of %le, an efficiency of %lf.\n", meanSquaredError, meanCramerRaoBound, meanCramerRaoBound / meanSquaredError);
+
+	free(values);
+}
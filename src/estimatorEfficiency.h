@@ -0,0 +1,95 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+/*
+ *	Information accounting of one AQPE experiment. The Fisher information
+ *	includes that of the Gaussian prior, so its inverse is the Bayesian
+ *	Cramer-Rao bound on the variance of any estimator after the circuits so far.
+ */
+typedef struct EstimatorEfficiency
+{
+	double	fisherInformation;
+	double	posteriorVariance;
+	double	efficiencySum;
+	double	designEfficiencySum;
+	size_t	numberOfCircuits;
+} EstimatorEfficiency;
+
+/**
+ *	@brief	Fisher information about phi of the outcomes of a QPE circuit.
+ *
+ *	@param	numberOfShots	: number of measurements of the circuit
+ *	@param	M		: number of applications of the unitary in the circuit
+ *	@param	theta		: phase shift of the circuit
+ *	@param	phi		: phase at which to evaluate the information
+ *	@param	visibility	: visibility of the fringe, 1 for a noiseless circuit
+ *	@return	double		: Fisher information
+ */
+double	circuitFisherInformation(uint64_t numberOfShots, double M, double theta, double phi, double visibility);
+
+/**
+ *	@brief	Start the information accounting of an experiment from its Gaussian prior.
+ *
+ *	@param	efficiency			: accounting of the current experiment
+ *	@param	initialStandardDeviation	: standard deviation of the prior
+ */
+void	initEstimatorEfficiency(EstimatorEfficiency *  efficiency, double initialStandardDeviation);
+
+/**
+ *	@brief	Account for the information of one circuit and the posterior it led to.
+ *
+ *	@param	efficiency			: accounting of the current experiment
+ *	@param	numberOfShots			: number of measurements of the circuit
+ *	@param	M				: number of applications of the unitary in the circuit
+ *	@param	theta				: phase shift of the circuit
+ *	@param	priorMeanValue			: mean value of the posterior before the circuit
+ *	@param	visibility			: visibility of the fringe
+ *	@param	posteriorStandardDeviation	: standard deviation of the posterior after the circuit
+ *	@return	double				: efficiency, the Cramer-Rao bound over the posterior variance
+ */
+double	accountCircuitInformation(EstimatorEfficiency *  efficiency, uint64_t numberOfShots, double M, double theta, double priorMeanValue, double visibility, double posteriorStandardDeviation);
+
+/**
+ *	@brief	Print the distribution of estimator efficiencies across experiments.
+ *
+ *	@param	efficiencies		: accounting of each experiment
+ *	@param	squaredErrors		: squared phase estimation error of each experiment
+ *	@param	numberOfExperiments	: number of experiments
+ */
+void	printEstimatorEfficiencySummary(const EstimatorEfficiency *  efficiencies, const double *  squaredErrors, size_t numberOfExperiments);
@@ -0,0 +1,337 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <execinfo.h>
+#include <sys/ioctl.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/filter.h>
+#include <linux/seccomp.h>
+#include "aqpe.h"
+#include "instrumentation.h"
+
+_Atomic int	instrumentationPhase = kInstrumentationPhaseOutside;
+
+static const char *	kInstrumentationPhaseNames[kInstrumentationNumberOfPhases] = {
+	[kInstrumentationPhaseOutside]		= "outside the iterations",
+	[kInstrumentationPhaseExperimentSetup]	= "experiment setup",
+	[kInstrumentationPhaseSchedule]		= "schedule of M and theta",
+	[kInstrumentationPhasePrecompute]	= "precomputation",
+	[kInstrumentationPhaseCircuit]		= "circuit",
+	[kInstrumentationPhaseUpdate]		= "posterior update",
+	[kInstrumentationPhaseBookkeeping]	= "bookkeeping",
+};
+
+/*
+ *	The counters are only written while the check tracks. The guard keeps
+ *	backtrace(), which may allocate, from counting itself, and is per
+ *	thread, since the allocator hooks run on every thread of the process.
+ */
+static atomic_bool		isTracking;
+static _Thread_local bool	isInsideTracker;
+static atomic_uint_fast64_t	allocationCounts[kInstrumentationNumberOfPhases];
+static atomic_uint_fast64_t	freeCounts[kInstrumentationNumberOfPhases];
+static atomic_uint_fast64_t	syscallCounts[kInstrumentationNumberOfPhases];
+static long			syscallNumbers[kInstrumentationNumberOfPhases][kInstrumentationMaximumNumberOfSyscallNumbers];
+static size_t			numberOfSyscallNumbers[kInstrumentationNumberOfPhases];
+static void *			backtraceFrames[kInstrumentationMaximumNumberOfBacktraces][kInstrumentationBacktraceDepth];
+static int			backtraceDepths[kInstrumentationMaximumNumberOfBacktraces];
+static InstrumentationPhase	backtracePhases[kInstrumentationMaximumNumberOfBacktraces];
+static atomic_size_t		numberOfBacktraces;
+static atomic_int		listenerFileDescriptor = -1;
+
+void
+recordHeapOperation(bool isFree)
+{
+	InstrumentationPhase	phase;
+	size_t			slot;
+
+	if (!atomic_load_explicit(&isTracking, memory_order_relaxed) || isInsideTracker)
+	{
+		return;
+	}
+
+	isInsideTracker = true;
+	phase = (InstrumentationPhase) atomic_load_explicit(&instrumentationPhase, memory_order_relaxed);
+	atomic_fetch_add_explicit(isFree ? &freeCounts[phase] : &allocationCounts[phase], 1, memory_order_relaxed);
+	if ((phase != kInstrumentationPhaseOutside) && ((slot = atomic_fetch_add(&numberOfBacktraces, 1)) < kInstrumentationMaximumNumberOfBacktraces))
+	{
+		backtraceDepths[slot] = backtrace(backtraceFrames[slot], kInstrumentationBacktraceDepth);
+		backtracePhases[slot] = phase;
+	}
+	isInsideTracker = false;
+}
+
+/*
+ *	Receive the system calls of the checked thread from its seccomp filter,
+ *	count them by phase, and let the kernel carry them out unchanged. This
+ *	thread is created before the filter is installed, so its own system
+ *	calls are not filtered.
+ */
+static void *
+superviseSyscalls(void *  unused)
+{
+	const struct timespec	pollInterval = {.tv_sec = 0, .tv_nsec = 1000000};
+	int			fileDescriptor;
+
+	while ((fileDescriptor = atomic_load(&listenerFileDescriptor)) < 0)
+	{
+		nanosleep(&pollInterval, NULL);
+	}
+
+	for (;;)
+	{
+		struct seccomp_notif		request;
+		struct seccomp_notif_resp	response;
+
+		memset(&request, 0, sizeof(request));
+		if (ioctl(fileDescriptor, SECCOMP_IOCTL_NOTIF_RECV, &request) != 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			return NULL;
+		}
+
+		if (atomic_load_explicit(&isTracking, memory_order_relaxed))
+		{
+			InstrumentationPhase	phase = (InstrumentationPhase) atomic_load_explicit(&instrumentationPhase, memory_order_relaxed);
+			size_t			i;
+
+			atomic_fetch_add_explicit(&syscallCounts[phase], 1, memory_order_relaxed);
+			for (i = 0; (i < numberOfSyscallNumbers[phase]) && (syscallNumbers[phase][i] != request.data.nr); i++);
+			if ((i == numberOfSyscallNumbers[phase]) && (i < kInstrumentationMaximumNumberOfSyscallNumbers))
+			{
+				syscallNumbers[phase][i] = request.data.nr;
+				numberOfSyscallNumbers[phase]++;
+			}
+		}
+
+		memset(&response, 0, sizeof(response));
+		response.id = request.id;
+		response.flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE;
+		ioctl(fileDescriptor, SECCOMP_IOCTL_NOTIF_SEND, &response);
+	}
+}
+
+/*
+ *	Route every system call of the calling thread to superviseSyscalls(). A
+ *	seccomp filter cannot be removed, so the check exits after it is done.
+ *	Installing the filter needs no privilege after PR_SET_NO_NEW_PRIVS, but
+ *	needs Linux 5.5 or newer.
+ */
+static int
+startSyscallCounting(void)
+{
+	struct sock_filter	filter[] = {
+		BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_USER_NOTIF),
+	};
+	struct sock_fprog	program = {
+		.len	= sizeof(filter) / sizeof(filter[0]),
+		.filter	= filter,
+	};
+	pthread_t		supervisor;
+	int			fileDescriptor;
+
+	if (pthread_create(&supervisor, NULL, superviseSyscalls, NULL) != 0)
+	{
+		return 1;
+	}
+	pthread_detach(supervisor);
+
+	if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) != 0)
+	{
+		return 1;
+	}
+
+	fileDescriptor = (int) syscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, SECCOMP_FILTER_FLAG_NEW_LISTENER, &program);
+	if (fileDescriptor < 0)
+	{
+		return 1;
+	}
+	atomic_store(&listenerFileDescriptor, fileDescriptor);
+
+	return 0;
+}
+
+int
+runSteadyStateCheck(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	CommandLineArguments	checkArguments = *arguments;
+	AQPEWorkspace *		workspace;
+	AQPEExperiment		experiment;
+	ResultStream		resultStream;
+	bool			resultStreamOpen = false;
+	ShotRecordFile		shotRecordFile;
+	bool			shotRecordFileOpen = false;
+	void *			warmUpFrame;
+	bool			isCountingSyscalls;
+	uint64_t		numberOfAllocations = 0;
+	uint64_t		numberOfSyscalls = 0;
+	size_t			phase;
+	size_t			i;
+
+	checkArguments.verbose = false;
+
+	/*
+	 *	The result stream and the shot record file are attached as in the
+	 *	single-threaded path of the application, so that their writes on
+	 *	the update path are counted as well.
+	 */
+	if (checkArguments.resultStreamName != NULL)
+	{
+		if (createResultStream(&resultStream, checkArguments.resultStreamName, 1))
+		{
+			return 1;
+		}
+		resultStreamOpen = true;
+	}
+
+	if (checkArguments.shotRecordPath != NULL)
+	{
+		if (openShotRecordFile(&shotRecordFile, checkArguments.shotRecordPath))
+		{
+			if (resultStreamOpen)
+			{
+				closeResultStream(&resultStream);
+			}
+
+			return 1;
+		}
+		shotRecordFileOpen = true;
+	}
+
+	/*
+	 *	The first call of backtrace() loads the unwinder, which allocates.
+	 */
+	backtrace(&warmUpFrame, 1);
+
+	isCountingSyscalls = (startSyscallCounting() == 0);
+	if (!isCountingSyscalls)
+	{
+		fprintf(stderr, "\nWarning: Could not install a seccomp filter with a user notification listener: %s. Counting allocations only.\n", strerror(errno));
+	}
+
+	/*
+	 *	The first experiment warms up the workspace and the engine, and the
+	 *	experiments after it are the steady state.
+	 */
+	workspace = allocAQPEWorkspace(&checkArguments);
+	workspace->shotRecordFile = shotRecordFileOpen ? &shotRecordFile : NULL;
+	for (i = 0; i < checkArguments.numberOfRepetitions; i++)
+	{
+		if (i == 1)
+		{
+			atomic_store(&isTracking, true);
+		}
+
+		enterInstrumentationPhase(kInstrumentationPhaseExperimentSetup);
+		initAQPEExperiment(&experiment, kInitialPriorMeanValue, kInitialPriorStandardDeviation, i + 1, &checkArguments);
+		stepAQPEExperiment(&experiment, &checkArguments, kMaxNumberOfIterations, workspace, gslRNG, resultStreamOpen ? &resultStream.writers[0] : NULL);
+		enterInstrumentationPhase(kInstrumentationPhaseOutside);
+	}
+	atomic_store(&isTracking, false);
+	freeAQPEWorkspace(workspace);
+
+	if (resultStreamOpen)
+	{
+		closeResultStream(&resultStream);
+	}
+
+	if (shotRecordFileOpen)
+	{
+		closeShotRecordFile(&shotRecordFile);
+	}
+
+	printf("\nHeap allocations and system calls of %zu experiments after the first one:\n", checkArguments.numberOfRepetitions - 1);
+	printf("%-28s %16s %16s %16s   %s\n", "", "allocations", "frees", "system calls", "system call numbers");
+	for (phase = kInstrumentationPhaseExperimentSetup; phase < kInstrumentationNumberOfPhases; phase++)
+	{
+		uint64_t	numberOfPhaseAllocations = atomic_load(&allocationCounts[phase]) + atomic_load(&freeCounts[phase]);
+
+		numberOfAllocations += numberOfPhaseAllocations;
+		numberOfSyscalls += atomic_load(&syscallCounts[phase]);
+
+		printf("%-28s %16"PRIuFAST64" %16"PRIuFAST64" ", kInstrumentationPhaseNames[phase], atomic_load(&allocationCounts[phase]), atomic_load(&freeCounts[phase]));
+		if (isCountingSyscalls)
+		{
+			printf("%16"PRIuFAST64"  ", atomic_load(&syscallCounts[phase]));
+			for (i = 0; i < numberOfSyscallNumbers[phase]; i++)
+			{
+				printf(" %ld", syscallNumbers[phase][i]);
+			}
+			printf("\n");
+		}
+		else
+		{
+			printf("%16s\n", "-");
+		}
+	}
+
+	/*
+	 *	The frames are printed without symbol names unless the program is
+	 *	linked with -rdynamic. addr2line -f -e <program> <offset> resolves
+	 *	them either way.
+	 */
+	for (i = 0; (i < atomic_load(&numberOfBacktraces)) && (i < kInstrumentationMaximumNumberOfBacktraces); i++)
+	{
+		printf("\nBacktrace of steady-state heap operation %zu, in the %s:\n", i + 1, kInstrumentationPhaseNames[backtracePhases[i]]);
+		fflush(stdout);
+		backtrace_symbols_fd(backtraceFrames[i], backtraceDepths[i], STDOUT_FILENO);
+	}
+
+	if ((numberOfAllocations > 0) || (numberOfSyscalls > 0))
+	{
+		printf("\nSteady-state check failed: the iterations after the first experiment made %"PRIu64" heap operations and %"PRIu64" system calls.\n", numberOfAllocations, numberOfSyscalls);
+
+		return 1;
+	}
+
+	printf("\nSteady-state check passed: the iterations after the first experiment made no heap operations%s.\n", isCountingSyscalls ? " and no system calls" : "");
+
+	return 0;
+}
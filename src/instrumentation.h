@@ -0,0 +1,93 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <gsl/gsl_rng.h>
+#include "utilities.h"
+
+/*
+ *	Phases of an AQPE iteration, to which the allocations and system calls of
+ *	--check-steady-state are attributed.
+ */
+typedef enum
+{
+	kInstrumentationPhaseOutside = 0,
+	kInstrumentationPhaseExperimentSetup,
+	kInstrumentationPhaseSchedule,
+	kInstrumentationPhasePrecompute,
+	kInstrumentationPhaseCircuit,
+	kInstrumentationPhaseUpdate,
+	kInstrumentationPhaseBookkeeping,
+	kInstrumentationNumberOfPhases,
+} InstrumentationPhase;
+
+typedef enum
+{
+	kInstrumentationMaximumNumberOfBacktraces = 8,
+	kInstrumentationBacktraceDepth = 32,
+	kInstrumentationMaximumNumberOfSyscallNumbers = 8,
+} InstrumentationConstants;
+
+extern _Atomic int	instrumentationPhase;
+
+/**
+ *	@brief	Mark the phase of the iteration that the calling thread enters. This is a single relaxed store, so it stays on the update path in all modes.
+ *
+ *	@param	phase	: phase that the following allocations and system calls belong to
+ */
+static inline void
+enterInstrumentationPhase(InstrumentationPhase phase)
+{
+	atomic_store_explicit(&instrumentationPhase, (int) phase, memory_order_relaxed);
+}
+
+/**
+ *	@brief	Count a heap operation against the current phase while the steady-state check tracks, and keep a backtrace of the first ones. Called by the allocator hooks of allocationHooks.c, which only the application links.
+ *
+ *	@param	isFree	: true for free(), false for an allocation
+ */
+void	recordHeapOperation(bool isFree);
+
+/**
+ *	@brief	Run -r experiments on one workspace, and count the heap allocations and system calls of each phase of the iterations after the first experiment. Print a backtrace of the first allocations.
+ *
+ *	@param	arguments	: command line arguments
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if the experiments after the first one neither allocated nor made system calls, else 1
+ */
+int	runSteadyStateCheck(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
@@ -36,311 +36,389 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <gsl/gsl_randist.h>
-#include <sys/time.h>
+#include <time.h>
+#include <gsl/gsl_rng.h>
+#include "amplitudeEstimation.h"
+#include "aqpe.h"
+#include "benchmarks.h"
+#include "convergenceCurves.h"
+#include "costPredictor.h"
+#include "decoherence.h"
+#include "estimatorEfficiency.h"
+#include "instrumentation.h"
+#include "mixture.h"
+#include "quantumResources.h"
+#include "realTime.h"
+#include "resultLog.h"
+#include "resultStream.h"
+#include "scheduler.h"
+#include "shotRecord.h"
 #include "utilities.h"
 
-void	initRNG(gsl_rng *  gslRNG);
-double	calculateM(double standardDeviation, double alpha);
-double	calculateTheta(double meanValue, double standardDeviation);
-void	sampleFromRestrictedGaussian(double mu, double sigma, double *  samples, size_t  numberOfSamples, gsl_rng *  gslRNG);
-void	runQPECircuit(double phi, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG);
-void	doRFPE(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
-
-typedef enum
-{
-	kMaxNumberOfIterations = 100,
-	kPosteriorStandardDeviationIncreaseFactor = 1,
-} Constants;
-
-double	currentM;
-double	currentTheta;
-
-void
-initRNG(gsl_rng *  gslRNG)
+int
+main(int argc, char *  argv[])
 {
-	unsigned long	randomSeed = 0;
+	CommandLineArguments	arguments;
+	AQPEExperiment *	experiments;
+	QuantumResources *	experimentResources;
+	EstimatorEfficiency *	experimentEfficiencies;
+	double *		squaredErrors;
+	SchedulerStatistics	schedulerStatistics;
+	ResultStream		resultStream;
+	bool			resultStreamOpen = false;
+	ConvergenceCurves *	convergenceCurves = NULL;
+	ShotRecordFile		shotRecordFile;
+	bool			shotRecordFileOpen = false;
+	AQPEWorkspace *		workspace;
+	double			averageNumberOfTotalIterations = 0.0;
+	double			averageDistanceFromTarget = 0.0;
+	size_t			wrongConvergenceCount = 0;
+	size_t			convergenceCount = 0;
+	size_t			abortCounts[kAQPENumberOfAbortReasons] = {0};
+	size_t			abortedIterationCount = 0;
+	double			xSigmaValue = 4.0;
+	size_t			i;
+	gsl_rng *		gslRNG;
+	unsigned long		randomSeed;
 
-	if (randomSeed == 0)
+	/*
+	 *	Get command line arguments.
+	 */
+	initCommandLineArguments(&arguments);
+	if (getCommandLineArguments(argc, argv, &arguments))
 	{
-		/*
-		 *	Set random seed from time of day.
-		 */
-		struct timeval	tv;
-		gettimeofday(&tv, 0);
-		randomSeed = ((tv.tv_sec>>10) ^ (tv.tv_usec<<10)) + 1;
+		return 1;
 	}
-	fprintf(stderr, "Setting random seed to %lu.\n", randomSeed);
-	gsl_rng_set(gslRNG, randomSeed);
-}
 
-double
-calculateM(double standardDeviation, double alpha)
-{
-	if (standardDeviation == 0.0)
+	/*
+	 *	Predict the cost of the requested configuration from the cost table without simulating.
+	 */
+	if (arguments.costTableQueryPath != NULL)
 	{
-		return 1.0;
+		CostTable	costTable;
+		CostPrediction	prediction;
+		struct timespec	startTime;
+		struct timespec	endTime;
+
+		if (loadCostTable(arguments.costTableQueryPath, &costTable))
+		{
+			return 1;
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &startTime);
+		prediction = predictCost(&costTable, arguments.precision, arguments.alpha, arguments.numberOfEvidenceSamplesPerIteration, arguments.numberOfPriorTestSamplesPerIteration);
+		clock_gettime(CLOCK_MONOTONIC, &endTime);
+
+		printf("\nPredicted number of iterations per AQPE experiment = %lf\n", prediction.expectedNumberOfIterations);
+		printf("Predicted convergence probability = %lf\n", prediction.convergenceProbability);
+		printf("Predicted CPU time per AQPE experiment = %le s\n", prediction.cpuTimePerExperiment);
+		printf("Predicted CPU time for %zu AQPE experiments = %le s\n", arguments.numberOfRepetitions, prediction.cpuTimePerExperiment * arguments.numberOfRepetitions);
+		printf("\nPrediction computed in %.3lf microseconds.\n", (endTime.tv_sec - startTime.tv_sec) * 1e6 + (endTime.tv_nsec - startTime.tv_nsec) * 1e-3);
+
+		freeCostTable(&costTable);
+
+		return 0;
 	}
-	else
+
+	/*
+	 *	Allocate a default GSL random number generator and intialize the RNG.
+	 */
+	gslRNG = gsl_rng_alloc(gsl_rng_default);
+	randomSeed = initRNG(gslRNG);
+
+	/*
+	 *	Regenerate the cost table by simulating its grid.
+	 */
+	if (arguments.costTableRefreshPath != NULL)
 	{
-		return 1 / pow(standardDeviation, alpha);
-	}
-}
+		int	status = refreshCostTable(arguments.costTableRefreshPath, arguments.targetPhi, arguments.numberOfRepetitions, arguments.numberOfThreads, gslRNG);
 
-double
-calculateTheta(double meanValue, double standardDeviation)
-{
-	return meanValue - standardDeviation;
-}
+		gsl_rng_free(gslRNG);
 
-void
-sampleFromRestrictedGaussian(double mu, double sigma, double *  samples, size_t  numberOfSamples, gsl_rng *  gslRNG)
-{
-	double	gaussianSample;
-	size_t	numberOfValidSamples = 0;
+		return status;
+	}
 
-	while (numberOfValidSamples < numberOfSamples)
+	/*
+	 *	Estimate an amplitude instead of an eigenphase.
+	 */
+	if (arguments.estimateAmplitude && !arguments.benchmarkAmplitude)
 	{
-		gaussianSample = gsl_ran_gaussian(gslRNG, sigma) + mu;
+		int	status = runAmplitudeEstimation(&arguments, gslRNG);
 
-		if (fabs(gaussianSample) < M_PI)
-		{
-			samples[numberOfValidSamples] = gaussianSample;
-			numberOfValidSamples++;
-		}
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
 
-	return;
-}
+	/*
+	 *	Estimate all eigenphases of a mixed input state jointly.
+	 */
+	if (arguments.numberOfMixturePhases > 0)
+	{
+		int	status = runMixtureAQPE(&arguments, gslRNG);
 
-void
-runQPECircuit(double phi, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
-{
-	double		probabilityEvidence0GivenPhiPrior;
-	double		uniformSample;
-	uint64_t	i;
+		gsl_rng_free(gslRNG);
 
-	probabilityEvidence0GivenPhiPrior = (1 + cos(currentM * (phi - currentTheta))) / 2;
-	evidenceSampleCounts[0] = 0;
+		return status;
+	}
 
-	for (i = 0; i < numberOfEvidenceSamples; i++)
+	/*
+	 *	Estimate the eigenphase jointly with the decoherence rate.
+	 */
+	if (arguments.estimateDecoherence)
 	{
-		uniformSample = gsl_ran_flat(gslRNG, 0.0, 1.0);
-		if (uniformSample < probabilityEvidence0GivenPhiPrior)
-		{
-			evidenceSampleCounts[0]++;
-		}
+		int	status = runPhaseDecoherenceAQPE(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
-	evidenceSampleCounts[1] = numberOfEvidenceSamples - evidenceSampleCounts[0];
 
-	return;
-}
+	/*
+	 *	Benchmark the estimator paths against each other.
+	 */
+	if (arguments.benchmarkPipelines)
+	{
+		int	status = runPipelineBenchmark(&arguments, gslRNG);
 
-void
-doRFPE(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
-{
-	double		evidenceProbabilityGivenPriorSamples[numberOfPriorSamples];
-	double		logEvidenceProbabilityGivenPriorSamples[numberOfPriorSamples];
-	double		evidenceZeroProbabilityGivenPriorSamples[numberOfPriorSamples];
-	double		maxOfLogEvidenceProbability;
-	double		uniformSample;
-	double		currentStandardDeviation = *standardDeviation;
-	size_t		numberOfAcceptedPriorSamples = 0;
-	size_t		i;
-	
-	for (i = 0; i < numberOfPriorSamples; i++)
+		gsl_rng_free(gslRNG);
+
+		return status;
+	}
+
+	/*
+	 *	Benchmark the specialized RFPE kernels.
+	 */
+	if (arguments.benchmarkKernels)
 	{
-		evidenceZeroProbabilityGivenPriorSamples[i] = (1 + cos(currentM * (priorSamples[i] - currentTheta))) / 2;
-		logEvidenceProbabilityGivenPriorSamples[i] = 0.0;
+		int	status = runRFPEKernelBenchmark(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
-	
-	for (size_t k = 0; k < 2; k++)
+
+	/*
+	 *	Check that the iterations neither allocate nor make system calls
+	 *	after the first experiment.
+	 */
+	if (arguments.checkSteadyState)
 	{
-		maxOfLogEvidenceProbability = -INFINITY;
-		
-		for (i = 0; i < numberOfPriorSamples; i++)
-		{
-			if (k == 0)
-			{
-				logEvidenceProbabilityGivenPriorSamples[i] += log(evidenceZeroProbabilityGivenPriorSamples[i]) * evidenceSampleCounts[k];
-			}
-			else
-			{
-				logEvidenceProbabilityGivenPriorSamples[i] += log(1 - evidenceZeroProbabilityGivenPriorSamples[i]) * evidenceSampleCounts[k];
-			}
+		int	status = runSteadyStateCheck(&arguments, gslRNG);
 
-			if (logEvidenceProbabilityGivenPriorSamples[i] > maxOfLogEvidenceProbability)
-			{
-				maxOfLogEvidenceProbability = logEvidenceProbabilityGivenPriorSamples[i];
-			}
-		}
+		gsl_rng_free(gslRNG);
 
-		for (i = 0; i < numberOfPriorSamples; i++)
-		{
-			logEvidenceProbabilityGivenPriorSamples[i] -= maxOfLogEvidenceProbability;
-		}
+		return status;
 	}
 
-	for (i = 0; i < numberOfPriorSamples; i++)
+	/*
+	 *	Benchmark Bayesian against maximum likelihood amplitude estimation.
+	 */
+	if (arguments.benchmarkAmplitude)
 	{
-		evidenceProbabilityGivenPriorSamples[i] = exp(logEvidenceProbabilityGivenPriorSamples[i]);
+		int	status = runAmplitudeEstimationBenchmark(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
 
-	*meanValue = 0.0;
-	*standardDeviation = 0.0;
-	
-	for (i = 0; i < numberOfPriorSamples; i++)
+	/*
+	 *	Benchmark the stopping rules against each other.
+	 */
+	if (arguments.benchmarkStopping)
 	{
-		uniformSample = gsl_ran_flat(gslRNG, 0.0, 1.0);
+		int	status = runStoppingRuleBenchmark(&arguments, gslRNG);
 
-		if (uniformSample <= evidenceProbabilityGivenPriorSamples[i])
-		{
-			numberOfAcceptedPriorSamples += 1;
-			*meanValue += priorSamples[i];
-			*standardDeviation += priorSamples[i] * priorSamples[i];
-		}
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
 
-	if (numberOfAcceptedPriorSamples == 1)
+	/*
+	 *	Benchmark the latency of iterations under background load.
+	 */
+	if (arguments.benchmarkRealTime)
 	{
-		*standardDeviation = currentStandardDeviation / 2;
+		int	status = runRealTimeBenchmark(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
-	else
+
+	/*
+	 *	Benchmark the critical path of split RFPE updates.
+	 */
+	if (arguments.benchmarkOverlap)
 	{
-		*meanValue /= numberOfAcceptedPriorSamples;
-		*standardDeviation = sqrt((*standardDeviation / numberOfAcceptedPriorSamples) - (*meanValue * *meanValue));
-		*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+		int	status = runRFPEOverlapBenchmark(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
 
-	return;
-}
+	/*
+	 *	Benchmark batch updates of many qubits.
+	 */
+	if (arguments.benchmarkBatch)
+	{
+		int	status = runRFPEBatchBenchmark(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
+	}
 
-bool
-runAQPEviaRFPEExperiment(double initialMeanValue, double initialStandardDeviation, CommandLineArguments *  arguments, size_t experimentNo, gsl_rng *  gslRNG, size_t *  convergenceIterationCount, double *  estimatedPhi)
-{
-	double *	priorSamples;
-	uint64_t	evidenceSampleCounts[2];
-	double		meanValue = initialMeanValue;
-	double		standardDeviation = initialStandardDeviation;
-	bool		convergenceAchieved  = false;
-	size_t		i;
-	
 	/*
-	 *	Allocate arrays.
+	 *	Benchmark the shot record generator.
 	 */
-	priorSamples = (double *) malloc(arguments->numberOfPriorTestSamplesPerIteration * sizeof(double));
-	
-	if (arguments->verbose)
+	if (arguments.benchmarkShotRecords)
 	{
-		printf("\nStarting AQPE Experiment #%zu:\n", experimentNo);
-		printf("-------------------------------\n");
-		printf("Iteration 0: Mean value of estimate Phi: %le,\tStandard deviation of estimate Phi: %le\n", meanValue, standardDeviation);
+		int	status = runShotRecordBenchmark(&arguments, gslRNG);
+
+		gsl_rng_free(gslRNG);
+
+		return status;
 	}
-	
+
 	/*
-	 *	Loop over RFPE iterations
+	 *	Enter real-time mode before the result stream and the shot record
+	 *	file are created, so that a failure leaves nothing behind.
 	 */
-	for (i = 0; i < kMaxNumberOfIterations; i++)
+	if (arguments.realTime && enterRealTimeMode(&arguments))
 	{
-		currentM = calculateM(standardDeviation, arguments->alpha);
-		currentTheta = calculateTheta(meanValue, standardDeviation);
-		
-		runQPECircuit(arguments->targetPhi, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
-		sampleFromRestrictedGaussian(meanValue, standardDeviation, priorSamples, arguments->numberOfPriorTestSamplesPerIteration, gslRNG);
-		doRFPE(priorSamples, arguments->numberOfPriorTestSamplesPerIteration, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, &meanValue, &standardDeviation, gslRNG);
+		gsl_rng_free(gslRNG);
+
+		return 1;
+	}
 
-		if (arguments->verbose)
+	/*
+	 *	Publish iterations live to shared memory, one ring per thread.
+	 */
+	if (arguments.resultStreamName != NULL)
+	{
+		if (createResultStream(&resultStream, arguments.resultStreamName, arguments.numberOfThreads))
 		{
-			printf("\nIteration %zu: Mean value of estimate Phi: %le,\tStandard deviation of estimate Phi: %le\n", i + 1, meanValue, standardDeviation);
+			gsl_rng_free(gslRNG);
+
+			return 1;
 		}
+		resultStreamOpen = true;
+	}
 
-		/*
-		 *	If the standard deviation of prior is smaller than precision, terminate.
-		 */
-		if (standardDeviation < arguments->precision)
+	/*
+	 *	Keep the shots of every circuit.
+	 */
+	if (arguments.shotRecordPath != NULL)
+	{
+		if (openShotRecordFile(&shotRecordFile, arguments.shotRecordPath))
 		{
-			*estimatedPhi = meanValue;
-			*convergenceIterationCount = i + 1;
-			convergenceAchieved = true;
-			break;
+			if (resultStreamOpen)
+			{
+				closeResultStream(&resultStream);
+			}
+			gsl_rng_free(gslRNG);
+
+			return 1;
 		}
+		shotRecordFileOpen = true;
+	}
+
+	if (arguments.convergenceCurvesPath != NULL)
+	{
+		convergenceCurves = allocConvergenceCurves();
 	}
 
+	experiments = (AQPEExperiment *) malloc(arguments.numberOfRepetitions * sizeof(AQPEExperiment));
+	experimentResources = (QuantumResources *) malloc(arguments.numberOfRepetitions * sizeof(QuantumResources));
+	experimentEfficiencies = (EstimatorEfficiency *) malloc(arguments.numberOfRepetitions * sizeof(EstimatorEfficiency));
+	squaredErrors = (double *) malloc(arguments.numberOfRepetitions * sizeof(double));
+
 	/*
-	 *	Report the results of the current experiment.
+	 *	Run the AQPE (via RFPE) experiments, on worker threads if requested.
 	 */
-	if (arguments->verbose)
+	if (arguments.numberOfThreads > 1)
 	{
-		if (convergenceAchieved)
+		runAQPEExperimentsInParallel(kInitialPriorMeanValue, kInitialPriorStandardDeviation, &arguments, gslRNG, resultStreamOpen ? &resultStream : NULL, convergenceCurves, experiments, &schedulerStatistics);
+	}
+	else
+	{
+		/*
+		 *	The workspace is allocated once for all experiments, after
+		 *	mlockall(), so that its pages are locked as well.
+		 */
+		workspace = allocAQPEWorkspace(&arguments);
+		workspace->shotRecordFile = shotRecordFileOpen ? &shotRecordFile : NULL;
+
+		for (i = 0; i < arguments.numberOfRepetitions; i++)
 		{
-			printf("\nAQPE Experiment #%zu: Successfully acheieved precision in %zu iterative circuit mappings to quantum hardware! The final estimate has mean value %le and standard deviation %le.\n", experimentNo, i + 1, meanValue, standardDeviation);
+			initAQPEExperiment(&experiments[i], kInitialPriorMeanValue, kInitialPriorStandardDeviation, i + 1, &arguments);
+			stepAQPEExperiment(&experiments[i], &arguments, kMaxNumberOfIterations, workspace, gslRNG, resultStreamOpen ? &resultStream.writers[0] : NULL);
+			reportAQPEExperiment(&experiments[i], &arguments);
 		}
-		else
+
+		if (convergenceCurves != NULL)
 		{
-			printf("\nAQPE Experiment #%zu: Could not converge within the maximum allowed number of %d iterative circuit mappings to quantum hardware! The final estimate has mean value %le and standard deviation %le.\n", experimentNo, kMaxNumberOfIterations, meanValue, standardDeviation);
+			mergeConvergenceCurves(convergenceCurves, workspace->convergenceCurves);
 		}
+		freeAQPEWorkspace(workspace);
 	}
 
-	/*
-	 *	Free allocated arrays.
-	 */
-	free(priorSamples);
+	if (resultStreamOpen)
+	{
+		closeResultStream(&resultStream);
+	}
 
-	return convergenceAchieved;
-}
+	if (shotRecordFileOpen)
+	{
+		closeShotRecordFile(&shotRecordFile);
+	}
 
-int
-main(int argc, char *  argv[])
-{
-	CommandLineArguments	arguments = {
-		.targetPhi				= M_PI / 2,
-		.precision				= 1e-4,
-		.alpha					= 0.5,
-		.numberOfEvidenceSamplesPerIteration	= 0,
-		.numberOfPriorTestSamplesPerIteration	= 1000,
-		.numberOfRepetitions			= 1,
-		.verbose				= false,
-	};
-	double			initialMeanValue = 0.0;
-	double			initialStandardDeviation = M_PI / 2;
-	double			estimatedPhi;
-	size_t			convergenceIterationCount;
-	double			averageNumberOfTotalIterations = 0.0;
-	double			averageDistanceFromTarget = 0.0;
-	size_t			wrongConvergenceCount = 0;
-	size_t			convergenceCount = 0;
-	double			xSigmaValue = 4.0;
-	size_t			i;
-	gsl_rng *		gslRNG;
+	if (convergenceCurves != NULL)
+	{
+		writeConvergenceCurves(convergenceCurves, arguments.convergenceCurvesPath);
+		freeConvergenceCurves(convergenceCurves);
+	}
 
 	/*
-	 *	Get command line arguments.
+	 *	Keep the per-experiment results for later analysis.
 	 */
-	if (getCommandLineArguments(argc, argv, &arguments))
+	if (arguments.resultLogPath != NULL)
 	{
-		return 1;
+		ResultLog	resultLog;
+
+		if (openResultLog(&resultLog, arguments.resultLogPath, randomSeed) == 0)
+		{
+			appendToResultLog(&resultLog, experiments, arguments.numberOfRepetitions, arguments.targetPhi);
+			closeResultLog(&resultLog);
+		}
 	}
 
 	/*
-	 *	Allocate a default GSL random number generator and intialize the RNG.
-	 */
-	gslRNG = gsl_rng_alloc(gsl_rng_default);
-	initRNG(gslRNG);
-	
-	/*
-	 *	Loop over AQPE experiments
+	 *	Loop over AQPE experiments and count converging experiments.
 	 */
 	for (i = 0; i < arguments.numberOfRepetitions; i++)
 	{
-		/*
-		 *	Run the AQPE (via RFPE) experiment and count converging experiments.
-		 */
-		if (runAQPEviaRFPEExperiment(initialMeanValue, initialStandardDeviation, &arguments, i + 1, gslRNG, &convergenceIterationCount, &estimatedPhi))
+		experimentResources[i] = experiments[i].resources;
+		experimentEfficiencies[i] = experiments[i].efficiency;
+		squaredErrors[i] = (arguments.targetPhi - experiments[i].meanValue) * (arguments.targetPhi - experiments[i].meanValue);
+		abortCounts[experiments[i].abortReason]++;
+
+		if (experiments[i].abortReason != kAQPEAbortReasonNone)
+		{
+			abortedIterationCount += experiments[i].numberOfIterations;
+		}
+
+		if (experiments[i].converged)
 		{
+			double	estimatedPhi = experiments[i].meanValue;
+
 			/*
 			 *	Computing output variables of interest.
 			 */
-			averageNumberOfTotalIterations += (double) convergenceIterationCount;
+			averageNumberOfTotalIterations += (double) experiments[i].numberOfIterations;
 			averageDistanceFromTarget += fabs(arguments.targetPhi - estimatedPhi);
 
 			/*
@@ -371,6 +449,35 @@ main(int argc, char *  argv[])
 		printf("\nIn %zu out of %zu converging experiments, the phase estimation error was greater than %d times the input precision %le.\n", wrongConvergenceCount, convergenceCount, (int) xSigmaValue, xSigmaValue * arguments.precision);
 	}
 
+	if (arguments.abortDivergent)
+	{
+		size_t	numberOfAbortedExperiments = arguments.numberOfRepetitions - abortCounts[kAQPEAbortReasonNone];
+
+		printf("\nAborted %zu diverging AQPE experiments (%zu with %s, %zu with %s, %zu with %s), which saved %zu of the %zu iterations they could have run.\n",
+			numberOfAbortedExperiments,
+			abortCounts[kAQPEAbortReasonInvalidPosterior], aqpeAbortReasonName(kAQPEAbortReasonInvalidPosterior),
+			abortCounts[kAQPEAbortReasonGrowingWidth], aqpeAbortReasonName(kAQPEAbortReasonGrowingWidth),
+			abortCounts[kAQPEAbortReasonInconsistentEvidence], aqpeAbortReasonName(kAQPEAbortReasonInconsistentEvidence),
+			numberOfAbortedExperiments * kMaxNumberOfIterations - abortedIterationCount, numberOfAbortedExperiments * kMaxNumberOfIterations);
+	}
+
+	printQuantumResourcesSummary(experimentResources, arguments.numberOfRepetitions);
+
+	if (arguments.measureEfficiency)
+	{
+		printEstimatorEfficiencySummary(experimentEfficiencies, squaredErrors, arguments.numberOfRepetitions);
+	}
+
+	if (arguments.numberOfThreads > 1)
+	{
+		printSchedulerStatistics(&schedulerStatistics, &arguments);
+	}
+
+	free(squaredErrors);
+	free(experimentEfficiencies);
+	free(experimentResources);
+	free(experiments);
+
 	/*
 	 *	Verbose mode reminder.
 	 */
@@ -0,0 +1,346 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <float.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "meshPosterior.h"
+
+/*
+ *	Adjacent cells below this mass are merged, and cells below it are never refined.
+ */
+static const double	kMeshNegligibleMass = 1e-15;
+
+static void
+swapMeshBuffers(MeshPosterior *  posterior, size_t numberOfCells)
+{
+	double *	lowerEdges = posterior->lowerEdges;
+	double *	widths = posterior->widths;
+	double *	masses = posterior->masses;
+
+	posterior->lowerEdges = posterior->nextLowerEdges;
+	posterior->widths = posterior->nextWidths;
+	posterior->masses = posterior->nextMasses;
+	posterior->nextLowerEdges = lowerEdges;
+	posterior->nextWidths = widths;
+	posterior->nextMasses = masses;
+	posterior->numberOfCells = numberOfCells;
+}
+
+/*
+ *	Split cells whose selection mass is not negligible into equal parts
+ *	narrower than maximumWidth. If that would exceed the cell budget, only
+ *	cells of ever larger selection mass are split. Returns false if no cell
+ *	was split.
+ */
+static bool
+refineMeshPosterior(MeshPosterior *  posterior, double maximumWidth, const double *  selectionMasses)
+{
+	double	massThreshold = kMeshNegligibleMass;
+	size_t	numberOfCells;
+	size_t	i;
+	size_t	k;
+
+	while (true)
+	{
+		numberOfCells = 0;
+		for (i = 0; i < posterior->numberOfCells; i++)
+		{
+			numberOfCells += (selectionMasses[i] > massThreshold) ? (size_t) ceil(posterior->widths[i] / maximumWidth) : 1;
+		}
+
+		if ((numberOfCells <= kMeshMaximumNumberOfCells) || (massThreshold >= 1.0))
+		{
+			break;
+		}
+		massThreshold *= 10;
+	}
+
+	if ((numberOfCells == posterior->numberOfCells) || (numberOfCells > kMeshMaximumNumberOfCells))
+	{
+		return false;
+	}
+
+	numberOfCells = 0;
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		size_t	numberOfParts = (selectionMasses[i] > massThreshold) ? (size_t) ceil(posterior->widths[i] / maximumWidth) : 1;
+
+		for (k = 0; k < numberOfParts; k++)
+		{
+			posterior->nextLowerEdges[numberOfCells] = posterior->lowerEdges[i] + k * posterior->widths[i] / numberOfParts;
+			posterior->nextWidths[numberOfCells] = posterior->widths[i] / numberOfParts;
+			posterior->nextMasses[numberOfCells] = posterior->masses[i] / numberOfParts;
+			numberOfCells++;
+		}
+	}
+
+	swapMeshBuffers(posterior, numberOfCells);
+
+	return true;
+}
+
+/*
+ *	Merge runs of adjacent cells of negligible mass into single cells.
+ */
+static void
+coarsenMeshPosterior(MeshPosterior *  posterior)
+{
+	size_t	numberOfCells = 0;
+	size_t	i;
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		if ((numberOfCells > 0) && (posterior->masses[i] < kMeshNegligibleMass) && (posterior->nextMasses[numberOfCells - 1] < kMeshNegligibleMass))
+		{
+			posterior->nextWidths[numberOfCells - 1] += posterior->widths[i];
+			posterior->nextMasses[numberOfCells - 1] += posterior->masses[i];
+		}
+		else
+		{
+			posterior->nextLowerEdges[numberOfCells] = posterior->lowerEdges[i];
+			posterior->nextWidths[numberOfCells] = posterior->widths[i];
+			posterior->nextMasses[numberOfCells] = posterior->masses[i];
+			numberOfCells++;
+		}
+	}
+
+	swapMeshBuffers(posterior, numberOfCells);
+}
+
+/*
+ *	Moments relative to the densest cell, with offsets wrapped onto the
+ *	circle, so that a posterior straddling -pi/pi keeps a sensible mean.
+ */
+static void
+computeMeshPosteriorMoments(MeshPosterior *  posterior, const double *  masses)
+{
+	double	modeCenter = 0.0;
+	double	maximumDensity = -1.0;
+	double	sum = 0.0;
+	double	sumOfSquares = 0.0;
+	size_t	i;
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		double	density = masses[i] / posterior->widths[i];
+
+		if (density > maximumDensity)
+		{
+			maximumDensity = density;
+			modeCenter = posterior->lowerEdges[i] + posterior->widths[i] / 2;
+		}
+	}
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		double	offset = posterior->lowerEdges[i] + posterior->widths[i] / 2 - modeCenter;
+
+		offset -= 2 * M_PI * round(offset / (2 * M_PI));
+		sum += masses[i] * offset;
+		sumOfSquares += masses[i] * (offset * offset + posterior->widths[i] * posterior->widths[i] / 12);
+	}
+
+	posterior->meanValue = modeCenter + sum;
+	posterior->meanValue -= 2 * M_PI * round(posterior->meanValue / (2 * M_PI));
+	posterior->standardDeviation = sqrt(fmax(sumOfSquares - sum * sum, 0.0));
+}
+
+MeshPosterior *
+allocMeshPosterior(void)
+{
+	MeshPosterior *	posterior = (MeshPosterior *) calloc(1, sizeof(MeshPosterior));
+
+	posterior->lowerEdges = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+	posterior->widths = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+	posterior->masses = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+	posterior->nextLowerEdges = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+	posterior->nextWidths = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+	posterior->nextMasses = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+	posterior->posteriorMasses = (double *) malloc(kMeshMaximumNumberOfCells * sizeof(double));
+
+	return posterior;
+}
+
+void
+freeMeshPosterior(MeshPosterior *  posterior)
+{
+	free(posterior->lowerEdges);
+	free(posterior->widths);
+	free(posterior->masses);
+	free(posterior->nextLowerEdges);
+	free(posterior->nextWidths);
+	free(posterior->nextMasses);
+	free(posterior->posteriorMasses);
+	free(posterior);
+}
+
+void
+initMeshPosterior(MeshPosterior *  posterior, double meanValue, double standardDeviation)
+{
+	double	width = 2 * M_PI / kMeshInitialNumberOfCells;
+	double	total = 0.0;
+	size_t	i;
+
+	posterior->numberOfCells = kMeshInitialNumberOfCells;
+
+	for (i = 0; i < kMeshInitialNumberOfCells; i++)
+	{
+		double	offset = -M_PI + (i + 0.5) * width - meanValue;
+
+		offset -= 2 * M_PI * round(offset / (2 * M_PI));
+		posterior->lowerEdges[i] = -M_PI + i * width;
+		posterior->widths[i] = width;
+		posterior->masses[i] = exp(-0.5 * offset * offset / (standardDeviation * standardDeviation));
+		total += posterior->masses[i];
+	}
+
+	for (i = 0; i < kMeshInitialNumberOfCells; i++)
+	{
+		posterior->masses[i] /= total;
+	}
+
+	computeMeshPosteriorMoments(posterior, posterior->masses);
+}
+
+/*
+ *	Compute the posterior masses of the current cells into posteriorMasses.
+ *	The fringe is averaged over each cell, cos(M (c - theta)) sinc(M w / 2) for
+ *	a cell of center c and width w, so that cells wider than a fringe period
+ *	see a washed-out likelihood rather than an aliased one. The probabilities
+ *	are clamped away from zero so that the loop is branch-free.
+ */
+static void
+computeMeshPosteriorMasses(MeshPosterior *  posterior, const uint64_t *  evidenceSampleCounts, double M, double theta)
+{
+	double	count0 = (double) evidenceSampleCounts[0];
+	double	count1 = (double) evidenceSampleCounts[1];
+	double	maxOfLogMass = -INFINITY;
+	double	total = 0.0;
+	size_t	i;
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		double	halfPhase = 0.5 * M * posterior->widths[i];
+		double	sinc = (halfPhase > 1e-8) ? sin(halfPhase) / halfPhase : 1.0;
+		double	fringe = cos(M * (posterior->lowerEdges[i] + posterior->widths[i] / 2 - theta)) * sinc;
+		double	p0 = fmin(fmax(0.5 * (1 + fringe), DBL_MIN), 1 - DBL_EPSILON / 2);
+
+		posterior->posteriorMasses[i] = log(posterior->masses[i]) + count0 * log(p0) + count1 * log(1 - p0);
+		maxOfLogMass = fmax(maxOfLogMass, posterior->posteriorMasses[i]);
+	}
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		posterior->posteriorMasses[i] = exp(posterior->posteriorMasses[i] - maxOfLogMass);
+		total += posterior->posteriorMasses[i];
+	}
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		posterior->posteriorMasses[i] /= total;
+	}
+}
+
+void
+updateMeshPosterior(MeshPosterior *  posterior, const uint64_t *  evidenceSampleCounts, double M, double theta)
+{
+	double *	priorMasses;
+	size_t		pass;
+
+	/*
+	 *	Cells holding mass must resolve the fringe of the circuit.
+	 */
+	refineMeshPosterior(posterior, 2 * M_PI / (M * kMeshCellsPerFringePeriod), posterior->masses);
+
+	/*
+	 *	A circuit with many shots can narrow the posterior to less than a cell.
+	 *	Since the prior is constant within cells, splitting cells of the prior
+	 *	and updating again is exact, so the cells that hold posterior mass are
+	 *	split until they resolve the posterior width.
+	 */
+	for (pass = 0; pass < kMeshMaximumRefinementPasses; pass++)
+	{
+		bool	unresolved = false;
+		size_t	i;
+
+		computeMeshPosteriorMasses(posterior, evidenceSampleCounts, M, theta);
+		computeMeshPosteriorMoments(posterior, posterior->posteriorMasses);
+
+		for (i = 0; i < posterior->numberOfCells; i++)
+		{
+			unresolved = unresolved || ((posterior->posteriorMasses[i] > kMeshNegligibleMass) && (posterior->widths[i] * kMeshCellsPerStandardDeviation > posterior->standardDeviation));
+		}
+
+		if (!unresolved || !refineMeshPosterior(posterior, posterior->standardDeviation / kMeshCellsPerStandardDeviation, posterior->posteriorMasses))
+		{
+			break;
+		}
+	}
+
+	if (pass == kMeshMaximumRefinementPasses)
+	{
+		computeMeshPosteriorMasses(posterior, evidenceSampleCounts, M, theta);
+	}
+
+	priorMasses = posterior->masses;
+	posterior->masses = posterior->posteriorMasses;
+	posterior->posteriorMasses = priorMasses;
+
+	coarsenMeshPosterior(posterior);
+	computeMeshPosteriorMoments(posterior, posterior->masses);
+}
+
+/*
+ *	The density is constant within a cell, so a cell contributes its mass
+ *	times the fraction of its width inside the interval.
+ */
+double
+meshPosteriorMassWithin(const MeshPosterior *  posterior, double center, double halfWidth)
+{
+	double	mass = 0.0;
+	size_t	i;
+
+	for (i = 0; i < posterior->numberOfCells; i++)
+	{
+		double	lowerOffset = posterior->lowerEdges[i] - center;
+		double	overlap;
+
+		lowerOffset -= 2 * M_PI * round(lowerOffset / (2 * M_PI));
+		overlap = fmin(lowerOffset + posterior->widths[i], halfWidth) - fmax(lowerOffset, -halfWidth);
+		mass += (overlap > 0.0) ? posterior->masses[i] * overlap / posterior->widths[i] : 0.0;
+	}
+
+	return mass;
+}
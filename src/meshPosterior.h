@@ -0,0 +1,112 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+typedef enum
+{
+	kMeshMaximumNumberOfCells = 4096,
+	kMeshInitialNumberOfCells = 256,
+	kMeshCellsPerFringePeriod = 16,
+	kMeshCellsPerStandardDeviation = 8,
+	kMeshMaximumRefinementPasses = 8,
+} MeshConstants;
+
+/*
+ *	Posterior over [-pi, pi) as a piecewise-constant density on an adaptive
+ *	mesh. Cell i covers [lowerEdges[i], lowerEdges[i] + widths[i]) and holds
+ *	probability masses[i]. The cells are stored in order as separate arrays so
+ *	that the update is a branch-free loop over cells. The second set of arrays
+ *	is where refinement and coarsening build the new mesh, and the posterior
+ *	masses of an update are computed next to the prior masses.
+ */
+typedef struct MeshPosterior
+{
+	size_t		numberOfCells;
+	double *	lowerEdges;
+	double *	widths;
+	double *	masses;
+	double *	nextLowerEdges;
+	double *	nextWidths;
+	double *	nextMasses;
+	double *	posteriorMasses;
+	double		meanValue;
+	double		standardDeviation;
+} MeshPosterior;
+
+/**
+ *	@brief	Allocate a mesh posterior of at most kMeshMaximumNumberOfCells cells.
+ *
+ *	@return	MeshPosterior *	: mesh posterior, release with freeMeshPosterior()
+ */
+MeshPosterior *	allocMeshPosterior(void);
+
+/**
+ *	@brief	Release a mesh posterior.
+ *
+ *	@param	posterior	: mesh posterior to release
+ */
+void	freeMeshPosterior(MeshPosterior *  posterior);
+
+/**
+ *	@brief	Set the posterior to a Gaussian prior wrapped onto the circle, on a uniform mesh.
+ *
+ *	@param	posterior		: mesh posterior
+ *	@param	meanValue		: mean of the prior
+ *	@param	standardDeviation	: standard deviation of the prior
+ */
+void	initMeshPosterior(MeshPosterior *  posterior, double meanValue, double standardDeviation);
+
+/**
+ *	@brief	Update the posterior with the evidence of one QPE circuit.
+ *
+ *	@param	posterior		: mesh posterior
+ *	@param	evidenceSampleCounts	: counts of outcomes 0 and 1
+ *	@param	M			: number of applications of the unitary
+ *	@param	theta			: phase shift of the circuit
+ */
+void	updateMeshPosterior(MeshPosterior *  posterior, const uint64_t *  evidenceSampleCounts, double M, double theta);
+
+/**
+ *	@brief	Posterior mass within halfWidth of a point on the circle.
+ *
+ *	@param	posterior	: mesh posterior
+ *	@param	center		: center of the interval
+ *	@param	halfWidth	: half of the width of the interval
+ *	@return	double		: posterior mass in [center - halfWidth, center + halfWidth]
+ */
+double	meshPosteriorMassWithin(const MeshPosterior *  posterior, double center, double halfWidth);
@@ -0,0 +1,714 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include "aqpe.h"
+#include "mixture.h"
+
+void
+runMixtureQPECircuit(const double *  phis, const double *  weights, size_t numberOfPhases, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+{
+	double		probabilityEvidence0GivenPhiPrior = 0.0;
+	double		uniformSample;
+	uint64_t	i;
+	size_t		j;
+
+	/*
+	 *	The outcome probability of a mixed input state is the weighted sum of
+	 *	the outcome probabilities of its eigenstates.
+	 */
+	for (j = 0; j < numberOfPhases; j++)
+	{
+		probabilityEvidence0GivenPhiPrior += weights[j] * (1 + cos(M * (phis[j] - theta))) / 2;
+	}
+	evidenceSampleCounts[0] = 0;
+
+	for (i = 0; i < numberOfEvidenceSamples; i++)
+	{
+		uniformSample = gsl_ran_flat(gslRNG, 0.0, 1.0);
+		if (uniformSample < probabilityEvidence0GivenPhiPrior)
+		{
+			evidenceSampleCounts[0]++;
+		}
+	}
+	evidenceSampleCounts[1] = numberOfEvidenceSamples - evidenceSampleCounts[0];
+
+	return;
+}
+
+/*
+ *	Particles of the joint posterior over (phi_1, ..., phi_K, w_1, ..., w_K),
+ *	2K values per particle, and the circuits they were updated with. The
+ *	Metropolis moves need the likelihood of all earlier circuits, which each
+ *	particle keeps in historyLogLikelihoods. logLikelihoods holds the
+ *	likelihood of the circuit of the current update.
+ */
+typedef struct MixtureParticles
+{
+	size_t		numberOfParticles;
+	size_t		numberOfValues;
+	double *	particles;
+	double *	historyLogLikelihoods;
+	double *	logLikelihoods;
+	double *	importanceWeights;
+	double *	resampledParticles;
+	double *	resampledHistoryLogLikelihoods;
+	double *	resampledLogLikelihoods;
+	size_t		numberOfCircuits;
+	double		circuitM[kMaxNumberOfIterations];
+	double		circuitTheta[kMaxNumberOfIterations];
+	double		circuitCounts[kMaxNumberOfIterations][2];
+} MixtureParticles;
+
+/*
+ *	log P(counts | phases, weights) of one particle, where an outcome that
+ *	was never observed contributes nothing even where its probability is 0.
+ */
+static double
+logLikelihoodOfMixtureCounts(const double *  particle, size_t K, double count0, double count1, double M, double theta)
+{
+	double	p0 = 0.0;
+	size_t	j;
+
+	for (j = 0; j < K; j++)
+	{
+		p0 += particle[K + j] * (1 + cos(M * (particle[j] - theta))) / 2;
+	}
+	p0 = fmin(fmax(p0, 0.0), 1.0);
+
+	return ((count0 > 0) ? count0 * log(p0) : 0.0) + ((count1 > 0) ? count1 * log(1 - p0) : 0.0);
+}
+
+static double
+historyLogLikelihoodOfMixture(const MixtureParticles *  particles, const double *  particle, size_t K)
+{
+	double	logLikelihood = 0.0;
+	size_t	c;
+
+	for (c = 0; c < particles->numberOfCircuits; c++)
+	{
+		logLikelihood += logLikelihoodOfMixtureCounts(particle, K, particles->circuitCounts[c][0], particles->circuitCounts[c][1], particles->circuitM[c], particles->circuitTheta[c]);
+	}
+
+	return logLikelihood;
+}
+
+/*
+ *	The prior is uniform over increasing eigenphases in [-pi, pi) and over
+ *	the weights on the simplex, so a move only has to stay in its support.
+ */
+static bool
+isInMixturePrior(const double *  particle, size_t K)
+{
+	bool	inside = (particle[0] >= -M_PI) && (particle[K - 1] < M_PI);
+	size_t	j;
+
+	for (j = 0; j < K; j++)
+	{
+		inside = inside && (particle[K + j] > 0.0) && ((j == 0) || (particle[j - 1] <= particle[j]));
+	}
+
+	return inside;
+}
+
+/*
+ *	Weights exp(deltaBeta * (l - maxOfLogLikelihoods)) of raising the power
+ *	of the likelihood by deltaBeta, and their effective sample size.
+ */
+static double
+reweightMixtureParticles(MixtureParticles *  particles, double deltaBeta, double maxOfLogLikelihoods)
+{
+	double	sum = 0.0;
+	double	sumOfSquares = 0.0;
+	size_t	i;
+
+	for (i = 0; i < particles->numberOfParticles; i++)
+	{
+		particles->importanceWeights[i] = exp(deltaBeta * (particles->logLikelihoods[i] - maxOfLogLikelihoods));
+		sum += particles->importanceWeights[i];
+		sumOfSquares += particles->importanceWeights[i] * particles->importanceWeights[i];
+	}
+
+	return (sumOfSquares > 0.0) ? (sum * sum / sumOfSquares) : 0.0;
+}
+
+static MixtureParticles *
+allocMixtureParticles(size_t numberOfParticles, size_t K)
+{
+	MixtureParticles *	particles = (MixtureParticles *) calloc(1, sizeof(MixtureParticles));
+
+	particles->numberOfParticles = numberOfParticles;
+	particles->numberOfValues = 2 * K;
+	particles->particles = (double *) malloc(numberOfParticles * 2 * K * sizeof(double));
+	particles->historyLogLikelihoods = (double *) malloc(numberOfParticles * sizeof(double));
+	particles->logLikelihoods = (double *) malloc(numberOfParticles * sizeof(double));
+	particles->importanceWeights = (double *) malloc(numberOfParticles * sizeof(double));
+	particles->resampledParticles = (double *) malloc(numberOfParticles * 2 * K * sizeof(double));
+	particles->resampledHistoryLogLikelihoods = (double *) malloc(numberOfParticles * sizeof(double));
+	particles->resampledLogLikelihoods = (double *) malloc(numberOfParticles * sizeof(double));
+
+	return particles;
+}
+
+static void
+freeMixtureParticles(MixtureParticles *  particles)
+{
+	free(particles->particles);
+	free(particles->historyLogLikelihoods);
+	free(particles->logLikelihoods);
+	free(particles->importanceWeights);
+	free(particles->resampledParticles);
+	free(particles->resampledHistoryLogLikelihoods);
+	free(particles->resampledLogLikelihoods);
+	free(particles);
+}
+
+/*
+ *	Draw the particles from the prior: sorted uniform eigenphases, and flat
+ *	Dirichlet weights unless the weights are known.
+ */
+static void
+initMixtureParticles(MixtureParticles *  particles, const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const size_t	K = arguments->numberOfMixturePhases;
+	double		dirichletParameters[kMaximumNumberOfMixturePhases];
+	size_t		i;
+	size_t		j;
+
+	for (j = 0; j < K; j++)
+	{
+		dirichletParameters[j] = 1.0;
+	}
+
+	for (i = 0; i < particles->numberOfParticles; i++)
+	{
+		double *	particle = &particles->particles[i * 2 * K];
+
+		/*
+		 *	Insertion sort, K is small.
+		 */
+		for (j = 0; j < K; j++)
+		{
+			double	phase = gsl_ran_flat(gslRNG, -M_PI, M_PI);
+			size_t	k = j;
+
+			while ((k > 0) && (particle[k - 1] > phase))
+			{
+				particle[k] = particle[k - 1];
+				k--;
+			}
+			particle[k] = phase;
+		}
+
+		if (arguments->mixtureWeightsKnown)
+		{
+			memcpy(&particle[K], arguments->mixtureWeights, K * sizeof(double));
+		}
+		else
+		{
+			gsl_ran_dirichlet(gslRNG, K, dirichletParameters, &particle[K]);
+		}
+		particles->historyLogLikelihoods[i] = 0.0;
+	}
+	particles->numberOfCircuits = 0;
+}
+
+static void
+computeMixtureMoments(MixtureExperiment *  experiment, const MixtureParticles *  particles)
+{
+	const size_t	K = experiment->numberOfPhases;
+	double		sum[2 * kMaximumNumberOfMixturePhases] = {0};
+	double		sumOfSquares[kMaximumNumberOfMixturePhases] = {0};
+	size_t		i;
+	size_t		j;
+
+	for (i = 0; i < particles->numberOfParticles; i++)
+	{
+		for (j = 0; j < K; j++)
+		{
+			double	phase = particles->particles[i * 2 * K + j];
+
+			sum[j] += phase;
+			sumOfSquares[j] += phase * phase;
+			sum[K + j] += particles->particles[i * 2 * K + K + j];
+		}
+	}
+
+	for (j = 0; j < K; j++)
+	{
+		experiment->meanValues[j] = sum[j] / particles->numberOfParticles;
+		experiment->standardDeviations[j] = sqrt(fmax(sumOfSquares[j] / particles->numberOfParticles - experiment->meanValues[j] * experiment->meanValues[j], 0.0)) * kPosteriorStandardDeviationIncreaseFactor;
+		experiment->weights[j] = sum[K + j] / particles->numberOfParticles;
+	}
+}
+
+/*
+ *	Cholesky factor of the weighted covariance of the free values, scaled by
+ *	2.38^2 / d, the step size that is optimal for a Gaussian target in d
+ *	dimensions. Following the covariance lets the steps run along the narrow
+ *	ridges of the joint posterior, where the eigenphases and the weights
+ *	trade off against each other. Values without spread get no steps.
+ */
+static void
+computeMixtureProposalFactor(const MixtureParticles *  particles, size_t numberOfFreeValues, const double *  weightedMean, double totalWeight, double proposalFactor[][2 * kMaximumNumberOfMixturePhases])
+{
+	const size_t	numberOfValues = particles->numberOfValues;
+	double		covariance[2 * kMaximumNumberOfMixturePhases][2 * kMaximumNumberOfMixturePhases] = {{0}};
+	size_t		i;
+	size_t		j;
+	size_t		k;
+	size_t		l;
+
+	for (i = 0; i < particles->numberOfParticles; i++)
+	{
+		const double *	particle = &particles->particles[i * numberOfValues];
+
+		for (j = 0; j < numberOfFreeValues; j++)
+		{
+			for (k = 0; k <= j; k++)
+			{
+				covariance[j][k] += particles->importanceWeights[i] * (particle[j] - weightedMean[j]) * (particle[k] - weightedMean[k]);
+			}
+		}
+	}
+
+	for (j = 0; j < numberOfFreeValues; j++)
+	{
+		for (k = 0; k <= j; k++)
+		{
+			double	sum = covariance[j][k] / totalWeight * 2.38 * 2.38 / numberOfFreeValues;
+
+			for (l = 0; l < k; l++)
+			{
+				sum -= proposalFactor[j][l] * proposalFactor[k][l];
+			}
+
+			if (k == j)
+			{
+				proposalFactor[j][j] = (sum > 0.0) ? sqrt(sum) : 0.0;
+			}
+			else
+			{
+				proposalFactor[j][k] = (proposalFactor[k][k] > 0.0) ? sum / proposalFactor[k][k] : 0.0;
+			}
+		}
+	}
+}
+
+/*
+ *	Sequential Monte Carlo update of the joint particles with the counts of a
+ *	circuit, tempered in stages as in doTemperedRFPE(). Each stage raises the
+ *	power beta of the likelihood of the circuit as far as the effective
+ *	sample size stays above half the number of particles, resamples the
+ *	particles, and moves them with random-walk Metropolis steps that leave
+ *	prior x (likelihood of the earlier circuits) x likelihood^beta invariant.
+ *	The particles carry the correlations between eigenphases and weights
+ *	from one circuit to the next, which a fit of independent marginals loses.
+ */
+static void
+doMixtureRFPE(MixtureExperiment *  experiment, MixtureParticles *  particles, const CommandLineArguments *  arguments, const uint64_t *  evidenceSampleCounts, double M, double theta, gsl_rng *  gslRNG)
+{
+	const size_t	K = experiment->numberOfPhases;
+	const size_t	numberOfParticles = particles->numberOfParticles;
+	const size_t	numberOfValues = particles->numberOfValues;
+	const size_t	numberOfFreeValues = arguments->mixtureWeightsKnown ? K : 2 * K - 1;
+	const double	count0 = (double) evidenceSampleCounts[0];
+	const double	count1 = (double) evidenceSampleCounts[1];
+	double		beta = 0.0;
+	size_t		numberOfStages;
+	size_t		i;
+
+	for (i = 0; i < numberOfParticles; i++)
+	{
+		particles->logLikelihoods[i] = logLikelihoodOfMixtureCounts(&particles->particles[i * numberOfValues], K, count0, count1, M, theta);
+	}
+
+	for (numberOfStages = 0; (beta < 1.0) && (numberOfStages < kTemperedMaximumNumberOfStages); numberOfStages++)
+	{
+		double	targetEffectiveSampleSize = kTemperedEffectiveSampleSizeFraction * numberOfParticles;
+		double	maxOfLogLikelihoods = -INFINITY;
+		double	deltaBeta = 1.0 - beta;
+		double	weightedMean[2 * kMaximumNumberOfMixturePhases] = {0};
+		double	proposalFactor[2 * kMaximumNumberOfMixturePhases][2 * kMaximumNumberOfMixturePhases];
+		double	cumulativeWeight;
+		double	totalWeight = 0.0;
+		double	position;
+		size_t	j;
+		size_t	k;
+		size_t	step;
+
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			maxOfLogLikelihoods = fmax(maxOfLogLikelihoods, particles->logLikelihoods[i]);
+		}
+
+		/*
+		 *	Without a particle that can explain the evidence, the evidence is
+		 *	discarded and the particles are kept.
+		 */
+		if (!isfinite(maxOfLogLikelihoods))
+		{
+			return;
+		}
+
+		if (reweightMixtureParticles(particles, deltaBeta, maxOfLogLikelihoods) < targetEffectiveSampleSize)
+		{
+			double	lowerDeltaBeta = 0.0;
+			double	upperDeltaBeta = deltaBeta;
+			size_t	bisection;
+
+			for (bisection = 0; bisection < kTemperedBisectionSteps; bisection++)
+			{
+				deltaBeta = (lowerDeltaBeta + upperDeltaBeta) / 2;
+
+				if (reweightMixtureParticles(particles, deltaBeta, maxOfLogLikelihoods) < targetEffectiveSampleSize)
+				{
+					upperDeltaBeta = deltaBeta;
+				}
+				else
+				{
+					lowerDeltaBeta = deltaBeta;
+				}
+			}
+			deltaBeta = fmax(lowerDeltaBeta, DBL_EPSILON);
+			reweightMixtureParticles(particles, deltaBeta, maxOfLogLikelihoods);
+		}
+		beta = (deltaBeta >= 1.0 - beta) ? 1.0 : beta + deltaBeta;
+
+		/*
+		 *	Weighted mean of the values, and the Cholesky factor of their
+		 *	weighted covariance, which shapes the Metropolis steps.
+		 */
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			totalWeight += particles->importanceWeights[i];
+			for (j = 0; j < numberOfFreeValues; j++)
+			{
+				weightedMean[j] += particles->importanceWeights[i] * particles->particles[i * numberOfValues + j];
+			}
+		}
+		for (j = 0; j < numberOfFreeValues; j++)
+		{
+			weightedMean[j] /= totalWeight;
+		}
+		computeMixtureProposalFactor(particles, numberOfFreeValues, weightedMean, totalWeight, proposalFactor);
+
+		/*
+		 *	Systematic resampling: one uniform offset, and particle i is
+		 *	copied once for every grid point in its share of the weight.
+		 */
+		position = gsl_ran_flat(gslRNG, 0.0, 1.0) * totalWeight / numberOfParticles;
+		cumulativeWeight = particles->importanceWeights[0];
+		for (i = 0, k = 0; i < numberOfParticles; i++)
+		{
+			while ((position > cumulativeWeight) && (k < numberOfParticles - 1))
+			{
+				k++;
+				cumulativeWeight += particles->importanceWeights[k];
+			}
+			memcpy(&particles->resampledParticles[i * numberOfValues], &particles->particles[k * numberOfValues], numberOfValues * sizeof(double));
+			particles->resampledHistoryLogLikelihoods[i] = particles->historyLogLikelihoods[k];
+			particles->resampledLogLikelihoods[i] = particles->logLikelihoods[k];
+			position += totalWeight / numberOfParticles;
+		}
+
+		/*
+		 *	Random-walk Metropolis steps on all free values at once, with the
+		 *	step size that is optimal for a Gaussian target in that many
+		 *	dimensions. The last weight follows from the others.
+		 */
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			double *	particle = &particles->resampledParticles[i * numberOfValues];
+			double		historyLogLikelihood = particles->resampledHistoryLogLikelihoods[i];
+			double		logLikelihood = particles->resampledLogLikelihoods[i];
+
+			for (step = 0; step < kTemperedRejuvenationSteps; step++)
+			{
+				double	proposal[2 * kMaximumNumberOfMixturePhases];
+				double	proposalHistoryLogLikelihood;
+				double	proposalLogLikelihood;
+				double	logAcceptance;
+				double	normals[2 * kMaximumNumberOfMixturePhases];
+
+				memcpy(proposal, particle, numberOfValues * sizeof(double));
+				for (j = 0; j < numberOfFreeValues; j++)
+				{
+					normals[j] = gsl_ran_gaussian(gslRNG, 1.0);
+					for (k = 0; k <= j; k++)
+					{
+						proposal[j] += proposalFactor[j][k] * normals[k];
+					}
+				}
+				if (!arguments->mixtureWeightsKnown)
+				{
+					proposal[2 * K - 1] = 1.0;
+					for (j = 0; j < K - 1; j++)
+					{
+						proposal[2 * K - 1] -= proposal[K + j];
+					}
+				}
+
+				if (!isInMixturePrior(proposal, K))
+				{
+					continue;
+				}
+
+				proposalHistoryLogLikelihood = historyLogLikelihoodOfMixture(particles, proposal, K);
+				proposalLogLikelihood = logLikelihoodOfMixtureCounts(proposal, K, count0, count1, M, theta);
+				logAcceptance = (proposalHistoryLogLikelihood - historyLogLikelihood) + beta * (proposalLogLikelihood - logLikelihood);
+
+				if (log(gsl_ran_flat(gslRNG, 0.0, 1.0)) <= logAcceptance)
+				{
+					memcpy(particle, proposal, numberOfValues * sizeof(double));
+					historyLogLikelihood = proposalHistoryLogLikelihood;
+					logLikelihood = proposalLogLikelihood;
+				}
+			}
+			particles->historyLogLikelihoods[i] = historyLogLikelihood;
+			particles->logLikelihoods[i] = logLikelihood;
+		}
+		memcpy(particles->particles, particles->resampledParticles, numberOfParticles * numberOfValues * sizeof(double));
+	}
+
+	for (i = 0; i < numberOfParticles; i++)
+	{
+		particles->historyLogLikelihoods[i] += particles->logLikelihoods[i];
+	}
+	particles->circuitM[particles->numberOfCircuits] = M;
+	particles->circuitTheta[particles->numberOfCircuits] = theta;
+	particles->circuitCounts[particles->numberOfCircuits][0] = count0;
+	particles->circuitCounts[particles->numberOfCircuits][1] = count1;
+	particles->numberOfCircuits++;
+
+	computeMixtureMoments(experiment, particles);
+}
+
+static void
+printMixtureEstimate(const MixtureExperiment *  experiment)
+{
+	size_t	j;
+
+	for (j = 0; j < experiment->numberOfPhases; j++)
+	{
+		printf("\tPhi_%zu: Mean value %le,\tStandard deviation %le,\tWeight %lf\n", j + 1, experiment->meanValues[j], experiment->standardDeviations[j], experiment->weights[j]);
+	}
+}
+
+bool
+runMixtureAQPEExperiment(MixtureExperiment *  experiment, const CommandLineArguments *  arguments, size_t experimentNo, gsl_rng *  gslRNG)
+{
+	const size_t		K = arguments->numberOfMixturePhases;
+	MixtureParticles *	particles;
+	uint64_t		evidenceSampleCounts[2];
+	size_t			i;
+	size_t			j;
+
+	/*
+	 *	Allocate the particles and draw them from the prior.
+	 */
+	particles = allocMixtureParticles(arguments->numberOfPriorTestSamplesPerIteration, K);
+	initMixtureParticles(particles, arguments, gslRNG);
+
+	*experiment = (MixtureExperiment) {
+		.experimentNo		= experimentNo,
+		.numberOfPhases		= K,
+	};
+	computeMixtureMoments(experiment, particles);
+
+	if (arguments->verbose)
+	{
+		printf("\nStarting mixture AQPE Experiment #%zu:\n", experimentNo);
+		printf("---------------------------------------\n");
+		printf("Iteration 0:\n");
+		printMixtureEstimate(experiment);
+	}
+
+	/*
+	 *	Loop over RFPE iterations
+	 */
+	for (i = 0; i < kMaxNumberOfIterations; i++)
+	{
+		size_t	widest = 0;
+		double	currentM;
+		double	currentTheta;
+
+		/*
+		 *	Design the circuit for the least resolved eigenphase.
+		 */
+		for (j = 1; j < K; j++)
+		{
+			if (experiment->standardDeviations[j] > experiment->standardDeviations[widest])
+			{
+				widest = j;
+			}
+		}
+
+		/*
+		 *	A circuit measures one combination of the eigenphases, set by the
+		 *	fringes of the other eigenstates at its M. A fixed M would measure
+		 *	the same combination until the widest eigenphase narrows, which it
+		 *	may never do, so M is drawn from [M / 2, M].
+		 */
+		currentM = calculateM(experiment->standardDeviations[widest], arguments->alpha) * gsl_ran_flat(gslRNG, 0.5, 1.0);
+
+		/*
+		 *	With theta = mu - sigma, M sigma is much smaller than 1 and the
+		 *	circuit sits near an extremum of the fringe of the eigenphase. The
+		 *	other eigenstates keep the outcome probability away from 0 and 1
+		 *	there, so the circuit carries almost no information. A quarter of
+		 *	a fringe period from the mean puts it on the steepest slope.
+		 */
+		currentTheta = experiment->meanValues[widest] - M_PI / (2 * currentM);
+
+		runMixtureQPECircuit(arguments->mixturePhases, arguments->mixtureWeights, K, currentM, currentTheta, evidenceSampleCounts, arguments->numberOfEvidenceSamplesPerIteration, gslRNG);
+		accountCircuitMapping(&experiment->resources, currentM, arguments->numberOfEvidenceSamplesPerIteration);
+		doMixtureRFPE(experiment, particles, arguments, evidenceSampleCounts, currentM, currentTheta, gslRNG);
+		experiment->numberOfIterations++;
+
+		if (arguments->verbose)
+		{
+			printf("\nIteration %zu:\n", i + 1);
+			printMixtureEstimate(experiment);
+		}
+
+		/*
+		 *	Terminate when every eigenphase achieved the precision.
+		 */
+		experiment->converged = true;
+		for (j = 0; j < K; j++)
+		{
+			experiment->converged = experiment->converged && (experiment->standardDeviations[j] < arguments->precision);
+		}
+		if (experiment->converged)
+		{
+			break;
+		}
+	}
+
+	if (arguments->verbose)
+	{
+		if (experiment->converged)
+		{
+			printf("\nMixture AQPE Experiment #%zu: Successfully acheieved precision for all %zu eigenphases in %zu iterative circuit mappings to quantum hardware!\n", experimentNo, K, experiment->numberOfIterations);
+		}
+		else
+		{
+			printf("\nMixture AQPE Experiment #%zu: Could not converge within the maximum allowed number of %d iterative circuit mappings to quantum hardware!\n", experimentNo, kMaxNumberOfIterations);
+		}
+	}
+
+	/*
+	 *	Free the particles.
+	 */
+	freeMixtureParticles(particles);
+
+	return experiment->converged;
+}
+
+int
+runMixtureAQPE(const CommandLineArguments *  arguments, gsl_rng *  gslRNG)
+{
+	const size_t		K = arguments->numberOfMixturePhases;
+	MixtureExperiment	experiment;
+	QuantumResources *	experimentResources;
+	double			averageDistanceFromTarget[kMaximumNumberOfMixturePhases] = {0};
+	double			averageWeightError[kMaximumNumberOfMixturePhases] = {0};
+	double			averageNumberOfTotalIterations = 0.0;
+	size_t			wrongConvergenceCount[kMaximumNumberOfMixturePhases] = {0};
+	size_t			convergenceCount = 0;
+	size_t			i;
+	size_t			j;
+
+	experimentResources = (QuantumResources *) malloc(arguments->numberOfRepetitions * sizeof(QuantumResources));
+
+	/*
+	 *	Loop over AQPE experiments
+	 */
+	for (i = 0; i < arguments->numberOfRepetitions; i++)
+	{
+		if (runMixtureAQPEExperiment(&experiment, arguments, i + 1, gslRNG))
+		{
+			averageNumberOfTotalIterations += (double) experiment.numberOfIterations;
+			for (j = 0; j < K; j++)
+			{
+				averageDistanceFromTarget[j] += fabs(arguments->mixturePhases[j] - experiment.meanValues[j]);
+				wrongConvergenceCount[j] += (fabs(arguments->mixturePhases[j] - experiment.meanValues[j]) > 4 * arguments->precision);
+				averageWeightError[j] += fabs(arguments->mixtureWeights[j] - experiment.weights[j]);
+			}
+			convergenceCount++;
+		}
+		experimentResources[i] = experiment.resources;
+	}
+
+	/*
+	 *	Report results across all experiments.
+	 */
+	if (convergenceCount == 0)
+	{
+		printf("\nConvergence failed for all %zu mixture AQPE experiments within the allowed maximum limit of %d iterative circuit mappings to quantum hardware!\n", arguments->numberOfRepetitions, kMaxNumberOfIterations);
+	}
+	else
+	{
+		printf("\nConvergence for all %zu eigenphases achieved on average in %lf iterative circuit mappings to quantum hardware in %zu of %zu mixture AQPE experiments.\n", K, averageNumberOfTotalIterations / convergenceCount, convergenceCount, arguments->numberOfRepetitions);
+
+		for (j = 0; j < K; j++)
+		{
+			printf("Eigenphase %le with weight %lf: average phase estimation error %le", arguments->mixturePhases[j], arguments->mixtureWeights[j], averageDistanceFromTarget[j] / convergenceCount);
+			if (arguments->mixtureWeightsKnown)
+			{
+				printf(".\n");
+			}
+			else
+			{
+				printf(", average weight estimation error %le.\n", averageWeightError[j] / convergenceCount);
+			}
+		}
+
+		for (j = 0; j < K; j++)
+		{
+			printf("In %zu out of %zu converging experiments, the estimation error of eigenphase %le was greater than 4 times the input precision %le.\n", wrongConvergenceCount[j], convergenceCount, arguments->mixturePhases[j], 4 * arguments->precision);
+		}
+	}
+
+	printQuantumResourcesSummary(experimentResources, arguments->numberOfRepetitions);
+	free(experimentResources);
+
+	return 0;
+}
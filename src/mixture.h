@@ -0,0 +1,95 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+#include "quantumResources.h"
+#include "utilities.h"
+
+/*
+ *	State of one AQPE experiment on a mixed input state. The joint posterior
+ *	over the eigenphases and the weights is held by particles, each with its
+ *	eigenphases in increasing order to make them identifiable. The mean
+ *	values, standard deviations and weights are the marginal moments of the
+ *	particles.
+ */
+typedef struct MixtureExperiment
+{
+	size_t			experimentNo;
+	size_t			numberOfPhases;
+	double			meanValues[kMaximumNumberOfMixturePhases];
+	double			standardDeviations[kMaximumNumberOfMixturePhases];
+	double			weights[kMaximumNumberOfMixturePhases];
+	size_t			numberOfIterations;
+	bool			converged;
+	QuantumResources	resources;
+} MixtureExperiment;
+
+/**
+ *	@brief	Simulate the AQPE circuit on a mixed input state and count the measured outcomes.
+ *
+ *	@param	phis			: eigenphases in the input state
+ *	@param	weights			: weights of the eigenstates in the input state, summing to 1
+ *	@param	numberOfPhases		: number of eigenphases
+ *	@param	M			: number of applications of the unitary
+ *	@param	theta			: phase shift of the circuit
+ *	@param	evidenceSampleCounts	: output counts of outcomes 0 and 1
+ *	@param	numberOfEvidenceSamples	: number of measurements of the circuit
+ *	@param	gslRNG			: GSL random number generator
+ */
+void	runMixtureQPECircuit(const double *  phis, const double *  weights, size_t numberOfPhases, double M, double theta, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Run one AQPE experiment estimating all eigenphases (and weights) of a mixed input state jointly.
+ *
+ *	@param	experiment	: output experiment
+ *	@param	arguments	: command line arguments
+ *	@param	experimentNo	: experiment number used in verbose output
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	bool		: true if all eigenphases achieved the precision
+ */
+bool	runMixtureAQPEExperiment(MixtureExperiment *  experiment, const CommandLineArguments *  arguments, size_t experimentNo, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Run -r mixture AQPE experiments and report the results across experiments.
+ *
+ *	@param	arguments	: command line arguments
+ *	@param	gslRNG		: GSL random number generator
+ *	@return	int		: 0 if successful, else 1
+ */
+int	runMixtureAQPE(const CommandLineArguments *  arguments, gsl_rng *  gslRNG);
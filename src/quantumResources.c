@@ -0,0 +1,123 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_statistics_double.h>
+#include "quantumResources.h"
+
+void
+accountCircuitMapping(QuantumResources *  resources, double M, uint64_t numberOfShots)
+{
+	uint64_t	depth = (uint64_t) ceil(M);
+
+	resources->totalShots += numberOfShots;
+	resources->depthShotProduct += (double) depth * (double) numberOfShots;
+	resources->numberOfCircuitMappings++;
+
+	if (depth > resources->maximumDepth)
+	{
+		resources->maximumDepth = depth;
+	}
+}
+
+void
+printDistribution(const char *  name, double *  values, size_t numberOfValues)
+{
+	gsl_sort(values, 1, numberOfValues);
+
+	printf("%-36s %12.6le %12.6le %12.6le %12.6le %12.6le %12.6le\n",
+		name,
+		gsl_stats_mean(values, 1, numberOfValues),
+		values[0],
+		gsl_stats_quantile_from_sorted_data(values, 1, numberOfValues, 0.25),
+		gsl_stats_quantile_from_sorted_data(values, 1, numberOfValues, 0.5),
+		gsl_stats_quantile_from_sorted_data(values, 1, numberOfValues, 0.75),
+		values[numberOfValues - 1]);
+}
+
+void
+printQuantumResourcesSummary(const QuantumResources *  resources, size_t numberOfExperiments)
+{
+	QuantumResources	total = {0};
+	double *		values;
+	size_t			i;
+
+	if (numberOfExperiments == 0)
+	{
+		return;
+	}
+
+	values = (double *) malloc(numberOfExperiments * sizeof(double));
+
+	printf("\nQuantum resources per AQPE experiment across %zu experiments:\n", numberOfExperiments);
+	printf("%-36s %12s %12s %12s %12s %12s %12s\n", "", "mean", "min", "25%", "median", "75%", "max");
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = (double) resources[i].totalShots;
+	}
+	printDistribution("Total shots", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = resources[i].depthShotProduct;
+	}
+	printDistribution("Sum of depth x shots", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = (double) resources[i].maximumDepth;
+	}
+	printDistribution("Maximum depth", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		values[i] = (double) resources[i].numberOfCircuitMappings;
+	}
+	printDistribution("Circuit mappings", values, numberOfExperiments);
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		total.totalShots += resources[i].totalShots;
+		total.depthShotProduct += resources[i].depthShotProduct;
+		total.numberOfCircuitMappings += resources[i].numberOfCircuitMappings;
+		total.maximumDepth = (resources[i].maximumDepth > total.maximumDepth) ? resources[i].maximumDepth : total.maximumDepth;
+	}
+
+	printf("\nQuantum resources of the whole run: %"PRIu64" shots, %le depth x shots, maximum depth %"PRIu64", %zu circuit mappings.\n", total.totalShots, total.depthShotProduct, total.maximumDepth, total.numberOfCircuitMappings);
+
+	free(values);
+}
@@ -0,0 +1,76 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+
+/*
+ *	Quantum resources consumed by one AQPE experiment. The depth of a
+ *	circuit is the number of applications of the unitary, ceil(M).
+ */
+typedef struct QuantumResources
+{
+	uint64_t	totalShots;
+	double		depthShotProduct;
+	uint64_t	maximumDepth;
+	size_t		numberOfCircuitMappings;
+} QuantumResources;
+
+/**
+ *	@brief	Account for one circuit mapped to the quantum hardware.
+ *
+ *	@param	resources		: resources of the current experiment
+ *	@param	M			: number of applications of the unitary in the circuit
+ *	@param	numberOfShots		: number of measurements of the circuit
+ */
+void	accountCircuitMapping(QuantumResources *  resources, double M, uint64_t numberOfShots);
+
+/**
+ *	@brief	Print the mean and quantiles of a quantity across experiments as a table row.
+ *
+ *	@param	name		: name of the quantity
+ *	@param	values		: value for each experiment, sorted in place
+ *	@param	numberOfValues	: number of values
+ */
+void	printDistribution(const char *  name, double *  values, size_t numberOfValues);
+
+/**
+ *	@brief	Print the distribution of resources across experiments.
+ *
+ *	@param	resources		: resources of each experiment
+ *	@param	numberOfExperiments	: number of experiments
+ */
+void	printQuantumResourcesSummary(const QuantumResources *  resources, size_t numberOfExperiments);
@@ -0,0 +1,99 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "realTime.h"
+
+/*
+ *	Touch the stack that the iterations will use, so that its pages are
+ *	mapped, and locked by mlockall(), before the first iteration.
+ */
+static void
+prefaultStack(void)
+{
+	volatile unsigned char	stack[kRealTimeStackPrefaultSize];
+
+	memset((unsigned char *) stack, 0, sizeof(stack));
+}
+
+int
+enterRealTimeMode(const CommandLineArguments *  arguments)
+{
+	/*
+	 *	Locking needs CAP_IPC_LOCK or a large enough RLIMIT_MEMLOCK. Without
+	 *	it, the run continues, since the iterations allocate nothing and the
+	 *	pages they use stay resident unless the system is short of memory.
+	 */
+	if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+	{
+		fprintf(stderr, "\nWarning: Could not lock memory with mlockall(): %s. Continuing with unlocked memory.\n", strerror(errno));
+	}
+	prefaultStack();
+
+	if (arguments->pinnedCPU >= 0)
+	{
+		cpu_set_t	cpuSet;
+		int		status;
+
+		CPU_ZERO(&cpuSet);
+		CPU_SET(arguments->pinnedCPU, &cpuSet);
+		status = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		if (status != 0)
+		{
+			fprintf(stderr, "\nError: Could not pin the thread to CPU %d: %s.\n", arguments->pinnedCPU, strerror(status));
+
+			return 1;
+		}
+	}
+
+	if (arguments->realTimePriority > 0)
+	{
+		struct sched_param	parameters = {.sched_priority = arguments->realTimePriority};
+		int			status = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+
+		if (status != 0)
+		{
+			fprintf(stderr, "\nError: Could not run the thread under SCHED_FIFO with priority %d: %s.\n", arguments->realTimePriority, strerror(status));
+
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aqpe.h"
+#include "resultLog.h"
+
+const char	kResultLogMagic[8] = {'A', 'Q', 'P', 'E', 'L', 'O', 'G', '1'};
+
+int
+openResultLog(ResultLog *  log, const char *  path, uint64_t seed)
+{
+	ResultLogHeader	header;
+	long		size;
+
+	*log = (ResultLog) {
+		.seed	= seed,
+	};
+
+	/*
+	 *	The file is opened for reading too, so that the header of an existing
+	 *	log can be checked before appending to it.
+	 */
+	log->file = fopen(path, "a+b");
+	if (log->file == NULL)
+	{
+		fprintf(stderr, "\nError: Could not open result log '%s'.\n", path);
+
+		return 1;
+	}
+
+	/*
+	 *	Records reach the file in large blocks rather than one write per
+	 *	record. The buffer must be set before any other operation on the
+	 *	stream.
+	 */
+	log->buffer = (char *) malloc(kResultLogBufferSize);
+	setvbuf(log->file, log->buffer, _IOFBF, kResultLogBufferSize);
+
+	fseek(log->file, 0, SEEK_END);
+	size = ftell(log->file);
+
+	if (size == 0)
+	{
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, kResultLogMagic, sizeof(header.magic));
+		header.recordSize = sizeof(ResultLogRecord);
+
+		if (fwrite(&header, sizeof(header), 1, log->file) != 1)
+		{
+			fprintf(stderr, "\nError: Could not write the header of result log '%s'.\n", path);
+			fclose(log->file);
+			free(log->buffer);
+
+			return 1;
+		}
+	}
+	else
+	{
+		rewind(log->file);
+
+		if ((fread(&header, sizeof(header), 1, log->file) != 1) || (memcmp(header.magic, kResultLogMagic, sizeof(header.magic)) != 0) || (header.recordSize != sizeof(ResultLogRecord)) || ((size - (long) sizeof(header)) % sizeof(ResultLogRecord) != 0))
+		{
+			fprintf(stderr, "\nError: '%s' is not a result log with %zu-byte records.\n", path, sizeof(ResultLogRecord));
+			fclose(log->file);
+			free(log->buffer);
+
+			return 1;
+		}
+
+		/*
+		 *	A write may only follow a read after a repositioning of the
+		 *	stream.
+		 */
+		fseek(log->file, 0, SEEK_END);
+	}
+
+	return 0;
+}
+
+int
+appendToResultLog(ResultLog *  log, const AQPEExperiment *  experiments, size_t numberOfExperiments, double targetPhi)
+{
+	size_t	i;
+
+	for (i = 0; i < numberOfExperiments; i++)
+	{
+		ResultLogRecord	record = {
+			.seed			= log->seed,
+			.experimentNo		= experiments[i].experimentNo,
+			.meanValue		= experiments[i].meanValue,
+			.standardDeviation	= experiments[i].standardDeviation,
+			.error			= fabs(targetPhi - experiments[i].meanValue),
+			.totalShots		= experiments[i].resources.totalShots,
+			.depthShotProduct	= experiments[i].resources.depthShotProduct,
+			.maximumDepth		= experiments[i].resources.maximumDepth,
+			.numberOfIterations	= (uint16_t) experiments[i].numberOfIterations,
+			.flags			= experiments[i].converged ? kResultLogRecordFlagConverged : 0,
+		};
+
+		if (fwrite(&record, sizeof(record), 1, log->file) != 1)
+		{
+			fprintf(stderr, "\nError: Could not append to the result log.\n");
+
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int
+closeResultLog(ResultLog *  log)
+{
+	int	status = (fclose(log->file) == 0) ? 0 : 1;
+
+	if (status)
+	{
+		fprintf(stderr, "\nError: Could not flush the result log.\n");
+	}
+
+	free(log->buffer);
+
+	return status;
+}
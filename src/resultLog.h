@@ -0,0 +1,121 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+struct AQPEExperiment;
+
+typedef enum
+{
+	kResultLogBufferSize = 1 << 22,
+} ResultLogConstants;
+
+typedef enum
+{
+	kResultLogRecordFlagConverged = 1 << 0,
+} ResultLogRecordFlag;
+
+/*
+ *	Header at the start of a result log. The records that follow are stored in
+ *	native byte order.
+ */
+typedef struct ResultLogHeader
+{
+	char		magic[8];
+	uint32_t	recordSize;
+	uint32_t	reserved;
+} ResultLogHeader;
+
+/*
+ *	Fixed-size record of one AQPE experiment. A record is identified by the
+ *	seed of the run and the number of the experiment within the run.
+ */
+typedef struct ResultLogRecord
+{
+	uint64_t	seed;
+	uint64_t	experimentNo;
+	double		meanValue;
+	double		standardDeviation;
+	double		error;
+	uint64_t	totalShots;
+	double		depthShotProduct;
+	uint64_t	maximumDepth;
+	uint16_t	numberOfIterations;
+	uint16_t	flags;
+	uint32_t	reserved;
+} ResultLogRecord;
+
+_Static_assert(sizeof(ResultLogRecord) == 72, "Result log records should stay 72 bytes");
+
+typedef struct ResultLog
+{
+	FILE *		file;
+	char *		buffer;
+	uint64_t	seed;
+} ResultLog;
+
+extern const char	kResultLogMagic[8];
+
+/**
+ *	@brief	Open a result log for appending, writing the header if the file is new.
+ *
+ *	@param	log	: log to initialize
+ *	@param	path	: path of the log file
+ *	@param	seed	: random seed of the run, stored in every record
+ *	@return	int	: 0 if successful, else 1
+ */
+int	openResultLog(ResultLog *  log, const char *  path, uint64_t seed);
+
+/**
+ *	@brief	Append the records of finished AQPE experiments to a result log.
+ *
+ *	@param	log			: log opened with openResultLog()
+ *	@param	experiments		: experiments to append
+ *	@param	numberOfExperiments	: number of experiments
+ *	@param	targetPhi		: target phase, for the estimation error
+ *	@return	int			: 0 if successful, else 1
+ */
+int	appendToResultLog(ResultLog *  log, const struct AQPEExperiment *  experiments, size_t numberOfExperiments, double targetPhi);
+
+/**
+ *	@brief	Flush and close a result log.
+ *
+ *	@param	log	: log to close
+ *	@return	int	: 0 if successful, else 1
+ */
+int	closeResultLog(ResultLog *  log);
@@ -0,0 +1,135 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "resultStream.h"
+
+int
+createResultStream(ResultStream *  stream, const char *  name, size_t numberOfRings)
+{
+	size_t	i;
+	int	fd;
+
+	*stream = (ResultStream) {0};
+
+	/*
+	 *	POSIX shared memory object names start with a slash.
+	 */
+	snprintf(stream->name, sizeof(stream->name), "%s%s", (name[0] == '/') ? "" : "/", name);
+	stream->size = sizeof(ResultStreamHeader) + numberOfRings * resultStreamRingSize(kResultStreamRingCapacity);
+
+	fd = shm_open(stream->name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		fprintf(stderr, "\nError: Could not create the shared memory object '%s'.\n", stream->name);
+
+		return 1;
+	}
+
+	if (ftruncate(fd, stream->size) != 0)
+	{
+		fprintf(stderr, "\nError: Could not size the shared memory object '%s'.\n", stream->name);
+		close(fd);
+		shm_unlink(stream->name);
+
+		return 1;
+	}
+
+	stream->header = (ResultStreamHeader *) mmap(NULL, stream->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (stream->header == MAP_FAILED)
+	{
+		fprintf(stderr, "\nError: Could not map the shared memory object '%s'.\n", stream->name);
+		shm_unlink(stream->name);
+
+		return 1;
+	}
+
+	/*
+	 *	The object is zero-filled, so every slot starts with sequence number 0.
+	 *	The magic is written last so that readers never see a partial header.
+	 */
+	stream->header->recordSize = sizeof(ResultStreamRecord);
+	stream->header->numberOfRings = numberOfRings;
+	stream->header->ringCapacity = kResultStreamRingCapacity;
+	atomic_init(&stream->header->finished, 0);
+	atomic_thread_fence(memory_order_release);
+	memcpy(stream->header->magic, kResultStreamMagic, sizeof(kResultStreamMagic));
+
+	stream->writers = (ResultStreamWriter *) malloc(numberOfRings * sizeof(ResultStreamWriter));
+	for (i = 0; i < numberOfRings; i++)
+	{
+		stream->writers[i] = (ResultStreamWriter) {
+			.ring		= resultStreamRing(stream->header, i),
+			.ringCapacity	= kResultStreamRingCapacity,
+			.position	= 0,
+		};
+	}
+
+	fprintf(stderr, "Publishing results to shared memory object '%s'.\n", stream->name);
+
+	return 0;
+}
+
+void
+publishToResultStream(ResultStreamWriter *  writer, const ResultStreamRecord *  record)
+{
+	ResultStreamSlot *	slot = &writer->ring->slots[writer->position & (writer->ringCapacity - 1)];
+
+	/*
+	 *	The writer never waits for readers: a slow reader detects from the
+	 *	sequence numbers that its records were overwritten.
+	 */
+	atomic_store_explicit(&slot->sequence, 2 * writer->position + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	slot->record = *record;
+	atomic_store_explicit(&slot->sequence, 2 * (writer->position + 1), memory_order_release);
+
+	writer->position++;
+	atomic_store_explicit(&writer->ring->head, writer->position, memory_order_release);
+}
+
+void
+closeResultStream(ResultStream *  stream)
+{
+	atomic_store_explicit(&stream->header->finished, 1, memory_order_release);
+	munmap(stream->header, stream->size);
+	shm_unlink(stream->name);
+	free(stream->writers);
+}
@@ -0,0 +1,165 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <stdatomic.h>
+
+typedef enum
+{
+	kResultStreamRingCapacity = 1 << 16,
+	kResultStreamCacheLineSize = 64,
+} ResultStreamConstants;
+
+typedef enum
+{
+	kResultStreamRecordIteration,
+	kResultStreamRecordExperiment,
+} ResultStreamRecordType;
+
+typedef enum
+{
+	kResultStreamRecordFlagConverged = 1 << 0,
+} ResultStreamRecordFlag;
+
+/*
+ *	Record published after every RFPE iteration, and once more when an
+ *	experiment finishes.
+ */
+typedef struct ResultStreamRecord
+{
+	uint32_t	type;
+	uint32_t	flags;
+	uint64_t	experimentNo;
+	uint64_t	numberOfIterations;
+	double		meanValue;
+	double		standardDeviation;
+	double		M;
+	double		theta;
+	uint64_t	totalShots;
+} ResultStreamRecord;
+
+/*
+ *	A slot holds a record and a sequence number that is odd while the writer
+ *	fills the slot and 2 (n + 1) once it holds the n-th record of its ring.
+ *	Readers copy the record and check that the sequence number was the same
+ *	before and after the copy.
+ */
+typedef struct ResultStreamSlot
+{
+	atomic_uint_fast64_t	sequence;
+	ResultStreamRecord	record;
+} ResultStreamSlot;
+
+/*
+ *	Ring of a single writer thread. The head is the number of records the
+ *	writer has published, and it is on its own cache line so that readers
+ *	polling it do not contend with the slots being written.
+ */
+typedef struct ResultStreamRing
+{
+	_Alignas(kResultStreamCacheLineSize) atomic_uint_fast64_t	head;
+	_Alignas(kResultStreamCacheLineSize) ResultStreamSlot		slots[];
+} ResultStreamRing;
+
+/*
+ *	Start of the shared memory object, followed by numberOfRings rings of
+ *	ringCapacity slots each.
+ */
+typedef struct ResultStreamHeader
+{
+	char			magic[8];
+	uint32_t		recordSize;
+	uint32_t		numberOfRings;
+	uint64_t		ringCapacity;
+	atomic_uint		finished;
+	_Alignas(kResultStreamCacheLineSize) char	rings[];
+} ResultStreamHeader;
+
+typedef struct ResultStreamWriter
+{
+	ResultStreamRing *	ring;
+	uint64_t		ringCapacity;
+	uint64_t		position;
+} ResultStreamWriter;
+
+typedef struct ResultStream
+{
+	char			name[256];
+	ResultStreamHeader *	header;
+	size_t			size;
+	ResultStreamWriter *	writers;
+} ResultStream;
+
+static const char	kResultStreamMagic[8] = {'A', 'Q', 'P', 'E', 'S', 'T', 'R', '1'};
+
+static inline size_t
+resultStreamRingSize(uint64_t ringCapacity)
+{
+	return sizeof(ResultStreamRing) + ringCapacity * sizeof(ResultStreamSlot);
+}
+
+static inline ResultStreamRing *
+resultStreamRing(ResultStreamHeader *  header, size_t ringIndex)
+{
+	return (ResultStreamRing *) (header->rings + ringIndex * resultStreamRingSize(header->ringCapacity));
+}
+
+/**
+ *	@brief	Create a shared memory result stream with one ring per writer thread.
+ *
+ *	@param	stream		: stream to initialize
+ *	@param	name		: name of the POSIX shared memory object
+ *	@param	numberOfRings	: number of writer threads
+ *	@return	int		: 0 if successful, else 1
+ */
+int	createResultStream(ResultStream *  stream, const char *  name, size_t numberOfRings);
+
+/**
+ *	@brief	Publish a record to the ring of a writer, overwriting the oldest record if the ring is full.
+ *
+ *	@param	writer	: writer of the calling thread
+ *	@param	record	: record to publish
+ */
+void	publishToResultStream(ResultStreamWriter *  writer, const ResultStreamRecord *  record);
+
+/**
+ *	@brief	Mark the stream as finished for its readers, then unmap and unlink it.
+ *
+ *	@param	stream	: stream created with createResultStream()
+ */
+void	closeResultStream(ResultStream *  stream);
@@ -0,0 +1,190 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdlib.h>
+#include <pthread.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "rfpeBatch.h"
+#include "rfpeKernels.h"
+
+/*
+ *	Update the range of qubits of a worker, each from fresh prior samples.
+ *	Most of the time goes to the Gaussian and uniform draws of GSL, which
+ *	are scalar, so the qubits are updated one after the other.
+ */
+static void
+updateRFPEBatchRange(RFPEBatchWorker *  worker, const RFPEBatchUpdate *  update)
+{
+	RFPEBatch *	batch = worker->batch;
+	size_t		begin = worker->workerIndex * update->numberOfQubits / batch->numberOfThreads;
+	size_t		end = (worker->workerIndex + 1) * update->numberOfQubits / batch->numberOfThreads;
+	size_t		i;
+
+	for (i = begin; i < end; i++)
+	{
+		size_t	numberOfAcceptedPriorSamples;
+
+		sampleFromRestrictedGaussian(update->meanValues[i], update->standardDeviations[i], worker->priorSamples, batch->numberOfPriorSamples, worker->gslRNG);
+		numberOfAcceptedPriorSamples = batch->kernel(worker->priorSamples, batch->numberOfPriorSamples, &update->evidenceSampleCounts[2 * i], update->evidenceSampleCounts[2 * i] + update->evidenceSampleCounts[2 * i + 1], update->Ms[i], update->thetas[i], &update->meanValues[i], &update->standardDeviations[i], worker->gslRNG);
+
+		if (update->numbersOfAcceptedPriorSamples != NULL)
+		{
+			update->numbersOfAcceptedPriorSamples[i] = numberOfAcceptedPriorSamples;
+		}
+	}
+}
+
+static void *
+rfpeBatchWorker(void *  argument)
+{
+	RFPEBatchWorker *	worker = (RFPEBatchWorker *) argument;
+	RFPEBatch *		batch = worker->batch;
+	uint64_t		lastRoundNumber = 0;
+
+	pthread_mutex_lock(&batch->mutex);
+
+	for (;;)
+	{
+		while (!batch->shuttingDown && (batch->roundNumber == lastRoundNumber))
+		{
+			pthread_cond_wait(&batch->roundStarted, &batch->mutex);
+		}
+
+		if (batch->shuttingDown)
+		{
+			break;
+		}
+
+		lastRoundNumber = batch->roundNumber;
+		pthread_mutex_unlock(&batch->mutex);
+
+		updateRFPEBatchRange(worker, batch->update);
+
+		pthread_mutex_lock(&batch->mutex);
+		if (--batch->numberOfBusyWorkers == 0)
+		{
+			pthread_cond_signal(&batch->roundFinished);
+		}
+	}
+
+	pthread_mutex_unlock(&batch->mutex);
+
+	return NULL;
+}
+
+RFPEBatch *
+allocRFPEBatch(size_t numberOfThreads, size_t numberOfPriorSamples, gsl_rng *  gslRNG)
+{
+	RFPEBatch *	batch = (RFPEBatch *) calloc(1, sizeof(RFPEBatch));
+	size_t		i;
+
+	batch->numberOfThreads = (numberOfThreads > 0) ? numberOfThreads : 1;
+	batch->numberOfPriorSamples = numberOfPriorSamples;
+	batch->kernel = selectRFPEKernel(numberOfPriorSamples);
+	batch->workers = (RFPEBatchWorker *) calloc(batch->numberOfThreads, sizeof(RFPEBatchWorker));
+	pthread_mutex_init(&batch->mutex, NULL);
+	pthread_cond_init(&batch->roundStarted, NULL);
+	pthread_cond_init(&batch->roundFinished, NULL);
+
+	for (i = 0; i < batch->numberOfThreads; i++)
+	{
+		RFPEBatchWorker *	worker = &batch->workers[i];
+
+		worker->batch = batch;
+		worker->workerIndex = i;
+		worker->gslRNG = gsl_rng_alloc(gsl_rng_default);
+		gsl_rng_set(worker->gslRNG, gsl_rng_get(gslRNG) + 1);
+		worker->priorSamples = (double *) malloc(numberOfPriorSamples * sizeof(double));
+
+		if (i > 0)
+		{
+			pthread_create(&worker->thread, NULL, rfpeBatchWorker, worker);
+		}
+	}
+
+	return batch;
+}
+
+void
+updateRFPEBatch(RFPEBatch *  batch, const RFPEBatchUpdate *  update)
+{
+	if (batch->numberOfThreads > 1)
+	{
+		pthread_mutex_lock(&batch->mutex);
+		batch->update = update;
+		batch->numberOfBusyWorkers = batch->numberOfThreads - 1;
+		batch->roundNumber++;
+		pthread_cond_broadcast(&batch->roundStarted);
+		pthread_mutex_unlock(&batch->mutex);
+	}
+
+	updateRFPEBatchRange(&batch->workers[0], update);
+
+	if (batch->numberOfThreads > 1)
+	{
+		pthread_mutex_lock(&batch->mutex);
+		while (batch->numberOfBusyWorkers > 0)
+		{
+			pthread_cond_wait(&batch->roundFinished, &batch->mutex);
+		}
+		pthread_mutex_unlock(&batch->mutex);
+	}
+}
+
+void
+freeRFPEBatch(RFPEBatch *  batch)
+{
+	size_t	i;
+
+	pthread_mutex_lock(&batch->mutex);
+	batch->shuttingDown = true;
+	pthread_cond_broadcast(&batch->roundStarted);
+	pthread_mutex_unlock(&batch->mutex);
+
+	for (i = 0; i < batch->numberOfThreads; i++)
+	{
+		if (i > 0)
+		{
+			pthread_join(batch->workers[i].thread, NULL);
+		}
+		gsl_rng_free(batch->workers[i].gslRNG);
+		free(batch->workers[i].priorSamples);
+	}
+
+	pthread_cond_destroy(&batch->roundStarted);
+	pthread_cond_destroy(&batch->roundFinished);
+	pthread_mutex_destroy(&batch->mutex);
+	free(batch->workers);
+	free(batch);
+}
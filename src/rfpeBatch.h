@@ -0,0 +1,119 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+
+/*
+ *	One round of independent RFPE updates, one per qubit, as arrays with one
+ *	element per qubit and two counts per qubit. The posteriors are updated
+ *	in place.
+ */
+typedef struct RFPEBatchUpdate
+{
+	size_t		numberOfQubits;
+	double *	meanValues;
+	double *	standardDeviations;
+	const double *	Ms;
+	const double *	thetas;
+	uint64_t *	evidenceSampleCounts;
+	size_t *	numbersOfAcceptedPriorSamples;
+} RFPEBatchUpdate;
+
+struct RFPEBatch;
+
+typedef struct RFPEBatchWorker
+{
+	struct RFPEBatch *	batch;
+	size_t			workerIndex;
+	gsl_rng *		gslRNG;
+	double *		priorSamples;
+	pthread_t		thread;
+} RFPEBatchWorker;
+
+/*
+ *	Pool of threads that update contiguous ranges of qubits. The calling
+ *	thread takes the first range, so a batch with one thread starts none.
+ *	The threads persist across rounds, so that a round costs no thread
+ *	creation.
+ */
+typedef struct RFPEBatch
+{
+	size_t			numberOfThreads;
+	size_t			numberOfPriorSamples;
+	RFPEKernel		kernel;
+	RFPEBatchWorker *	workers;
+	pthread_mutex_t		mutex;
+	pthread_cond_t		roundStarted;
+	pthread_cond_t		roundFinished;
+	uint64_t		roundNumber;
+	size_t			numberOfBusyWorkers;
+	bool			shuttingDown;
+	const RFPEBatchUpdate *	update;
+} RFPEBatch;
+
+/**
+ *	@brief	Create a batch updater and start its threads.
+ *
+ *	@param	numberOfThreads		: number of threads, including the calling thread
+ *	@param	numberOfPriorSamples	: number of prior samples per qubit update
+ *	@param	gslRNG			: GSL random number generator that seeds one generator per thread
+ *	@return	RFPEBatch *		: batch updater, release with freeRFPEBatch()
+ */
+RFPEBatch *	allocRFPEBatch(size_t numberOfThreads, size_t numberOfPriorSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Update the posteriors of all qubits of a round, and return when all are done.
+ *
+ *	The qubits are split across the threads only. Each qubit is updated on
+ *	its own by the scalar kernel for its number of prior samples, and is not
+ *	vectorized across qubits.
+ *
+ *	@param	batch	: batch updater
+ *	@param	update	: round of updates
+ */
+void	updateRFPEBatch(RFPEBatch *  batch, const RFPEBatchUpdate *  update);
+
+/**
+ *	@brief	Stop the threads of a batch updater and release it.
+ *
+ *	@param	batch	: batch updater
+ */
+void	freeRFPEBatch(RFPEBatch *  batch);
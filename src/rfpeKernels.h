@@ -0,0 +1,127 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+
+/*
+ *	Below this relative log-likelihood, the acceptance probability is less
+ *	than 2^-53, the resolution of the uniforms, so it is taken as 0 without
+ *	calling exp().
+ */
+static const double	kRFPENegligibleLogLikelihood = -37.5;
+
+/*
+ *	Rejection filtering kernels specialized at compile time for a fixed
+ *	number of prior samples, for the small -m of low-latency feedback loops.
+ *	A kernel computes the same update as doRFPE(), with the same draws from
+ *	the GSL generator, but keeps the log-likelihoods in a fixed-size array on
+ *	the stack and fuses the passes of doRFPE() into one loop over constant
+ *	bounds, which the compiler can unroll. It takes cos(x / 2) and sin(x / 2),
+ *	which the compiler computes together, for p0 = cos^2(x / 2) and
+ *	1 - p0 = sin^2(x / 2), and subtracts the maximum log-likelihood once.
+ */
+#define RFPE_DEFINE_FIXED_KERNEL(name, kNumberOfSamples) \
+	size_t \
+	name(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG) \
+	{ \
+		const double	count0 = (double) evidenceSampleCounts[0]; \
+		const double	count1 = (double) evidenceSampleCounts[1]; \
+		double		logEvidenceProbability[kNumberOfSamples]; \
+		double		maxOfLogEvidenceProbability = -INFINITY; \
+		double		currentStandardDeviation = *standardDeviation; \
+		double		sum = 0.0; \
+		double		sumOfSquares = 0.0; \
+		size_t		numberOfAcceptedPriorSamples = 0; \
+		size_t		i; \
+	\
+		for (i = 0; i < (kNumberOfSamples); i++) \
+		{ \
+			double	halfPhase = M * (priorSamples[i] - theta) / 2; \
+			double	cosine = cos(halfPhase); \
+			double	sine = sin(halfPhase); \
+	\
+			logEvidenceProbability[i] = ((count0 > 0) ? count0 * log(cosine * cosine) : 0.0) + ((count1 > 0) ? count1 * log(sine * sine) : 0.0); \
+			maxOfLogEvidenceProbability = (logEvidenceProbability[i] > maxOfLogEvidenceProbability) ? logEvidenceProbability[i] : maxOfLogEvidenceProbability; \
+		} \
+	\
+		for (i = 0; i < (kNumberOfSamples); i++) \
+		{ \
+			double	relativeLogEvidenceProbability = logEvidenceProbability[i] - maxOfLogEvidenceProbability; \
+			double	accepted = (gsl_rng_uniform(gslRNG) <= ((relativeLogEvidenceProbability < kRFPENegligibleLogLikelihood) ? 0.0 : exp(relativeLogEvidenceProbability))); \
+	\
+			numberOfAcceptedPriorSamples += (size_t) accepted; \
+			sum += accepted * priorSamples[i]; \
+			sumOfSquares += accepted * priorSamples[i] * priorSamples[i]; \
+		} \
+	\
+		if (numberOfAcceptedPriorSamples == 0) \
+		{ \
+			return 0; \
+		} \
+	\
+		*meanValue = sum / numberOfAcceptedPriorSamples; \
+	\
+		if (numberOfAcceptedPriorSamples == 1) \
+		{ \
+			*standardDeviation = currentStandardDeviation / 2; \
+		} \
+		else \
+		{ \
+			*standardDeviation = sqrt(fmax((sumOfSquares / numberOfAcceptedPriorSamples) - (*meanValue * *meanValue), 0.0)); \
+			*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor; \
+		} \
+	\
+		return numberOfAcceptedPriorSamples; \
+	}
+
+/*
+ *	Explicitly instantiated kernels.
+ */
+size_t	doRFPEFixed64(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+size_t	doRFPEFixed128(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+size_t	doRFPEFixed256(double *  priorSamples, size_t numberOfPriorSamples, uint64_t *  evidenceSampleCounts, uint64_t numberOfEvidenceSamples, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Select the rejection filtering kernel for a number of prior samples.
+ *
+ *	@param	numberOfPriorSamples	: number of prior samples per iteration
+ *	@return	RFPEKernel		: the specialized kernel if there is one, else doRFPE()
+ */
+RFPEKernel	selectRFPEKernel(size_t numberOfPriorSamples);
@@ -0,0 +1,248 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <gsl/gsl_randist.h>
+#include "aqpe.h"
+#include "rfpeMultiOutcome.h"
+
+MultiOutcomeRFPE *
+allocMultiOutcomeRFPE(size_t numberOfAncillas, size_t numberOfPriorSamples)
+{
+	MultiOutcomeRFPE *	multiOutcome = (MultiOutcomeRFPE *) calloc(1, sizeof(MultiOutcomeRFPE));
+	size_t			numberOfOutcomes = (size_t) 1 << numberOfAncillas;
+	size_t			y;
+
+	multiOutcome->numberOfOutcomes = numberOfOutcomes;
+	multiOutcome->numberOfPriorSamples = numberOfPriorSamples;
+	multiOutcome->evidenceSampleCounts = (uint64_t *) calloc(numberOfOutcomes, sizeof(uint64_t));
+	multiOutcome->cumulativeOutcomeProbabilities = (double *) malloc(numberOfOutcomes * sizeof(double));
+	multiOutcome->cosOfOutcomeShifts = (double *) malloc(numberOfOutcomes * sizeof(double));
+	multiOutcome->sinOfOutcomeShifts = (double *) malloc(numberOfOutcomes * sizeof(double));
+	multiOutcome->priorOffsets = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	multiOutcome->sinOfHalfPhases = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	multiOutcome->cosOfHalfPhases = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	multiOutcome->logLikelihoods = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	multiOutcome->acceptedOffsets = (double *) malloc(numberOfPriorSamples * sizeof(double));
+
+	for (y = 0; y < numberOfOutcomes; y++)
+	{
+		multiOutcome->cosOfOutcomeShifts[y] = cos(M_PI * y / numberOfOutcomes);
+		multiOutcome->sinOfOutcomeShifts[y] = sin(M_PI * y / numberOfOutcomes);
+	}
+
+	return multiOutcome;
+}
+
+void
+freeMultiOutcomeRFPE(MultiOutcomeRFPE *  multiOutcome)
+{
+	free(multiOutcome->evidenceSampleCounts);
+	free(multiOutcome->cumulativeOutcomeProbabilities);
+	free(multiOutcome->cosOfOutcomeShifts);
+	free(multiOutcome->sinOfOutcomeShifts);
+	free(multiOutcome->priorOffsets);
+	free(multiOutcome->sinOfHalfPhases);
+	free(multiOutcome->cosOfHalfPhases);
+	free(multiOutcome->logLikelihoods);
+	free(multiOutcome->acceptedOffsets);
+	free(multiOutcome);
+}
+
+/*
+ *	With a = M (phi - theta) / 2, the probability of outcome y is
+ *	sin^2(K a) / (K^2 sin^2(a - pi y / K)), which is 1 where the
+ *	denominator vanishes. Decoherence mixes it with the uniform distribution.
+ */
+void
+runMultiOutcomeQPECircuit(MultiOutcomeRFPE *  multiOutcome, double phi, double decoherenceRate, double M, double theta, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG)
+{
+	const size_t	numberOfOutcomes = multiOutcome->numberOfOutcomes;
+	const double	K = (double) numberOfOutcomes;
+	double		halfPhase = M * (phi - theta) / 2;
+	double		sinOfHalfPhase = sin(halfPhase);
+	double		cosOfHalfPhase = cos(halfPhase);
+	double		sinOfKHalfPhase = sin(K * halfPhase);
+	double		visibility = exp(-decoherenceRate * M * (K - 1));
+	double		sumOfProbabilities = 0.0;
+	uint64_t	i;
+	size_t		y;
+
+	for (y = 0; y < numberOfOutcomes; y++)
+	{
+		double	denominator = sinOfHalfPhase * multiOutcome->cosOfOutcomeShifts[y] - cosOfHalfPhase * multiOutcome->sinOfOutcomeShifts[y];
+		double	probability = (fabs(denominator) < 1e-9) ? 1.0 : (sinOfKHalfPhase * sinOfKHalfPhase) / (K * K * denominator * denominator);
+
+		sumOfProbabilities += visibility * probability + (1 - visibility) / K;
+		multiOutcome->cumulativeOutcomeProbabilities[y] = sumOfProbabilities;
+		multiOutcome->evidenceSampleCounts[y] = 0;
+	}
+
+	/*
+	 *	The cumulative distribution is searched by bisection for every shot.
+	 *	Scaling the uniform by the sum absorbs the rounding of the kernel.
+	 */
+	for (i = 0; i < numberOfEvidenceSamples; i++)
+	{
+		double	uniformSample = gsl_ran_flat(gslRNG, 0.0, sumOfProbabilities);
+		size_t	lower = 0;
+		size_t	upper = numberOfOutcomes - 1;
+
+		while (lower < upper)
+		{
+			size_t	middle = (lower + upper) / 2;
+
+			if (uniformSample < multiOutcome->cumulativeOutcomeProbabilities[middle])
+			{
+				upper = middle;
+			}
+			else
+			{
+				lower = middle + 1;
+			}
+		}
+		multiOutcome->evidenceSampleCounts[lower]++;
+	}
+}
+
+/*
+ *	Up to a constant, the log-likelihood of a sample with a = M (x - theta) / 2
+ *	is 2 N log|sin(K a)| - 2 sum_y n_y log|sin(a - pi y / K)|, since the
+ *	numerator of the Fejer kernel is the same for all outcomes. Each sample
+ *	then needs one sin(K a) and one sincos(a), and each observed outcome one
+ *	multiply-add and one logarithm per sample, in a loop over the samples
+ *	that the compiler vectorizes. Outcomes that were not observed cost
+ *	nothing.
+ */
+size_t
+doMultiOutcomeRFPE(MultiOutcomeRFPE *  multiOutcome, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
+{
+	const size_t	numberOfPriorSamples = multiOutcome->numberOfPriorSamples;
+	const double	K = (double) multiOutcome->numberOfOutcomes;
+	const double	priorMeanValue = *meanValue;
+	const double	priorStandardDeviation = *standardDeviation;
+	double *	logLikelihoods = multiOutcome->logLikelihoods;
+	double		numberOfEvidenceSamples = 0.0;
+	double		maxOfLogLikelihoods = -INFINITY;
+	double		sum = 0.0;
+	double		sumOfSquares = 0.0;
+	size_t		numberOfAcceptedPriorSamples = 0;
+	size_t		i;
+	size_t		y;
+
+	sampleOffsetsFromRestrictedGaussian(priorMeanValue, priorStandardDeviation, multiOutcome->priorOffsets, numberOfPriorSamples, gslRNG);
+
+	for (y = 0; y < multiOutcome->numberOfOutcomes; y++)
+	{
+		numberOfEvidenceSamples += (double) multiOutcome->evidenceSampleCounts[y];
+	}
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		double	halfPhase = M * ((priorMeanValue - theta) + multiOutcome->priorOffsets[i]) / 2;
+
+		multiOutcome->sinOfHalfPhases[i] = sin(halfPhase);
+		multiOutcome->cosOfHalfPhases[i] = cos(halfPhase);
+		logLikelihoods[i] = 2 * numberOfEvidenceSamples * log(fmax(fabs(sin(K * halfPhase)), DBL_MIN));
+	}
+
+	for (y = 0; y < multiOutcome->numberOfOutcomes; y++)
+	{
+		const double	count = (double) multiOutcome->evidenceSampleCounts[y];
+		const double	cosOfShift = multiOutcome->cosOfOutcomeShifts[y];
+		const double	sinOfShift = multiOutcome->sinOfOutcomeShifts[y];
+
+		if (count == 0.0)
+		{
+			continue;
+		}
+
+		for (i = 0; i < numberOfPriorSamples; i++)
+		{
+			double	denominator = multiOutcome->sinOfHalfPhases[i] * cosOfShift - multiOutcome->cosOfHalfPhases[i] * sinOfShift;
+
+			logLikelihoods[i] -= 2 * count * log(fmax(fabs(denominator), DBL_MIN));
+		}
+	}
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		maxOfLogLikelihoods = (logLikelihoods[i] > maxOfLogLikelihoods) ? logLikelihoods[i] : maxOfLogLikelihoods;
+	}
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		if (log(gsl_ran_flat(gslRNG, 0.0, 1.0)) <= logLikelihoods[i] - maxOfLogLikelihoods)
+		{
+			multiOutcome->acceptedOffsets[numberOfAcceptedPriorSamples] = multiOutcome->priorOffsets[i];
+			numberOfAcceptedPriorSamples += 1;
+			sum += multiOutcome->priorOffsets[i];
+			sumOfSquares += multiOutcome->priorOffsets[i] * multiOutcome->priorOffsets[i];
+		}
+	}
+
+	multiOutcome->numberOfAcceptedOffsets = numberOfAcceptedPriorSamples;
+	multiOutcome->posteriorMeanOffset = (numberOfAcceptedPriorSamples > 0) ? sum / numberOfAcceptedPriorSamples : 0.0;
+
+	if (numberOfAcceptedPriorSamples == 1)
+	{
+		*meanValue = priorMeanValue + sum;
+		*standardDeviation = priorStandardDeviation / 2;
+	}
+	else if (numberOfAcceptedPriorSamples > 1)
+	{
+		double	meanOffset = sum / numberOfAcceptedPriorSamples;
+
+		*meanValue = priorMeanValue + meanOffset;
+		*standardDeviation = sqrt(fmax((sumOfSquares / numberOfAcceptedPriorSamples) - (meanOffset * meanOffset), 0.0));
+		*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+	}
+
+	return numberOfAcceptedPriorSamples;
+}
+
+double
+multiOutcomeRFPEMassWithin(const MultiOutcomeRFPE *  multiOutcome, double halfWidth)
+{
+	size_t	numberWithin = 0;
+	size_t	i;
+
+	for (i = 0; i < multiOutcome->numberOfAcceptedOffsets; i++)
+	{
+		numberWithin += (fabs(multiOutcome->acceptedOffsets[i] - multiOutcome->posteriorMeanOffset) <= halfWidth);
+	}
+
+	return (multiOutcome->numberOfAcceptedOffsets > 0) ? (double) numberWithin / multiOutcome->numberOfAcceptedOffsets : 0.0;
+}
@@ -0,0 +1,118 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+
+/*
+ *	Textbook phase estimation with t ancilla qubits: the ancillas control
+ *	U^(M 2^j) for j = 0, ..., t - 1 behind a phase shift theta and are read
+ *	out after an inverse QFT, which gives one of K = 2^t outcomes y with
+ *	probability F_K(M (phi - theta) - 2 pi y / K) / K, where F_K is the
+ *	Fejer kernel. With t = 1, this is the two-outcome circuit of doRFPE().
+ *
+ *	The struct holds the counts of the K outcomes, tables of the shifts of
+ *	the outcomes, and the per-sample arrays of a rejection filtering update.
+ *	The samples are held as offsets from the prior mean value.
+ */
+typedef struct MultiOutcomeRFPE
+{
+	size_t		numberOfOutcomes;
+	size_t		numberOfPriorSamples;
+	uint64_t *	evidenceSampleCounts;
+	double *	cumulativeOutcomeProbabilities;
+	double *	cosOfOutcomeShifts;
+	double *	sinOfOutcomeShifts;
+	double *	priorOffsets;
+	double *	sinOfHalfPhases;
+	double *	cosOfHalfPhases;
+	double *	logLikelihoods;
+	double *	acceptedOffsets;
+	size_t		numberOfAcceptedOffsets;
+	double		posteriorMeanOffset;
+} MultiOutcomeRFPE;
+
+/**
+ *	@brief	Allocate the counts, tables and arrays of K-outcome RFPE updates.
+ *
+ *	@param	numberOfAncillas	: number t of ancilla qubits, for K = 2^t outcomes
+ *	@param	numberOfPriorSamples	: number of prior samples per update
+ *	@return	MultiOutcomeRFPE *	: updates, release with freeMultiOutcomeRFPE()
+ */
+MultiOutcomeRFPE *	allocMultiOutcomeRFPE(size_t numberOfAncillas, size_t numberOfPriorSamples);
+
+/**
+ *	@brief	Free updates allocated with allocMultiOutcomeRFPE().
+ *
+ *	@param	multiOutcome	: updates to free
+ */
+void	freeMultiOutcomeRFPE(MultiOutcomeRFPE *  multiOutcome);
+
+/**
+ *	@brief	Simulate the K-outcome circuit shot by shot into the counts of the updates.
+ *
+ *	@param	multiOutcome			: updates whose counts to fill
+ *	@param	phi				: eigenphase
+ *	@param	decoherenceRate			: decoherence rate, with visibility exp(-lambda M (K - 1)) for the depth M (K - 1)
+ *	@param	M				: number of applications of the unitary controlled by the first ancilla
+ *	@param	theta				: phase shift of the circuit
+ *	@param	numberOfEvidenceSamples		: number of shots
+ *	@param	gslRNG				: GSL random number generator
+ */
+void	runMultiOutcomeQPECircuit(MultiOutcomeRFPE *  multiOutcome, double phi, double decoherenceRate, double M, double theta, uint64_t numberOfEvidenceSamples, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Update a Gaussian prior by rejection filtering with the K-outcome likelihood of the counts of the updates.
+ *
+ *	@param	multiOutcome		: updates holding the counts of the circuit
+ *	@param	M			: number of applications of the unitary controlled by the first ancilla
+ *	@param	theta			: phase shift of the circuit
+ *	@param	meanValue		: mean value of the prior, replaced by that of the posterior
+ *	@param	standardDeviation	: standard deviation of the prior, replaced by that of the posterior
+ *	@param	gslRNG			: GSL random number generator
+ *	@return	size_t			: number of accepted prior samples
+ */
+size_t	doMultiOutcomeRFPE(MultiOutcomeRFPE *  multiOutcome, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Fraction of the samples accepted by the last doMultiOutcomeRFPE() within halfWidth of the posterior mean value.
+ *
+ *	@param	multiOutcome	: updates
+ *	@param	halfWidth	: half of the width of the interval
+ *	@return	double		: fraction of the accepted samples in the interval, 0 if none was accepted
+ */
+double	multiOutcomeRFPEMassWithin(const MultiOutcomeRFPE *  multiOutcome, double halfWidth);
@@ -0,0 +1,194 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include "aqpe.h"
+#include "doubleDouble.h"
+#include "rfpeSplit.h"
+
+RFPEPrecomputation *
+allocRFPEPrecomputation(size_t numberOfPriorSamples)
+{
+	RFPEPrecomputation *	precomputation = (RFPEPrecomputation *) calloc(1, sizeof(RFPEPrecomputation));
+
+	precomputation->numberOfPriorSamples = numberOfPriorSamples;
+	precomputation->priorOffsets = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	precomputation->logProbabilitiesOfOutcome[0] = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	precomputation->logProbabilitiesOfOutcome[1] = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	precomputation->logUniformSamples = (double *) malloc(numberOfPriorSamples * sizeof(double));
+	precomputation->acceptedOffsets = (double *) malloc(numberOfPriorSamples * sizeof(double));
+
+	return precomputation;
+}
+
+void
+freeRFPEPrecomputation(RFPEPrecomputation *  precomputation)
+{
+	free(precomputation->priorOffsets);
+	free(precomputation->logProbabilitiesOfOutcome[0]);
+	free(precomputation->logProbabilitiesOfOutcome[1]);
+	free(precomputation->logUniformSamples);
+	free(precomputation->acceptedOffsets);
+	free(precomputation);
+}
+
+void
+precomputeRFPE(RFPEPrecomputation *  precomputation, double meanValue, double standardDeviation, double M, double theta, gsl_rng *  gslRNG)
+{
+	size_t	i;
+
+	precomputation->priorMeanValue = meanValue;
+	precomputation->priorStandardDeviation = standardDeviation;
+	sampleOffsetsFromRestrictedGaussian(meanValue, standardDeviation, precomputation->priorOffsets, precomputation->numberOfPriorSamples, gslRNG);
+
+	/*
+	 *	p0 = cos^2(x / 2) and 1 - p0 = sin^2(x / 2), as in rfpeKernels.h, with
+	 *	x = M (mu - theta + offset). Since theta = mu - sigma, mu - theta is
+	 *	exact. For large M, the product with M and the reduction of the half
+	 *	phase to [-pi, pi] are carried out in double-double arithmetic.
+	 */
+	if (M < kExtendedPrecisionMinimumM)
+	{
+		for (i = 0; i < precomputation->numberOfPriorSamples; i++)
+		{
+			double	halfPhase = M * ((meanValue - theta) + precomputation->priorOffsets[i]) / 2;
+			double	cosine = cos(halfPhase);
+			double	sine = sin(halfPhase);
+
+			precomputation->logProbabilitiesOfOutcome[0][i] = log(cosine * cosine);
+			precomputation->logProbabilitiesOfOutcome[1][i] = log(sine * sine);
+		}
+	}
+	else
+	{
+		for (i = 0; i < precomputation->numberOfPriorSamples; i++)
+		{
+			DoubleDouble	halfPhase = reducePhaseDoubleDouble(multiplyDoubleDouble(M / 2, twoSum(meanValue - theta, precomputation->priorOffsets[i])));
+			double		cosine;
+			double		sine;
+
+			sinCosDoubleDouble(halfPhase, &sine, &cosine);
+			precomputation->logProbabilitiesOfOutcome[0][i] = log(cosine * cosine);
+			precomputation->logProbabilitiesOfOutcome[1][i] = log(sine * sine);
+		}
+	}
+
+	/*
+	 *	A sample is accepted if u <= exp(l - max), which is the same as
+	 *	log(u) <= l - max, so the acceptance needs no exp() once the
+	 *	log-likelihoods l are known. For u = 0, log(u) is -inf and the sample
+	 *	is accepted unless its likelihood is NaN, as in doRFPE().
+	 */
+	for (i = 0; i < precomputation->numberOfPriorSamples; i++)
+	{
+		precomputation->logUniformSamples[i] = log(gsl_ran_flat(gslRNG, 0.0, 1.0));
+	}
+
+	return;
+}
+
+size_t
+finishRFPE(RFPEPrecomputation *  precomputation, const uint64_t *  evidenceSampleCounts, double *  meanValue, double *  standardDeviation)
+{
+	const size_t	numberOfPriorSamples = precomputation->numberOfPriorSamples;
+	const double	count0 = (double) evidenceSampleCounts[0];
+	const double	count1 = (double) evidenceSampleCounts[1];
+	double		logEvidenceProbability[numberOfPriorSamples];
+	double		maxOfLogEvidenceProbability = -INFINITY;
+	double		sum = 0.0;
+	double		sumOfSquares = 0.0;
+	size_t		numberOfAcceptedPriorSamples = 0;
+	size_t		i;
+
+	/*
+	 *	An outcome that was never observed contributes nothing, even where
+	 *	its probability is 0 and 0 * log(0) would give NaN.
+	 */
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		logEvidenceProbability[i] = ((count0 > 0) ? count0 * precomputation->logProbabilitiesOfOutcome[0][i] : 0.0) + ((count1 > 0) ? count1 * precomputation->logProbabilitiesOfOutcome[1][i] : 0.0);
+		maxOfLogEvidenceProbability = (logEvidenceProbability[i] > maxOfLogEvidenceProbability) ? logEvidenceProbability[i] : maxOfLogEvidenceProbability;
+	}
+
+	for (i = 0; i < numberOfPriorSamples; i++)
+	{
+		if (precomputation->logUniformSamples[i] <= logEvidenceProbability[i] - maxOfLogEvidenceProbability)
+		{
+			precomputation->acceptedOffsets[numberOfAcceptedPriorSamples] = precomputation->priorOffsets[i];
+			numberOfAcceptedPriorSamples += 1;
+			sum += precomputation->priorOffsets[i];
+			sumOfSquares += precomputation->priorOffsets[i] * precomputation->priorOffsets[i];
+		}
+	}
+
+	precomputation->numberOfAcceptedOffsets = numberOfAcceptedPriorSamples;
+	precomputation->posteriorMeanOffset = (numberOfAcceptedPriorSamples > 0) ? sum / numberOfAcceptedPriorSamples : 0.0;
+
+	if (numberOfAcceptedPriorSamples == 0)
+	{
+		*meanValue = precomputation->priorMeanValue;
+		*standardDeviation = precomputation->priorStandardDeviation;
+	}
+	else if (numberOfAcceptedPriorSamples == 1)
+	{
+		*meanValue = precomputation->priorMeanValue + sum;
+		*standardDeviation = precomputation->priorStandardDeviation / 2;
+	}
+	else
+	{
+		double	meanOffset = sum / numberOfAcceptedPriorSamples;
+
+		*meanValue = precomputation->priorMeanValue + meanOffset;
+		*standardDeviation = sqrt(fmax((sumOfSquares / numberOfAcceptedPriorSamples) - (meanOffset * meanOffset), 0.0));
+		*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+	}
+
+	return numberOfAcceptedPriorSamples;
+}
+
+double
+rfpeAcceptedMassWithin(const RFPEPrecomputation *  precomputation, double halfWidth)
+{
+	size_t	numberWithin = 0;
+	size_t	i;
+
+	for (i = 0; i < precomputation->numberOfAcceptedOffsets; i++)
+	{
+		numberWithin += (fabs(precomputation->acceptedOffsets[i] - precomputation->posteriorMeanOffset) <= halfWidth);
+	}
+
+	return (precomputation->numberOfAcceptedOffsets > 0) ? (double) numberWithin / precomputation->numberOfAcceptedOffsets : 0.0;
+}
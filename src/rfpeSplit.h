@@ -0,0 +1,116 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+
+/*
+ *	Above this M, the phases of the prior samples are computed in
+ *	double-double arithmetic, since M ulp(phi) approaches the precision of
+ *	the phase.
+ */
+static const double	kExtendedPrecisionMinimumM = 1e6;
+
+/*
+ *	Everything of an RFPE update that does not depend on the outcome of the
+ *	circuit: the prior samples, their log-probabilities of either outcome,
+ *	and the logarithms of the uniforms that decide their acceptance. It is
+ *	filled while the circuit runs, so that only a multiply-add and a
+ *	comparison per sample remain once the counts arrive. The samples are
+ *	held as offsets from the prior mean value, so that neither their phases
+ *	nor the moments of the posterior lose the digits that a sample of a
+ *	narrow prior shares with its mean value.
+ */
+typedef struct RFPEPrecomputation
+{
+	size_t		numberOfPriorSamples;
+	double		priorMeanValue;
+	double		priorStandardDeviation;
+	double *	priorOffsets;
+	double *	logProbabilitiesOfOutcome[2];
+	double *	logUniformSamples;
+	double *	acceptedOffsets;
+	size_t		numberOfAcceptedOffsets;
+	double		posteriorMeanOffset;
+} RFPEPrecomputation;
+
+/**
+ *	@brief	Allocate the arrays of a split RFPE update.
+ *
+ *	@param	numberOfPriorSamples		: number of prior samples per update
+ *	@return	RFPEPrecomputation *		: precomputation, release with freeRFPEPrecomputation()
+ */
+RFPEPrecomputation *	allocRFPEPrecomputation(size_t numberOfPriorSamples);
+
+/**
+ *	@brief	Free a precomputation allocated with allocRFPEPrecomputation().
+ *
+ *	@param	precomputation	: precomputation to free
+ */
+void	freeRFPEPrecomputation(RFPEPrecomputation *  precomputation);
+
+/**
+ *	@brief	Draw the prior samples and uniforms of an RFPE update and take all of their logarithms, before the counts are known.
+ *
+ *	@param	precomputation		: precomputation to fill
+ *	@param	meanValue		: mean value of the prior
+ *	@param	standardDeviation	: standard deviation of the prior
+ *	@param	M			: number of applications of the unitary in the circuit
+ *	@param	theta			: phase shift of the circuit
+ *	@param	gslRNG			: GSL random number generator
+ */
+void	precomputeRFPE(RFPEPrecomputation *  precomputation, double meanValue, double standardDeviation, double M, double theta, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Finish an RFPE update from its precomputation and the counts of the circuit, as doRFPE() would.
+ *
+ *	@param	precomputation		: precomputation filled by precomputeRFPE(), which keeps the accepted samples
+ *	@param	evidenceSampleCounts	: counts of outcomes 0 and 1
+ *	@param	meanValue		: output, mean value of the posterior
+ *	@param	standardDeviation	: output, standard deviation of the posterior
+ *	@return	size_t			: number of accepted prior samples
+ */
+size_t	finishRFPE(RFPEPrecomputation *  precomputation, const uint64_t *  evidenceSampleCounts, double *  meanValue, double *  standardDeviation);
+
+/**
+ *	@brief	Fraction of the samples accepted by the last finishRFPE() within halfWidth of the posterior mean value.
+ *
+ *	@param	precomputation	: precomputation of the last update
+ *	@param	halfWidth	: half of the width of the interval
+ *	@return	double		: fraction of the accepted samples in the interval, 0 if none was accepted
+ */
+double	rfpeAcceptedMassWithin(const RFPEPrecomputation *  precomputation, double halfWidth);
@@ -0,0 +1,268 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include "aqpe.h"
+#include "rfpeStratified.h"
+
+/*
+ *	Log-density of the Gaussian prior restricted to (-pi, pi), as drawn by
+ *	sampleFromRestrictedGaussian().
+ */
+static double
+logRestrictedGaussianDensity(double x, double mu, double sigma, double logNormalization)
+{
+	return -((x - mu) * (x - mu)) / (2 * sigma * sigma) - logNormalization;
+}
+
+StratifiedRFPE *
+allocStratifiedRFPE(size_t numberOfSamples)
+{
+	StratifiedRFPE *	stratified = (StratifiedRFPE *) calloc(1, sizeof(StratifiedRFPE));
+
+	stratified->numberOfSamples = numberOfSamples;
+	stratified->maximumNumberOfComponents = (numberOfSamples / 2 > 0) ? numberOfSamples / 2 : 1;
+	stratified->samples = (double *) malloc(numberOfSamples * sizeof(double));
+	stratified->logWeights = (double *) malloc(numberOfSamples * sizeof(double));
+	stratified->componentWeights = (double *) malloc(stratified->maximumNumberOfComponents * sizeof(double));
+	stratified->numbersOfComponentSamples = (size_t *) malloc(stratified->maximumNumberOfComponents * sizeof(size_t));
+
+	return stratified;
+}
+
+void
+freeStratifiedRFPE(StratifiedRFPE *  stratified)
+{
+	free(stratified->samples);
+	free(stratified->logWeights);
+	free(stratified->componentWeights);
+	free(stratified->numbersOfComponentSamples);
+	free(stratified);
+}
+
+size_t
+doStratifiedRFPE(StratifiedRFPE *  stratified, const uint64_t *  evidenceSampleCounts, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
+{
+	const size_t	numberOfSamples = stratified->numberOfSamples;
+	const double	count0 = (double) evidenceSampleCounts[0];
+	const double	count1 = (double) evidenceSampleCounts[1];
+	const double	numberOfShots = count0 + count1;
+	const double	priorMeanValue = *meanValue;
+	const double	priorStandardDeviation = *standardDeviation;
+	const double	logPriorNormalization = log(priorStandardDeviation * sqrt(2 * M_PI) * (erf((M_PI - priorMeanValue) / (M_SQRT2 * priorStandardDeviation)) + erf((M_PI + priorMeanValue) / (M_SQRT2 * priorStandardDeviation))) / 2);
+	const double	halfPeakOffset = acos(sqrt(count0 / numberOfShots));
+	const size_t	numberOfPeakSigns = ((count0 > 0) && (count1 > 0)) ? 2 : 1;
+	const double	windowLowerEdge = fmax(priorMeanValue - kStratifiedPriorWidthsInWindow * priorStandardDeviation, -M_PI);
+	const double	windowUpperEdge = fmin(priorMeanValue + kStratifiedPriorWidthsInWindow * priorStandardDeviation, M_PI);
+	double		peakStandardDeviation = kStratifiedPeakWidthFactor / (M * sqrt(numberOfShots));
+	size_t		numberOfDefensiveSamples = (size_t) ceil(kStratifiedDefensiveFraction * numberOfSamples);
+	double		maxOfLogWeights = -INFINITY;
+	double		sumOfWeights = 0.0;
+	double		sumOfSquaredWeights = 0.0;
+	double		weightedSum = 0.0;
+	double		weightedSumOfSquares = 0.0;
+	long		lowestPeakIndex;
+	long		highestPeakIndex;
+	size_t		i;
+	size_t		j;
+
+	/*
+	 *	Peak (k, s) is at theta + (2 / M) (s a + k pi), for the signs s of
+	 *	-a and +a, or only +a where the two coincide because an outcome was
+	 *	never observed. Components are numbered j = numberOfPeakSigns (k -
+	 *	lowestPeakIndex) + s. A peak is kept narrower than an eighth of the
+	 *	period of the fringe, so that the components stay apart. A peak just
+	 *	beyond +-pi still has its flank inside, so it gets the weight of the
+	 *	prior at the edge.
+	 */
+	peakStandardDeviation = fmin(peakStandardDeviation, M_PI / (4 * M));
+	lowestPeakIndex = (long) floor((M * (windowLowerEdge - theta) / 2 - halfPeakOffset) / M_PI);
+	highestPeakIndex = (long) ceil((M * (windowUpperEdge - theta) / 2 + halfPeakOffset) / M_PI);
+	stratified->numberOfComponents = numberOfPeakSigns * (size_t) (highestPeakIndex - lowestPeakIndex + 1);
+
+	/*
+	 *	With more peaks within the prior than the samples can cover, the
+	 *	proposal is the prior, and the update is plain importance sampling.
+	 */
+	if (stratified->numberOfComponents > stratified->maximumNumberOfComponents)
+	{
+		stratified->numberOfComponents = 0;
+		numberOfDefensiveSamples = numberOfSamples;
+	}
+	else
+	{
+		double	totalComponentWeight = 0.0;
+		double	position;
+		double	cumulativeWeight = 0.0;
+		size_t	numberOfPeakSamples = numberOfSamples - numberOfDefensiveSamples;
+
+		for (j = 0; j < stratified->numberOfComponents; j++)
+		{
+			long	k = lowestPeakIndex + (long) (j / numberOfPeakSigns);
+			double	sign = ((numberOfPeakSigns == 2) && (j % 2 == 0)) ? -1.0 : 1.0;
+			double	center = theta + 2 * (sign * halfPeakOffset + k * M_PI) / M;
+
+			stratified->componentWeights[j] = (fabs(center) < M_PI + kStratifiedPriorWidthsInWindow * peakStandardDeviation) ? exp(logRestrictedGaussianDensity(fmax(fmin(center, M_PI), -M_PI), priorMeanValue, priorStandardDeviation, 0.0)) : 0.0;
+			totalComponentWeight += stratified->componentWeights[j];
+			stratified->numbersOfComponentSamples[j] = 0;
+		}
+
+		/*
+		 *	Stratify the peak samples over the components in proportion to
+		 *	the prior at their peaks, with one uniform offset.
+		 */
+		position = gsl_ran_flat(gslRNG, 0.0, 1.0) * totalComponentWeight / fmax(numberOfPeakSamples, 1);
+		for (j = 0, i = 0; (j < stratified->numberOfComponents) && (totalComponentWeight > 0.0); j++)
+		{
+			cumulativeWeight += stratified->componentWeights[j];
+			while ((i < numberOfPeakSamples) && (position < cumulativeWeight))
+			{
+				stratified->numbersOfComponentSamples[j]++;
+				position += totalComponentWeight / numberOfPeakSamples;
+				i++;
+			}
+		}
+		numberOfDefensiveSamples = numberOfSamples - i;
+	}
+
+	/*
+	 *	Draw the samples, the defensive ones first.
+	 */
+	sampleFromRestrictedGaussian(priorMeanValue, priorStandardDeviation, stratified->samples, numberOfDefensiveSamples, gslRNG);
+	for (j = 0, i = numberOfDefensiveSamples; j < stratified->numberOfComponents; j++)
+	{
+		long	k = lowestPeakIndex + (long) (j / numberOfPeakSigns);
+		double	sign = ((numberOfPeakSigns == 2) && (j % 2 == 0)) ? -1.0 : 1.0;
+		double	center = theta + 2 * (sign * halfPeakOffset + k * M_PI) / M;
+		size_t	n;
+
+		for (n = 0; n < stratified->numbersOfComponentSamples[j]; n++)
+		{
+			stratified->samples[i++] = center + gsl_ran_gaussian(gslRNG, peakStandardDeviation);
+		}
+	}
+
+	/*
+	 *	The weight of a sample is prior x likelihood / proposal, where the
+	 *	proposal is the mixture of all strata with the fractions of the
+	 *	samples drawn from them. Only the components next to the sample
+	 *	contribute to the proposal density.
+	 */
+	for (i = 0; i < numberOfSamples; i++)
+	{
+		double	x = stratified->samples[i];
+		double	halfPhase = M * (x - theta) / 2;
+		double	cosine = cos(halfPhase);
+		double	sine = sin(halfPhase);
+		double	logPrior = logRestrictedGaussianDensity(x, priorMeanValue, priorStandardDeviation, logPriorNormalization);
+		double	proposalDensity = ((double) numberOfDefensiveSamples / numberOfSamples) * exp(logPrior);
+		size_t	s;
+
+		if (fabs(x) >= M_PI)
+		{
+			stratified->logWeights[i] = -INFINITY;
+			continue;
+		}
+
+		for (s = 0; (s < numberOfPeakSigns) && (stratified->numberOfComponents > 0); s++)
+		{
+			double	sign = ((numberOfPeakSigns == 2) && (s == 0)) ? -1.0 : 1.0;
+			long	nearestPeakIndex = lround((halfPhase - sign * halfPeakOffset) / M_PI);
+			long	k;
+
+			for (k = nearestPeakIndex - 1; k <= nearestPeakIndex + 1; k++)
+			{
+				double	center = theta + 2 * (sign * halfPeakOffset + k * M_PI) / M;
+				double	z = (x - center) / peakStandardDeviation;
+
+				if ((k < lowestPeakIndex) || (k > highestPeakIndex))
+				{
+					continue;
+				}
+				j = numberOfPeakSigns * (size_t) (k - lowestPeakIndex) + s;
+				proposalDensity += ((double) stratified->numbersOfComponentSamples[j] / numberOfSamples) * exp(-z * z / 2) / (peakStandardDeviation * sqrt(2 * M_PI));
+			}
+		}
+
+		stratified->logWeights[i] = logPrior - log(proposalDensity)
+						+ ((count0 > 0) ? count0 * log(cosine * cosine) : 0.0)
+						+ ((count1 > 0) ? count1 * log(sine * sine) : 0.0);
+		maxOfLogWeights = (stratified->logWeights[i] > maxOfLogWeights) ? stratified->logWeights[i] : maxOfLogWeights;
+	}
+
+	stratified->maxOfLogWeights = maxOfLogWeights;
+	if (!isfinite(maxOfLogWeights))
+	{
+		*meanValue = priorMeanValue;
+		*standardDeviation = priorStandardDeviation;
+
+		return 0;
+	}
+
+	for (i = 0; i < numberOfSamples; i++)
+	{
+		double	weight = exp(stratified->logWeights[i] - maxOfLogWeights);
+
+		sumOfWeights += weight;
+		sumOfSquaredWeights += weight * weight;
+		weightedSum += weight * stratified->samples[i];
+		weightedSumOfSquares += weight * stratified->samples[i] * stratified->samples[i];
+	}
+
+	*meanValue = weightedSum / sumOfWeights;
+	*standardDeviation = sqrt(fmax((weightedSumOfSquares / sumOfWeights) - (*meanValue * *meanValue), 0.0));
+	*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+
+	return (size_t) lround(sumOfWeights * sumOfWeights / sumOfSquaredWeights);
+}
+
+double
+stratifiedRFPEMassWithin(const StratifiedRFPE *  stratified, double center, double halfWidth)
+{
+	double	sumOfWeights = 0.0;
+	double	sumOfWeightsWithin = 0.0;
+	size_t	i;
+
+	for (i = 0; i < stratified->numberOfSamples; i++)
+	{
+		double	weight = exp(stratified->logWeights[i] - stratified->maxOfLogWeights);
+
+		sumOfWeights += weight;
+		sumOfWeightsWithin += (fabs(stratified->samples[i] - center) <= halfWidth) ? weight : 0.0;
+	}
+
+	return (sumOfWeights > 0.0) ? sumOfWeightsWithin / sumOfWeights : 0.0;
+}
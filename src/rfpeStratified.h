@@ -0,0 +1,111 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+
+typedef enum
+{
+	kStratifiedPriorWidthsInWindow = 6,
+} StratifiedRFPEConstants;
+
+/*
+ *	Fraction of the samples drawn from the prior itself, so that the
+ *	proposal covers the prior wherever the peaks are misplaced, and width of
+ *	the proposal around a peak relative to the width of the peak.
+ */
+static const double	kStratifiedDefensiveFraction = 0.1;
+static const double	kStratifiedPeakWidthFactor = 2.0;
+
+/*
+ *	Importance sampling of the RFPE posterior from a proposal that is
+ *	stratified over the peaks of the likelihood within the prior. The peaks
+ *	of p0^n0 (1 - p0)^n1 lie where p0 = n0 / N, at
+ *	x = theta + (2 / M) (+-a + k pi) with a = arccos(sqrt(n0 / N)), and have
+ *	a width of about 1 / (M sqrt(N)). Component j of the proposal is a
+ *	Gaussian around peak j, and gets numbersOfComponentSamples[j] samples.
+ */
+typedef struct StratifiedRFPE
+{
+	size_t		numberOfSamples;
+	size_t		maximumNumberOfComponents;
+	double *	samples;
+	double *	logWeights;
+	double *	componentWeights;
+	size_t *	numbersOfComponentSamples;
+	size_t		numberOfComponents;
+	double		maxOfLogWeights;
+} StratifiedRFPE;
+
+/**
+ *	@brief	Allocate the samples of a stratified RFPE update.
+ *
+ *	@param	numberOfSamples		: number of samples per update, -m
+ *	@return	StratifiedRFPE *	: stratified update, release with freeStratifiedRFPE()
+ */
+StratifiedRFPE *	allocStratifiedRFPE(size_t numberOfSamples);
+
+/**
+ *	@brief	Free a stratified update allocated with allocStratifiedRFPE().
+ *
+ *	@param	stratified	: stratified update to free
+ */
+void	freeStratifiedRFPE(StratifiedRFPE *  stratified);
+
+/**
+ *	@brief	Update a Gaussian prior with the counts of a circuit by importance sampling from a proposal stratified over the peaks of the likelihood.
+ *
+ *	@param	stratified		: samples of the update
+ *	@param	evidenceSampleCounts	: counts of outcomes 0 and 1
+ *	@param	M			: number of applications of the unitary in the circuit
+ *	@param	theta			: phase shift of the circuit
+ *	@param	meanValue		: mean value of the prior, output mean value of the posterior
+ *	@param	standardDeviation	: standard deviation of the prior, output standard deviation of the posterior
+ *	@param	gslRNG			: GSL random number generator
+ *	@return	size_t			: effective sample size of the importance weights, 0 if they all vanished
+ */
+size_t	doStratifiedRFPE(StratifiedRFPE *  stratified, const uint64_t *  evidenceSampleCounts, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Importance-weighted fraction of the samples of the last stratified update within halfWidth of a point.
+ *
+ *	@param	stratified	: samples of the update
+ *	@param	center		: center of the interval
+ *	@param	halfWidth	: half of the width of the interval
+ *	@return	double		: posterior mass in [center - halfWidth, center + halfWidth]
+ */
+double	stratifiedRFPEMassWithin(const StratifiedRFPE *  stratified, double center, double halfWidth);
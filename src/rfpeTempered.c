@@ -0,0 +1,279 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include "aqpe.h"
+#include "rfpeTempered.h"
+
+/*
+ *	log P(counts | phi), where an outcome that was never observed
+ *	contributes nothing even where its probability is 0.
+ */
+static double
+logLikelihoodOfCounts(double phi, double count0, double count1, double M, double theta)
+{
+	double	halfPhase = M * (phi - theta) / 2;
+	double	cosine = cos(halfPhase);
+	double	sine = sin(halfPhase);
+
+	return ((count0 > 0) ? count0 * log(cosine * cosine) : 0.0) + ((count1 > 0) ? count1 * log(sine * sine) : 0.0);
+}
+
+/*
+ *	Weights exp(deltaBeta * (l - maxOfLogLikelihoods)) of raising the power
+ *	of the likelihood by deltaBeta, and their effective sample size.
+ */
+static double
+reweightTemperedRFPE(TemperedRFPE *  tempered, double deltaBeta, double maxOfLogLikelihoods)
+{
+	double	sum = 0.0;
+	double	sumOfSquares = 0.0;
+	size_t	i;
+
+	for (i = 0; i < tempered->numberOfParticles; i++)
+	{
+		tempered->weights[i] = exp(deltaBeta * (tempered->logLikelihoods[i] - maxOfLogLikelihoods));
+		sum += tempered->weights[i];
+		sumOfSquares += tempered->weights[i] * tempered->weights[i];
+	}
+
+	return (sumOfSquares > 0.0) ? (sum * sum / sumOfSquares) : 0.0;
+}
+
+TemperedRFPE *
+allocTemperedRFPE(size_t numberOfParticles)
+{
+	TemperedRFPE *	tempered = (TemperedRFPE *) calloc(1, sizeof(TemperedRFPE));
+
+	tempered->numberOfParticles = numberOfParticles;
+	tempered->particles = (double *) malloc(numberOfParticles * sizeof(double));
+	tempered->logLikelihoods = (double *) malloc(numberOfParticles * sizeof(double));
+	tempered->weights = (double *) malloc(numberOfParticles * sizeof(double));
+	tempered->resampledParticles = (double *) malloc(numberOfParticles * sizeof(double));
+	tempered->resampledLogLikelihoods = (double *) malloc(numberOfParticles * sizeof(double));
+
+	return tempered;
+}
+
+void
+freeTemperedRFPE(TemperedRFPE *  tempered)
+{
+	free(tempered->particles);
+	free(tempered->logLikelihoods);
+	free(tempered->weights);
+	free(tempered->resampledParticles);
+	free(tempered->resampledLogLikelihoods);
+	free(tempered);
+}
+
+size_t
+doTemperedRFPE(TemperedRFPE *  tempered, const uint64_t *  evidenceSampleCounts, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG)
+{
+	const size_t	numberOfParticles = tempered->numberOfParticles;
+	const double	count0 = (double) evidenceSampleCounts[0];
+	const double	count1 = (double) evidenceSampleCounts[1];
+	const double	priorMeanValue = *meanValue;
+	const double	priorStandardDeviation = *standardDeviation;
+	double		effectiveSampleSize = 0.0;
+	double		beta = 0.0;
+	double		sum;
+	double		sumOfSquares;
+	size_t		i;
+
+	sampleFromRestrictedGaussian(priorMeanValue, priorStandardDeviation, tempered->particles, numberOfParticles, gslRNG);
+	for (i = 0; i < numberOfParticles; i++)
+	{
+		tempered->logLikelihoods[i] = logLikelihoodOfCounts(tempered->particles[i], count0, count1, M, theta);
+	}
+
+	/*
+	 *	The posterior is reached through prior x likelihood^beta for a rising
+	 *	sequence of beta. Each stage picks the largest beta that keeps the
+	 *	effective sample size of the reweighted particles above the target,
+	 *	resamples the particles by their weights, and moves each of them with
+	 *	Metropolis steps that leave prior x likelihood^beta invariant, so that
+	 *	the copies of a particle spread out again. With a peaked likelihood,
+	 *	a single rejection pass would keep only a handful of samples.
+	 */
+	for (tempered->numberOfStages = 0; (beta < 1.0) && (tempered->numberOfStages < kTemperedMaximumNumberOfStages); tempered->numberOfStages++)
+	{
+		double	targetEffectiveSampleSize = kTemperedEffectiveSampleSizeFraction * numberOfParticles;
+		double	maxOfLogLikelihoods = -INFINITY;
+		double	deltaBeta = 1.0 - beta;
+		double	weightedMean = 0.0;
+		double	weightedVariance = 0.0;
+		double	proposalStandardDeviation;
+		double	cumulativeWeight;
+		double	totalWeight = 0.0;
+		double	position;
+		size_t	j;
+		size_t	step;
+
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			maxOfLogLikelihoods = (tempered->logLikelihoods[i] > maxOfLogLikelihoods) ? tempered->logLikelihoods[i] : maxOfLogLikelihoods;
+		}
+
+		if (!isfinite(maxOfLogLikelihoods))
+		{
+			*meanValue = priorMeanValue;
+			*standardDeviation = priorStandardDeviation;
+
+			return 0;
+		}
+
+		/*
+		 *	Bisect for the step of beta whose effective sample size meets
+		 *	the target, unless the rest of the way to beta = 1 meets it.
+		 */
+		if (reweightTemperedRFPE(tempered, deltaBeta, maxOfLogLikelihoods) < targetEffectiveSampleSize)
+		{
+			double	lowerDeltaBeta = 0.0;
+			double	upperDeltaBeta = deltaBeta;
+			size_t	bisection;
+
+			for (bisection = 0; bisection < kTemperedBisectionSteps; bisection++)
+			{
+				deltaBeta = (lowerDeltaBeta + upperDeltaBeta) / 2;
+
+				if (reweightTemperedRFPE(tempered, deltaBeta, maxOfLogLikelihoods) < targetEffectiveSampleSize)
+				{
+					upperDeltaBeta = deltaBeta;
+				}
+				else
+				{
+					lowerDeltaBeta = deltaBeta;
+				}
+			}
+			deltaBeta = fmax(lowerDeltaBeta, DBL_EPSILON);
+		}
+		effectiveSampleSize = reweightTemperedRFPE(tempered, deltaBeta, maxOfLogLikelihoods);
+		beta = (deltaBeta >= 1.0 - beta) ? 1.0 : beta + deltaBeta;
+
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			totalWeight += tempered->weights[i];
+			weightedMean += tempered->weights[i] * tempered->particles[i];
+		}
+		weightedMean /= totalWeight;
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			weightedVariance += tempered->weights[i] * (tempered->particles[i] - weightedMean) * (tempered->particles[i] - weightedMean);
+		}
+		weightedVariance /= totalWeight;
+
+		/*
+		 *	Systematic resampling: one uniform offset, and particle i is
+		 *	copied once for every grid point in its share of the weight.
+		 */
+		position = gsl_ran_flat(gslRNG, 0.0, 1.0) * totalWeight / numberOfParticles;
+		cumulativeWeight = tempered->weights[0];
+		for (i = 0, j = 0; i < numberOfParticles; i++)
+		{
+			while ((position > cumulativeWeight) && (j < numberOfParticles - 1))
+			{
+				j++;
+				cumulativeWeight += tempered->weights[j];
+			}
+			tempered->resampledParticles[i] = tempered->particles[j];
+			tempered->resampledLogLikelihoods[i] = tempered->logLikelihoods[j];
+			position += totalWeight / numberOfParticles;
+		}
+
+		/*
+		 *	Random-walk Metropolis steps on prior x likelihood^beta, with the
+		 *	step size that is optimal for a Gaussian target in one dimension.
+		 */
+		proposalStandardDeviation = 2.38 * sqrt(weightedVariance);
+		for (i = 0; i < numberOfParticles; i++)
+		{
+			double	particle = tempered->resampledParticles[i];
+			double	logLikelihood = tempered->resampledLogLikelihoods[i];
+
+			for (step = 0; step < kTemperedRejuvenationSteps; step++)
+			{
+				double	proposal = particle + gsl_ran_gaussian(gslRNG, proposalStandardDeviation);
+				double	proposalLogLikelihood;
+				double	logAcceptance;
+
+				if (fabs(proposal) >= M_PI)
+				{
+					continue;
+				}
+
+				proposalLogLikelihood = logLikelihoodOfCounts(proposal, count0, count1, M, theta);
+				logAcceptance = beta * (proposalLogLikelihood - logLikelihood)
+						- ((proposal - priorMeanValue) * (proposal - priorMeanValue) - (particle - priorMeanValue) * (particle - priorMeanValue)) / (2 * priorStandardDeviation * priorStandardDeviation);
+
+				if (log(gsl_ran_flat(gslRNG, 0.0, 1.0)) <= logAcceptance)
+				{
+					particle = proposal;
+					logLikelihood = proposalLogLikelihood;
+				}
+			}
+			tempered->particles[i] = particle;
+			tempered->logLikelihoods[i] = logLikelihood;
+		}
+	}
+
+	sum = 0.0;
+	sumOfSquares = 0.0;
+	for (i = 0; i < numberOfParticles; i++)
+	{
+		sum += tempered->particles[i];
+		sumOfSquares += tempered->particles[i] * tempered->particles[i];
+	}
+	*meanValue = sum / numberOfParticles;
+	*standardDeviation = sqrt(fmax((sumOfSquares / numberOfParticles) - (*meanValue * *meanValue), 0.0));
+	*standardDeviation *= kPosteriorStandardDeviationIncreaseFactor;
+
+	return (size_t) lround(effectiveSampleSize);
+}
+
+double
+temperedRFPEMassWithin(const TemperedRFPE *  tempered, double center, double halfWidth)
+{
+	size_t	numberWithin = 0;
+	size_t	i;
+
+	for (i = 0; i < tempered->numberOfParticles; i++)
+	{
+		numberWithin += (fabs(tempered->particles[i] - center) <= halfWidth);
+	}
+
+	return (double) numberWithin / tempered->numberOfParticles;
+}
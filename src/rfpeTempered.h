@@ -0,0 +1,107 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <gsl/gsl_rng.h>
+
+typedef enum
+{
+	kTemperedMaximumNumberOfStages = 64,
+	kTemperedRejuvenationSteps = 4,
+	kTemperedBisectionSteps = 24,
+} TemperedRFPEConstants;
+
+/*
+ *	Each stage raises the power of the likelihood as far as the effective
+ *	sample size of the reweighted particles stays above this fraction of
+ *	their number.
+ */
+static const double	kTemperedEffectiveSampleSizeFraction = 0.5;
+
+/*
+ *	Particles of a tempered RFPE update and the scratch arrays of its
+ *	resampling. numberOfStages is the number of stages of the last update.
+ */
+typedef struct TemperedRFPE
+{
+	size_t		numberOfParticles;
+	double *	particles;
+	double *	logLikelihoods;
+	double *	weights;
+	double *	resampledParticles;
+	double *	resampledLogLikelihoods;
+	size_t		numberOfStages;
+} TemperedRFPE;
+
+/**
+ *	@brief	Allocate the particles of a tempered RFPE update.
+ *
+ *	@param	numberOfParticles	: number of particles, -m
+ *	@return	TemperedRFPE *		: tempered update, release with freeTemperedRFPE()
+ */
+TemperedRFPE *	allocTemperedRFPE(size_t numberOfParticles);
+
+/**
+ *	@brief	Free a tempered update allocated with allocTemperedRFPE().
+ *
+ *	@param	tempered	: tempered update to free
+ */
+void	freeTemperedRFPE(TemperedRFPE *  tempered);
+
+/**
+ *	@brief	Update a Gaussian prior with the counts of a circuit by tempering the likelihood in stages, with resampling and Metropolis moves between stages.
+ *
+ *	@param	tempered		: particles of the update
+ *	@param	evidenceSampleCounts	: counts of outcomes 0 and 1
+ *	@param	M			: number of applications of the unitary in the circuit
+ *	@param	theta			: phase shift of the circuit
+ *	@param	meanValue		: mean value of the prior, output mean value of the posterior
+ *	@param	standardDeviation	: standard deviation of the prior, output standard deviation of the posterior
+ *	@param	gslRNG			: GSL random number generator
+ *	@return	size_t			: effective sample size of the last stage, 0 if the likelihood vanished on all particles
+ */
+size_t	doTemperedRFPE(TemperedRFPE *  tempered, const uint64_t *  evidenceSampleCounts, double M, double theta, double *  meanValue, double *  standardDeviation, gsl_rng *  gslRNG);
+
+/**
+ *	@brief	Fraction of the particles of the last tempered update within halfWidth of a point.
+ *
+ *	@param	tempered	: particles of the update
+ *	@param	center		: center of the interval
+ *	@param	halfWidth	: half of the width of the interval
+ *	@return	double		: posterior mass in [center - halfWidth, center + halfWidth]
+ */
+double	temperedRFPEMassWithin(const TemperedRFPE *  tempered, double center, double halfWidth);
@@ -0,0 +1,452 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "scheduler.h"
+
+/*
+ *	Suspended experiment waiting in the queue of a worker, ordered by its
+ *	expected remaining number of iterations.
+ */
+typedef struct SchedulerTask
+{
+	size_t	experimentIndex;
+	double	expectedRemainingIterations;
+} SchedulerTask;
+
+typedef struct SchedulerQueue
+{
+	pthread_mutex_t	mutex;
+	SchedulerTask *	tasks;
+	size_t		numberOfTasks;
+} SchedulerQueue;
+
+typedef struct SchedulerJob
+{
+	const CommandLineArguments *	arguments;
+	AQPEExperiment *		experiments;
+	ResultStream *			resultStream;
+	double				initialMeanValue;
+	double				initialStandardDeviation;
+	double				freshTaskExpectedIterations;
+	SchedulerQueue *		queues;
+	size_t				numberOfThreads;
+	atomic_size_t			nextExperiment;
+	atomic_size_t			numberOfUnfinishedExperiments;
+} SchedulerJob;
+
+typedef struct SchedulerWorker
+{
+	SchedulerJob *		job;
+	size_t			workerIndex;
+	unsigned long		randomSeed;
+	double			busyTime;
+	double			finishTime;
+	size_t			numberOfSlices;
+	size_t			numberOfSteals;
+	ConvergenceCurves *	convergenceCurves;
+} SchedulerWorker;
+
+static double
+monotonicTime(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ *	Predict the number of iterations an experiment still needs. Before the
+ *	first iteration, the contraction of the posterior width per iteration is
+ *	taken from the Fisher information N M^2 of the next circuit, capped at
+ *	sqrt(m) since rejection filtering with m prior samples cannot resolve a
+ *	much narrower posterior. Afterwards, it is the geometric mean of the
+ *	contraction observed so far. Experiments whose posterior did not contract
+ *	during the last slice are expected to run to kMaxNumberOfIterations.
+ */
+static double
+expectedRemainingIterations(const AQPEExperiment *  experiment, const CommandLineArguments *  arguments, double initialStandardDeviation, double sliceStartStandardDeviation)
+{
+	double	standardDeviation = experiment->standardDeviation;
+	double	remainingLimit = (double) (kMaxNumberOfIterations - experiment->numberOfIterations);
+	double	contraction;
+
+	if (!isfinite(standardDeviation) || (standardDeviation >= sliceStartStandardDeviation))
+	{
+		return remainingLimit;
+	}
+
+	if (standardDeviation < arguments->precision)
+	{
+		return 0.0;
+	}
+
+	if (experiment->numberOfIterations == 0)
+	{
+		double	M = calculateM(standardDeviation, arguments->alpha);
+
+		contraction = fmin(sqrt(1 + arguments->numberOfEvidenceSamplesPerIteration * M * M * standardDeviation * standardDeviation), sqrt((double) arguments->numberOfPriorTestSamplesPerIteration));
+	}
+	else
+	{
+		contraction = pow(initialStandardDeviation / standardDeviation, 1.0 / experiment->numberOfIterations);
+	}
+
+	if (contraction <= 1.0 + 1e-3)
+	{
+		return remainingLimit;
+	}
+
+	return fmin(ceil(log(standardDeviation / arguments->precision) / log(contraction)), remainingLimit);
+}
+
+/*
+ *	Binary max-heap on the expected remaining number of iterations.
+ */
+static void
+pushSchedulerTask(SchedulerQueue *  queue, SchedulerTask task)
+{
+	size_t	i = queue->numberOfTasks++;
+
+	while (i > 0 && queue->tasks[(i - 1) / 2].expectedRemainingIterations < task.expectedRemainingIterations)
+	{
+		queue->tasks[i] = queue->tasks[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	queue->tasks[i] = task;
+}
+
+static SchedulerTask
+popSchedulerTask(SchedulerQueue *  queue)
+{
+	SchedulerTask	top = queue->tasks[0];
+	SchedulerTask	last = queue->tasks[--queue->numberOfTasks];
+	size_t		i = 0;
+
+	for (;;)
+	{
+		size_t	child = 2 * i + 1;
+
+		if (child >= queue->numberOfTasks)
+		{
+			break;
+		}
+		if ((child + 1 < queue->numberOfTasks) && (queue->tasks[child + 1].expectedRemainingIterations > queue->tasks[child].expectedRemainingIterations))
+		{
+			child++;
+		}
+		if (queue->tasks[child].expectedRemainingIterations <= last.expectedRemainingIterations)
+		{
+			break;
+		}
+		queue->tasks[i] = queue->tasks[child];
+		i = child;
+	}
+	if (queue->numberOfTasks > 0)
+	{
+		queue->tasks[i] = last;
+	}
+
+	return top;
+}
+
+/*
+ *	Take the longest expected task, either from the own queue or as a fresh
+ *	experiment. When both are exhausted, steal the longest expected task of
+ *	the other workers.
+ */
+static bool
+takeSchedulerTask(SchedulerWorker *  worker, SchedulerTask *  task)
+{
+	SchedulerJob *		job = worker->job;
+	SchedulerQueue *	ownQueue = &job->queues[worker->workerIndex];
+	SchedulerQueue *	victimQueue = NULL;
+	double			victimExpectedRemainingIterations = -1.0;
+	size_t			i;
+
+	pthread_mutex_lock(&ownQueue->mutex);
+	if ((ownQueue->numberOfTasks > 0) && ((ownQueue->tasks[0].expectedRemainingIterations >= job->freshTaskExpectedIterations) || (atomic_load(&job->nextExperiment) >= job->arguments->numberOfRepetitions)))
+	{
+		*task = popSchedulerTask(ownQueue);
+		pthread_mutex_unlock(&ownQueue->mutex);
+
+		return true;
+	}
+	pthread_mutex_unlock(&ownQueue->mutex);
+
+	task->experimentIndex = atomic_fetch_add(&job->nextExperiment, 1);
+	if (task->experimentIndex < job->arguments->numberOfRepetitions)
+	{
+		task->expectedRemainingIterations = job->freshTaskExpectedIterations;
+		initAQPEExperiment(&job->experiments[task->experimentIndex], job->initialMeanValue, job->initialStandardDeviation, task->experimentIndex + 1, job->arguments);
+
+		return true;
+	}
+
+	pthread_mutex_lock(&ownQueue->mutex);
+	if (ownQueue->numberOfTasks > 0)
+	{
+		*task = popSchedulerTask(ownQueue);
+		pthread_mutex_unlock(&ownQueue->mutex);
+
+		return true;
+	}
+	pthread_mutex_unlock(&ownQueue->mutex);
+
+	for (i = 0; i < job->numberOfThreads; i++)
+	{
+		SchedulerQueue *	queue = &job->queues[i];
+
+		pthread_mutex_lock(&queue->mutex);
+		if ((queue->numberOfTasks > 0) && (queue->tasks[0].expectedRemainingIterations > victimExpectedRemainingIterations))
+		{
+			victimQueue = queue;
+			victimExpectedRemainingIterations = queue->tasks[0].expectedRemainingIterations;
+		}
+		pthread_mutex_unlock(&queue->mutex);
+	}
+
+	if (victimQueue != NULL)
+	{
+		bool	stolen = false;
+
+		pthread_mutex_lock(&victimQueue->mutex);
+		if (victimQueue->numberOfTasks > 0)
+		{
+			*task = popSchedulerTask(victimQueue);
+			stolen = true;
+		}
+		pthread_mutex_unlock(&victimQueue->mutex);
+
+		if (stolen)
+		{
+			worker->numberOfSteals++;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void *
+schedulerWorker(void *  argument)
+{
+	SchedulerWorker *	worker = (SchedulerWorker *) argument;
+	SchedulerJob *		job = worker->job;
+	SchedulerQueue *	ownQueue = &job->queues[worker->workerIndex];
+	gsl_rng *		gslRNG;
+	AQPEWorkspace *		workspace;
+	ResultStreamWriter *	resultStream = (job->resultStream != NULL) ? &job->resultStream->writers[worker->workerIndex] : NULL;
+	SchedulerTask		task;
+
+	gslRNG = gsl_rng_alloc(gsl_rng_default);
+	gsl_rng_set(gslRNG, worker->randomSeed);
+	workspace = allocAQPEWorkspace(job->arguments);
+
+	/*
+	 *	Static scheduling runs a contiguous chunk of experiments per worker to completion.
+	 */
+	if (job->arguments->schedulerPolicy == kSchedulerPolicyStatic)
+	{
+		size_t	chunkBegin = worker->workerIndex * job->arguments->numberOfRepetitions / job->numberOfThreads;
+		size_t	chunkEnd = (worker->workerIndex + 1) * job->arguments->numberOfRepetitions / job->numberOfThreads;
+		size_t	i;
+
+		for (i = chunkBegin; i < chunkEnd; i++)
+		{
+			double	startTime = monotonicTime();
+
+			initAQPEExperiment(&job->experiments[i], job->initialMeanValue, job->initialStandardDeviation, i + 1, job->arguments);
+			stepAQPEExperiment(&job->experiments[i], job->arguments, kMaxNumberOfIterations, workspace, gslRNG, resultStream);
+			reportAQPEExperiment(&job->experiments[i], job->arguments);
+			worker->busyTime += monotonicTime() - startTime;
+			worker->numberOfSlices++;
+		}
+		atomic_fetch_sub(&job->numberOfUnfinishedExperiments, chunkEnd - chunkBegin);
+	}
+	else
+	{
+		while (atomic_load(&job->numberOfUnfinishedExperiments) > 0)
+		{
+			AQPEExperiment *	experiment;
+			double			sliceStartStandardDeviation;
+			double			startTime;
+
+			if (!takeSchedulerTask(worker, &task))
+			{
+				/*
+				 *	The remaining experiments are running on other workers.
+				 */
+				sched_yield();
+				continue;
+			}
+
+			experiment = &job->experiments[task.experimentIndex];
+			sliceStartStandardDeviation = experiment->standardDeviation;
+
+			startTime = monotonicTime();
+			stepAQPEExperiment(experiment, job->arguments, kSchedulerSliceIterations, workspace, gslRNG, resultStream);
+			worker->busyTime += monotonicTime() - startTime;
+			worker->numberOfSlices++;
+
+			if (isAQPEExperimentFinished(experiment))
+			{
+				reportAQPEExperiment(experiment, job->arguments);
+				atomic_fetch_sub(&job->numberOfUnfinishedExperiments, 1);
+			}
+			else
+			{
+				task.expectedRemainingIterations = expectedRemainingIterations(experiment, job->arguments, job->initialStandardDeviation, sliceStartStandardDeviation);
+
+				pthread_mutex_lock(&ownQueue->mutex);
+				pushSchedulerTask(ownQueue, task);
+				pthread_mutex_unlock(&ownQueue->mutex);
+			}
+		}
+	}
+
+	worker->finishTime = monotonicTime();
+
+	/*
+	 *	The curves of the worker outlive its workspace until they are merged.
+	 */
+	worker->convergenceCurves = workspace->convergenceCurves;
+	workspace->convergenceCurves = NULL;
+	freeAQPEWorkspace(workspace);
+	gsl_rng_free(gslRNG);
+
+	return NULL;
+}
+
+void
+runAQPEExperimentsInParallel(double initialMeanValue, double initialStandardDeviation, const CommandLineArguments *  arguments, gsl_rng *  gslRNG, ResultStream *  resultStream, ConvergenceCurves *  convergenceCurves, AQPEExperiment *  experiments, SchedulerStatistics *  statistics)
+{
+	SchedulerJob		job;
+	SchedulerWorker *	workers;
+	pthread_t *		threads;
+	AQPEExperiment		freshExperiment = {.standardDeviation = initialStandardDeviation};
+	double			startTime;
+	double			firstFinishTime = INFINITY;
+	double			lastFinishTime = 0.0;
+	size_t			numberOfThreads = arguments->numberOfThreads;
+	size_t			i;
+
+	job.arguments = arguments;
+	job.experiments = experiments;
+	job.resultStream = resultStream;
+	job.initialMeanValue = initialMeanValue;
+	job.initialStandardDeviation = initialStandardDeviation;
+	job.freshTaskExpectedIterations = expectedRemainingIterations(&freshExperiment, arguments, initialStandardDeviation, INFINITY);
+	job.numberOfThreads = numberOfThreads;
+	job.queues = (SchedulerQueue *) malloc(numberOfThreads * sizeof(SchedulerQueue));
+	atomic_init(&job.nextExperiment, 0);
+	atomic_init(&job.numberOfUnfinishedExperiments, arguments->numberOfRepetitions);
+
+	/*
+	 *	A queue never holds more than the experiments of the run.
+	 */
+	for (i = 0; i < numberOfThreads; i++)
+	{
+		pthread_mutex_init(&job.queues[i].mutex, NULL);
+		job.queues[i].tasks = (SchedulerTask *) malloc(arguments->numberOfRepetitions * sizeof(SchedulerTask));
+		job.queues[i].numberOfTasks = 0;
+	}
+
+	workers = (SchedulerWorker *) calloc(numberOfThreads, sizeof(SchedulerWorker));
+	threads = (pthread_t *) malloc(numberOfThreads * sizeof(pthread_t));
+
+	startTime = monotonicTime();
+	for (i = 0; i < numberOfThreads; i++)
+	{
+		workers[i].job = &job;
+		workers[i].workerIndex = i;
+		workers[i].randomSeed = gsl_rng_get(gslRNG) + 1;
+		pthread_create(&threads[i], NULL, schedulerWorker, &workers[i]);
+	}
+
+	*statistics = (SchedulerStatistics) {0};
+	for (i = 0; i < numberOfThreads; i++)
+	{
+		pthread_join(threads[i], NULL);
+		statistics->totalBusyTime += workers[i].busyTime;
+		statistics->numberOfSlices += workers[i].numberOfSlices;
+		statistics->numberOfSteals += workers[i].numberOfSteals;
+		firstFinishTime = fmin(firstFinishTime, workers[i].finishTime);
+		lastFinishTime = fmax(lastFinishTime, workers[i].finishTime);
+
+		if (workers[i].convergenceCurves != NULL)
+		{
+			if (convergenceCurves != NULL)
+			{
+				mergeConvergenceCurves(convergenceCurves, workers[i].convergenceCurves);
+			}
+			freeConvergenceCurves(workers[i].convergenceCurves);
+		}
+	}
+	statistics->wallTime = lastFinishTime - startTime;
+	statistics->tailTime = lastFinishTime - firstFinishTime;
+
+	for (i = 0; i < numberOfThreads; i++)
+	{
+		pthread_mutex_destroy(&job.queues[i].mutex);
+		free(job.queues[i].tasks);
+	}
+	free(job.queues);
+	free(threads);
+	free(workers);
+}
+
+void
+printSchedulerStatistics(const SchedulerStatistics *  statistics, const CommandLineArguments *  arguments)
+{
+	if (arguments->schedulerPolicy == kSchedulerPolicyStatic)
+	{
+		printf("\nScheduled %zu AQPE experiments on %zu threads in static chunks.\n", arguments->numberOfRepetitions, arguments->numberOfThreads);
+	}
+	else
+	{
+		printf("\nScheduled %zu AQPE experiments on %zu threads longest-expected-first in %zu slices of up to %d iterations with %zu steals.\n", arguments->numberOfRepetitions, arguments->numberOfThreads, statistics->numberOfSlices, kSchedulerSliceIterations, statistics->numberOfSteals);
+	}
+	printf("Wall time %le s, thread utilization %.1lf%%, tail time between the first and the last thread finishing %le s.\n", statistics->wallTime, 100 * statistics->totalBusyTime / (statistics->wallTime * arguments->numberOfThreads), statistics->tailTime);
+}
@@ -0,0 +1,77 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <gsl/gsl_rng.h>
+#include "aqpe.h"
+#include "convergenceCurves.h"
+#include "utilities.h"
+
+typedef enum
+{
+	kSchedulerSliceIterations = 4,
+} SchedulerConstants;
+
+typedef struct SchedulerStatistics
+{
+	double	wallTime;
+	double	totalBusyTime;
+	double	tailTime;
+	size_t	numberOfSlices;
+	size_t	numberOfSteals;
+} SchedulerStatistics;
+
+/**
+ *	@brief	Run the AQPE experiments of a run on several threads.
+ *
+ *	@param	initialMeanValue		: mean value of the initial prior
+ *	@param	initialStandardDeviation	: standard deviation of the initial prior
+ *	@param	arguments			: command line arguments
+ *	@param	gslRNG				: GSL random number generator used to seed the workers
+ *	@param	resultStream			: stream with one ring per worker to publish iterations to, or NULL
+ *	@param	convergenceCurves		: curves to add the iterations of all workers to, or NULL
+ *	@param	experiments			: output array of numberOfRepetitions finished experiments
+ *	@param	statistics			: output scheduler statistics
+ */
+void	runAQPEExperimentsInParallel(double initialMeanValue, double initialStandardDeviation, const CommandLineArguments *  arguments, gsl_rng *  gslRNG, ResultStream *  resultStream, ConvergenceCurves *  convergenceCurves, AQPEExperiment *  experiments, SchedulerStatistics *  statistics);
+
+/**
+ *	@brief	Print the scheduler statistics of a run.
+ *
+ *	@param	statistics	: scheduler statistics
+ *	@param	arguments	: command line arguments
+ */
+void	printSchedulerStatistics(const SchedulerStatistics *  statistics, const CommandLineArguments *  arguments);
@@ -0,0 +1,349 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shotRecord.h"
+
+const char	kShotRecordMagic[8] = {'A', 'Q', 'P', 'E', 'S', 'H', 'T', '1'};
+
+static inline uint64_t
+rotateLeft(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t
+nextShotRandom(ShotRNG *  rng)
+{
+	uint64_t	result = rotateLeft(rng->state[1] * 5, 7) * 9;
+	uint64_t	t = rng->state[1] << 17;
+
+	rng->state[2] ^= rng->state[0];
+	rng->state[3] ^= rng->state[1];
+	rng->state[1] ^= rng->state[2];
+	rng->state[0] ^= rng->state[3];
+	rng->state[2] ^= t;
+	rng->state[3] = rotateLeft(rng->state[3], 45);
+
+	return result;
+}
+
+void
+seedShotRNG(ShotRNG *  rng, uint64_t seed)
+{
+	size_t	i;
+
+	for (i = 0; i < 4; i++)
+	{
+		uint64_t	z = (seed += UINT64_C(0x9E3779B97F4A7C15));
+
+		z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+		z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+		rng->state[i] = z ^ (z >> 31);
+	}
+}
+
+/*
+ *	Fixed-point threshold t such that a uniform 64-bit word U has U < t with
+ *	the given probability, to within 2^-64.
+ */
+static uint64_t
+probabilityToThreshold(double probability)
+{
+	if (!(probability > 0.0))
+	{
+		return 0;
+	}
+	if (probability >= 1.0)
+	{
+		return UINT64_MAX;
+	}
+
+	return (uint64_t) ldexp(probability, 64);
+}
+
+/*
+ *	64 Bernoulli shots at once. Shot i has outcome 1 when its uniform U_i is
+ *	below the threshold. U_i is compared with the threshold one bit at a time
+ *	from the most significant bit, with bit k of every U_i in one random word:
+ *	the shots whose bit differs from the bit of the threshold are decided, and
+ *	half of the undecided shots are decided with every word. A word of shots
+ *	thus costs about log2(64) + 2 random words rather than 64 uniforms, and
+ *	the comparison is exact for the 64-bit threshold.
+ */
+static inline uint64_t
+generateBernoulliWord(ShotRNG *  rng, uint64_t threshold)
+{
+	uint64_t	undecided = UINT64_MAX;
+	uint64_t	word = 0;
+	int		bit;
+
+	for (bit = 63; (bit >= 0) && (undecided != 0) && ((threshold << (63 - bit)) != 0); bit--)
+	{
+		uint64_t	random = nextShotRandom(rng);
+		uint64_t	thresholdBit = -((threshold >> bit) & 1);
+
+		word |= undecided & ~random & thresholdBit;
+		undecided &= ~(random ^ thresholdBit);
+	}
+
+	return word;
+}
+
+/*
+ *	64 consecutive flips of the Markov chain. Shot i flips with probability
+ *	b if shot i - 1 flipped and a otherwise, so its flip is the map
+ *	f_i(x) = x ? B_i : A_i of the previous flip, with Bernoulli words A and B.
+ *	The composed maps f_i o ... o f_0 are found for all 64 shots with a
+ *	parallel prefix over the bits, in 6 steps.
+ */
+static inline uint64_t
+generateFlipWord(ShotRecordGenerator *  generator)
+{
+	uint64_t	flipAfterNoFlip = generateBernoulliWord(&generator->rng, generator->flipOnsetThreshold);
+	uint64_t	flipAfterFlip = generateBernoulliWord(&generator->rng, generator->flipPersistenceThreshold);
+	uint64_t	flips;
+	int		shift;
+
+	for (shift = 1; shift < kShotRecordShotsPerWord; shift <<= 1)
+	{
+		uint64_t	earlierAfterNoFlip = flipAfterNoFlip << shift;
+		uint64_t	earlierAfterFlip = flipAfterFlip << shift;
+		uint64_t	unchanged = (UINT64_C(1) << shift) - 1;
+		uint64_t	composedAfterNoFlip = (earlierAfterNoFlip & flipAfterFlip) | (~earlierAfterNoFlip & flipAfterNoFlip);
+		uint64_t	composedAfterFlip = (earlierAfterFlip & flipAfterFlip) | (~earlierAfterFlip & flipAfterNoFlip);
+
+		flipAfterNoFlip = composedAfterNoFlip;
+		flipAfterFlip = (composedAfterFlip & ~unchanged) | (flipAfterFlip & unchanged);
+	}
+
+	flips = generator->previousFlip ? flipAfterFlip : flipAfterNoFlip;
+	generator->previousFlip = flips >> 63;
+
+	return flips;
+}
+
+void
+initShotRecordGenerator(ShotRecordGenerator *  generator, double probabilityOfOne, const ShotNoise *  noise)
+{
+	double	flipProbability = (noise != NULL) ? noise->flipProbability : 0.0;
+	double	correlation = (noise != NULL) ? noise->correlation : 0.0;
+
+	generator->correlated = (flipProbability > 0.0) && (correlation > 0.0);
+
+	if (generator->correlated)
+	{
+		generator->oneThreshold = probabilityToThreshold(probabilityOfOne);
+		generator->flipOnsetThreshold = probabilityToThreshold(flipProbability * (1 - correlation));
+		generator->flipPersistenceThreshold = probabilityToThreshold(flipProbability + correlation * (1 - flipProbability));
+
+		/*
+		 *	Start the chain from its stationary distribution.
+		 */
+		generator->previousFlip = generateBernoulliWord(&generator->rng, probabilityToThreshold(flipProbability)) & 1;
+	}
+	else
+	{
+		/*
+		 *	Independent flips only change the probability of outcome 1.
+		 */
+		generator->oneThreshold = probabilityToThreshold(probabilityOfOne * (1 - flipProbability) + (1 - probabilityOfOne) * flipProbability);
+		generator->previousFlip = 0;
+	}
+}
+
+void
+generateShotRecord(ShotRecordGenerator *  generator, uint64_t *  words, uint64_t numberOfShots)
+{
+	size_t	numberOfWords = (numberOfShots + kShotRecordShotsPerWord - 1) / kShotRecordShotsPerWord;
+	size_t	i;
+
+	if (generator->correlated)
+	{
+		for (i = 0; i < numberOfWords; i++)
+		{
+			words[i] = generateBernoulliWord(&generator->rng, generator->oneThreshold) ^ generateFlipWord(generator);
+		}
+	}
+	else
+	{
+		for (i = 0; i < numberOfWords; i++)
+		{
+			words[i] = generateBernoulliWord(&generator->rng, generator->oneThreshold);
+		}
+	}
+
+	if (numberOfShots % kShotRecordShotsPerWord != 0)
+	{
+		words[numberOfWords - 1] &= (UINT64_C(1) << (numberOfShots % kShotRecordShotsPerWord)) - 1;
+	}
+}
+
+uint64_t
+countShotRecordOnes(const uint64_t *  words, uint64_t numberOfShots)
+{
+	size_t		numberOfWords = (numberOfShots + kShotRecordShotsPerWord - 1) / kShotRecordShotsPerWord;
+	uint64_t	numberOfOnes = 0;
+	size_t		i;
+
+	for (i = 0; i < numberOfWords; i++)
+	{
+		numberOfOnes += __builtin_popcountll(words[i]);
+	}
+
+	return numberOfOnes;
+}
+
+uint64_t
+countShotRecordOnePairs(const uint64_t *  words, uint64_t numberOfShots)
+{
+	size_t		numberOfWords = (numberOfShots + kShotRecordShotsPerWord - 1) / kShotRecordShotsPerWord;
+	uint64_t	numberOfPairs = 0;
+	size_t		i;
+
+	for (i = 0; i < numberOfWords; i++)
+	{
+		uint64_t	next = (i + 1 < numberOfWords) ? words[i + 1] : 0;
+
+		numberOfPairs += __builtin_popcountll(words[i] & ((words[i] >> 1) | (next << 63)));
+	}
+
+	return numberOfPairs;
+}
+
+int
+openShotRecordFile(ShotRecordFile *  recordFile, const char *  path)
+{
+	ShotRecordFileHeader	header;
+	long			size;
+
+	*recordFile = (ShotRecordFile) {0};
+
+	recordFile->file = fopen(path, "a+b");
+	if (recordFile->file == NULL)
+	{
+		fprintf(stderr, "\nError: Could not open shot record file '%s'.\n", path);
+
+		return 1;
+	}
+
+	/*
+	 *	The buffer must be set before any other operation on the stream.
+	 */
+	recordFile->buffer = (char *) malloc(kShotRecordBufferSize);
+	setvbuf(recordFile->file, recordFile->buffer, _IOFBF, kShotRecordBufferSize);
+
+	fseek(recordFile->file, 0, SEEK_END);
+	size = ftell(recordFile->file);
+
+	if (size == 0)
+	{
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, kShotRecordMagic, sizeof(header.magic));
+		header.circuitHeaderSize = sizeof(ShotRecordCircuitHeader);
+
+		if (fwrite(&header, sizeof(header), 1, recordFile->file) != 1)
+		{
+			fprintf(stderr, "\nError: Could not write the header of shot record file '%s'.\n", path);
+			fclose(recordFile->file);
+			free(recordFile->buffer);
+
+			return 1;
+		}
+	}
+	else
+	{
+		rewind(recordFile->file);
+
+		if ((fread(&header, sizeof(header), 1, recordFile->file) != 1) || (memcmp(header.magic, kShotRecordMagic, sizeof(header.magic)) != 0) || (header.circuitHeaderSize != sizeof(ShotRecordCircuitHeader)))
+		{
+			fprintf(stderr, "\nError: '%s' is not a shot record file with %zu-byte circuit headers.\n", path, sizeof(ShotRecordCircuitHeader));
+			fclose(recordFile->file);
+			free(recordFile->buffer);
+
+			return 1;
+		}
+
+		/*
+		 *	A write may only follow a read after a repositioning of the
+		 *	stream.
+		 */
+		fseek(recordFile->file, 0, SEEK_END);
+	}
+
+	return 0;
+}
+
+int
+appendShotRecordCircuitHeader(ShotRecordFile *  recordFile, const ShotRecordCircuitHeader *  header)
+{
+	if (fwrite(header, sizeof(*header), 1, recordFile->file) != 1)
+	{
+		fprintf(stderr, "\nError: Could not append to the shot record file.\n");
+
+		return 1;
+	}
+
+	return 0;
+}
+
+int
+appendShotRecordWords(ShotRecordFile *  recordFile, const uint64_t *  words, size_t numberOfWords)
+{
+	if (fwrite(words, sizeof(uint64_t), numberOfWords, recordFile->file) != numberOfWords)
+	{
+		fprintf(stderr, "\nError: Could not append to the shot record file.\n");
+
+		return 1;
+	}
+
+	return 0;
+}
+
+int
+closeShotRecordFile(ShotRecordFile *  recordFile)
+{
+	int	status = (fclose(recordFile->file) == 0) ? 0 : 1;
+
+	if (status)
+	{
+		fprintf(stderr, "\nError: Could not flush the shot record file.\n");
+	}
+
+	free(recordFile->buffer);
+
+	return status;
+}
@@ -0,0 +1,197 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+typedef enum
+{
+	kShotRecordShotsPerWord = 64,
+	kShotRecordChunkNumberOfWords = 4096,
+	kShotRecordBufferSize = 1 << 22,
+} ShotRecordConstants;
+
+/*
+ *	Header at the start of a shot record file, followed by one circuit record
+ *	after another in native byte order.
+ */
+typedef struct ShotRecordFileHeader
+{
+	char		magic[8];
+	uint32_t	circuitHeaderSize;
+	uint32_t	reserved;
+} ShotRecordFileHeader;
+
+/*
+ *	Header of the shots of one circuit. It is followed by
+ *	ceil(numberOfShots / 64) words, with shot i in bit (i mod 64) of word
+ *	i / 64. A set bit is outcome 1, and the padding bits of the last word are
+ *	clear.
+ */
+typedef struct ShotRecordCircuitHeader
+{
+	uint64_t	experimentNo;
+	uint64_t	iteration;
+	double		M;
+	double		theta;
+	double		probabilityOfZero;
+	uint64_t	numberOfShots;
+} ShotRecordCircuitHeader;
+
+_Static_assert(sizeof(ShotRecordCircuitHeader) == 48, "Shot record circuit headers should stay 48 bytes");
+
+/*
+ *	Readout noise that flips outcomes. The flips form a two-state Markov chain
+ *	with stationary flip probability flipProbability and lag-1
+ *	autocorrelation correlation, so a correlation of 0 gives independent flips.
+ */
+typedef struct ShotNoise
+{
+	double	flipProbability;
+	double	correlation;
+} ShotNoise;
+
+/*
+ *	xoshiro256** generator of the shot records, independent of the GSL
+ *	generator so that a whole word of random bits costs a few instructions.
+ */
+typedef struct ShotRNG
+{
+	uint64_t	state[4];
+} ShotRNG;
+
+/*
+ *	Generator of the shots of one circuit, which can be drawn in chunks. The
+ *	probabilities are kept as 64-bit fixed-point thresholds.
+ */
+typedef struct ShotRecordGenerator
+{
+	ShotRNG		rng;
+	uint64_t	oneThreshold;
+	uint64_t	flipOnsetThreshold;
+	uint64_t	flipPersistenceThreshold;
+	bool		correlated;
+	uint64_t	previousFlip;
+} ShotRecordGenerator;
+
+typedef struct ShotRecordFile
+{
+	FILE *	file;
+	char *	buffer;
+} ShotRecordFile;
+
+extern const char	kShotRecordMagic[8];
+
+/**
+ *	@brief	Seed a shot record generator.
+ *
+ *	@param	rng	: generator to seed
+ *	@param	seed	: seed, expanded with splitmix64
+ */
+void	seedShotRNG(ShotRNG *  rng, uint64_t seed);
+
+/**
+ *	@brief	Set up a shot record generator for the shots of one circuit.
+ *
+ *	@param	generator		: generator to set up, whose random state is kept
+ *	@param	probabilityOfOne	: probability of outcome 1 of the noiseless circuit
+ *	@param	noise			: readout noise, or NULL for none
+ */
+void	initShotRecordGenerator(ShotRecordGenerator *  generator, double probabilityOfOne, const ShotNoise *  noise);
+
+/**
+ *	@brief	Draw the next shots of a circuit as packed words.
+ *
+ *	@param	generator	: generator set up with initShotRecordGenerator()
+ *	@param	words		: ceil(numberOfShots / 64) words to fill
+ *	@param	numberOfShots	: number of shots to draw
+ */
+void	generateShotRecord(ShotRecordGenerator *  generator, uint64_t *  words, uint64_t numberOfShots);
+
+/**
+ *	@brief	Count the outcomes 1 in packed shots.
+ *
+ *	@param	words		: packed shots with clear padding bits
+ *	@param	numberOfShots	: number of shots
+ *	@return	uint64_t	: number of outcomes 1
+ */
+uint64_t	countShotRecordOnes(const uint64_t *  words, uint64_t numberOfShots);
+
+/**
+ *	@brief	Count the pairs of consecutive shots that both have outcome 1.
+ *
+ *	@param	words		: packed shots with clear padding bits
+ *	@param	numberOfShots	: number of shots
+ *	@return	uint64_t	: number of pairs (i, i + 1) with both outcomes 1
+ */
+uint64_t	countShotRecordOnePairs(const uint64_t *  words, uint64_t numberOfShots);
+
+/**
+ *	@brief	Open a shot record file for appending, writing the header if the file is new.
+ *
+ *	@param	recordFile	: file to initialize
+ *	@param	path		: path of the file
+ *	@return	int		: 0 if successful, else 1
+ */
+int	openShotRecordFile(ShotRecordFile *  recordFile, const char *  path);
+
+/**
+ *	@brief	Append the header of a circuit, to be followed by its words.
+ *
+ *	@param	recordFile	: file opened with openShotRecordFile()
+ *	@param	header		: header of the circuit
+ *	@return	int		: 0 if successful, else 1
+ */
+int	appendShotRecordCircuitHeader(ShotRecordFile *  recordFile, const ShotRecordCircuitHeader *  header);
+
+/**
+ *	@brief	Append words of shots of the circuit whose header was appended last.
+ *
+ *	@param	recordFile	: file opened with openShotRecordFile()
+ *	@param	words		: packed shots
+ *	@param	numberOfWords	: number of words
+ *	@return	int		: 0 if successful, else 1
+ */
+int	appendShotRecordWords(ShotRecordFile *  recordFile, const uint64_t *  words, size_t numberOfWords);
+
+/**
+ *	@brief	Flush and close a shot record file.
+ *
+ *	@param	recordFile	: file to close
+ *	@return	int		: 0 if successful, else 1
+ */
+int	closeShotRecordFile(ShotRecordFile *  recordFile);
@@ -40,16 +40,139 @@
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
+#include "aqpe.h"
+#include "realTime.h"
 #include "utilities.h"
 
 const double	kMinimumAlpha = 0.0;
 const double	kMaximumAlpha = 1.0;
 const double	kMinimumPhi = -M_PI;
 const double	kMaximumPhi = M_PI;
-const double	kMinimumPrecision = 1e-10;
+const double	kMinimumPrecision = 1e-14;
 const double	kMaximumPrecision = 1.0;
+const double	kMinimumPrecisionWithoutOffsets = 1e-8;
 const uint64_t	kMaximumNumberOfEvidenceSamples = 1000000;
 
+/*
+ *	Long-only options are identified by values outside the range of short option characters.
+ */
+typedef enum
+{
+	kLongOptionThreads = 256,
+	kLongOptionScheduler,
+	kLongOptionPredictCost,
+	kLongOptionRefreshCostTable,
+	kLongOptionBenchmarkPipelines,
+	kLongOptionMixturePhases,
+	kLongOptionMixtureWeights,
+	kLongOptionKnownWeights,
+	kLongOptionDecoherenceRate,
+	kLongOptionMaximumDecoherenceRate,
+	kLongOptionEstimateDecoherence,
+	kLongOptionResultLog,
+	kLongOptionResultStream,
+	kLongOptionEfficiency,
+	kLongOptionAbortDivergent,
+	kLongOptionDivergenceWindow,
+	kLongOptionDivergenceSurprise,
+	kLongOptionEngine,
+	kLongOptionShotRecords,
+	kLongOptionReadoutFlip,
+	kLongOptionReadoutCorrelation,
+	kLongOptionShotRecordFile,
+	kLongOptionBenchmarkShots,
+	kLongOptionConvergenceCurves,
+	kLongOptionBenchmarkKernels,
+	kLongOptionBenchmarkBatch,
+	kLongOptionBenchmarkOverlap,
+	kLongOptionRealTime,
+	kLongOptionRealTimePriority,
+	kLongOptionPinCPU,
+	kLongOptionBenchmarkRealTime,
+	kLongOptionBackgroundLoad,
+	kLongOptionStopConfidence,
+	kLongOptionBenchmarkStopping,
+	kLongOptionAncillas,
+	kLongOptionAmplitude,
+	kLongOptionBenchmarkAmplitude,
+	kLongOptionCheckSteadyState,
+} LongOption;
+
+static const struct option	kLongOptions[] = {
+	{"threads",		required_argument,	NULL,	kLongOptionThreads},
+	{"scheduler",		required_argument,	NULL,	kLongOptionScheduler},
+	{"predict-cost",	required_argument,	NULL,	kLongOptionPredictCost},
+	{"refresh-cost-table",	required_argument,	NULL,	kLongOptionRefreshCostTable},
+	{"benchmark-pipelines",	no_argument,		NULL,	kLongOptionBenchmarkPipelines},
+	{"mixture-phases",	required_argument,	NULL,	kLongOptionMixturePhases},
+	{"mixture-weights",	required_argument,	NULL,	kLongOptionMixtureWeights},
+	{"known-weights",	no_argument,		NULL,	kLongOptionKnownWeights},
+	{"decoherence-rate",	required_argument,	NULL,	kLongOptionDecoherenceRate},
+	{"maximum-decoherence-rate",	required_argument,	NULL,	kLongOptionMaximumDecoherenceRate},
+	{"estimate-decoherence",	no_argument,		NULL,	kLongOptionEstimateDecoherence},
+	{"result-log",		required_argument,	NULL,	kLongOptionResultLog},
+	{"result-stream",	required_argument,	NULL,	kLongOptionResultStream},
+	{"efficiency",		no_argument,		NULL,	kLongOptionEfficiency},
+	{"abort-divergent",	no_argument,		NULL,	kLongOptionAbortDivergent},
+	{"divergence-window",	required_argument,	NULL,	kLongOptionDivergenceWindow},
+	{"divergence-surprise",	required_argument,	NULL,	kLongOptionDivergenceSurprise},
+	{"engine",		required_argument,	NULL,	kLongOptionEngine},
+	{"shot-records",	no_argument,		NULL,	kLongOptionShotRecords},
+	{"readout-flip",	required_argument,	NULL,	kLongOptionReadoutFlip},
+	{"readout-correlation",	required_argument,	NULL,	kLongOptionReadoutCorrelation},
+	{"shot-record-file",	required_argument,	NULL,	kLongOptionShotRecordFile},
+	{"benchmark-shots",	no_argument,		NULL,	kLongOptionBenchmarkShots},
+	{"convergence-curves",	required_argument,	NULL,	kLongOptionConvergenceCurves},
+	{"benchmark-kernels",	no_argument,		NULL,	kLongOptionBenchmarkKernels},
+	{"benchmark-batch",	no_argument,		NULL,	kLongOptionBenchmarkBatch},
+	{"benchmark-overlap",	no_argument,		NULL,	kLongOptionBenchmarkOverlap},
+	{"realtime",		no_argument,		NULL,	kLongOptionRealTime},
+	{"realtime-priority",	required_argument,	NULL,	kLongOptionRealTimePriority},
+	{"pin-cpu",		required_argument,	NULL,	kLongOptionPinCPU},
+	{"benchmark-realtime",	no_argument,		NULL,	kLongOptionBenchmarkRealTime},
+	{"background-load",	required_argument,	NULL,	kLongOptionBackgroundLoad},
+	{"stop-confidence",	required_argument,	NULL,	kLongOptionStopConfidence},
+	{"benchmark-stopping",	no_argument,		NULL,	kLongOptionBenchmarkStopping},
+	{"ancillas",		required_argument,	NULL,	kLongOptionAncillas},
+	{"amplitude",		required_argument,	NULL,	kLongOptionAmplitude},
+	{"benchmark-amplitude",	no_argument,		NULL,	kLongOptionBenchmarkAmplitude},
+	{"check-steady-state",	no_argument,		NULL,	kLongOptionCheckSteadyState},
+	{NULL,			0,			NULL,	0},
+};
+
+/*
+ *	Parse a comma-separated list of at most maximumNumberOfValues doubles.
+ *	Returns the number of values, or 0 if the list is malformed.
+ */
+static size_t
+parseListOfDoubles(const char *  list, double *  values, size_t maximumNumberOfValues)
+{
+	const char *	cursor = list;
+	char *		end;
+	size_t		numberOfValues = 0;
+
+	while (numberOfValues < maximumNumberOfValues)
+	{
+		values[numberOfValues++] = strtod(cursor, &end);
+
+		if (end == cursor)
+		{
+			return 0;
+		}
+		if (*end == '\0')
+		{
+			return numberOfValues;
+		}
+		if (*end != ',')
+		{
+			return 0;
+		}
+		cursor = end + 1;
+	}
+
+	return 0;
+}
+
 /**
  *	@brief	Print out command line usage.
  */
@@ -62,16 +185,112 @@ printUsage(void)
 	fprintf(stdout,
 		
 		"[-t <target_phase : double in [-pi, pi]>] (Default: pi / 2)\n"
-		"[-p <precision_in_phase_estimation : double in [%le, %le]>] (Default: 1e-4)\n"
+		"[-p <precision_in_phase_estimation : double in [%le, %le]>] (Default: 1e-4. Precisions below %le require the RFPE or mesh engine without --mixture-phases, --estimate-decoherence, --benchmark-batch or --benchmark-pipelines.)\n"
 		"[-a <alpha : double in [0,1]>] (Default: 0.5)\n"
 		"[-n <number_of_evidence_samples_per_iteration : int in [0, inf)>] (Default: see README.md)\n"
 		"[-m <number_of_prior_test_samples_per_iteration : int in (0, inf)>] (Default: 1000)\n"
 		"[-r <number_of_repetitions : size_t in (0, inf)>] (Default: 1)\n"
 		"[-v] (Verbose mode: Prints details of each repeated AQPE experiment to stdout.)\n"
-		"[-h] (Display this help message.)\n", kMinimumPrecision, kMaximumPrecision);
+		"[--threads <number_of_threads : int in (0, inf)>] (Default: 1)\n"
+		"[--scheduler <lejf | static>] (Scheduling of experiments on threads: longest-expected-job-first with work stealing, or static chunks. Default: lejf)\n"
+		"[--predict-cost <cost_table_file>] (Predict iterations, convergence probability and CPU time per experiment from a cost table, then exit.)\n"
+		"[--refresh-cost-table <cost_table_file>] (Regenerate the cost table using -r experiments per grid cell, then exit.)\n"
+		"[--benchmark-pipelines] (Benchmark the compile-time composed estimator pipelines, which use the update of doRFPE(), against the C path with the split RFPE update, using -r experiments each, then exit.)\n"
+		"[--mixture-phases <phi_1,...,phi_K : doubles in [-pi, pi]>] (Estimate K <= %d eigenphases jointly from a mixed input state.)\n"
+		"[--mixture-weights <w_1,...,w_K : doubles in (0, inf)>] (Weights of the eigenstates in the mixed input state, normalized to sum to 1. Default: equal weights)\n"
+		"[--known-weights] (The estimator knows the weights of the mixed input state instead of estimating them.)\n"
+		"[--decoherence-rate <lambda : double in [0, inf)>] (Simulate a visibility exp(-lambda M) of circuits with M applications of the unitary. Default: 0)\n"
+		"[--estimate-decoherence] (Estimate the eigenphase jointly with the decoherence rate on a 2-D grid posterior.)\n"
+		"[--maximum-decoherence-rate <lambda_max : double in (0, inf)>] (Upper end of the decoherence rate grid. Default: 0.05)\n"
+		"[--result-log <result_log_file>] (Append a fixed-size binary record of each AQPE experiment to the result log.)\n"
+		"[--result-stream <shared_memory_name>] (Publish every RFPE iteration and AQPE experiment to a shared memory ring buffer per thread for live consumers.)\n"
+		"[--efficiency] (Compare the posterior variance of each AQPE experiment with the Cramer-Rao bound from the Fisher information of its circuits.)\n"
+		"[--abort-divergent] (Abort AQPE experiments whose posterior becomes invalid, stops shrinking, or contradicts the evidence.)\n"
+		"[--divergence-window <number_of_iterations : int in (0, inf)>] (Consecutive iterations of a stalled or contradicted posterior before an abort. Default: 5)\n"
+		"[--divergence-surprise <z : double in (0, inf)>] (Deviation of the outcome count from its prediction, in standard deviations, that contradicts the posterior. Default: 5)\n"
+		"[--engine <rfpe | mesh | tempered | stratified>] (Posterior engine: Gaussian-fitted rejection filtering, a deterministic adaptive-mesh histogram on the circle, rejection filtering tempered in stages for large -n, or importance sampling stratified over the peaks of the likelihood. Default: rfpe)\n"
+		"[--shot-records] (Simulate circuits shot by shot as packed records, 64 shots per word, and count the outcomes from the records.)\n"
+		"[--readout-flip <probability : double in [0, 0.5]>] (Probability that readout noise flips the outcome of a shot. Implies --shot-records. Default: 0)\n"
+		"[--readout-correlation <rho : double in [0, 1)>] (Correlation of the readout flips of consecutive shots, which form a Markov chain. Default: 0)\n"
+		"[--shot-record-file <shot_record_file>] (Append the packed records of all circuits to the file. Implies --shot-records.)\n"
+		"[--benchmark-shots] (Benchmark the shot record generator, then exit.)\n"
+		"[--convergence-curves <table_file | ->] (Write the mean and quantiles of std, error, M and accepted samples per iteration across all experiments as a table.)\n"
+		"[--benchmark-kernels] (Benchmark the latency of the RFPE kernels specialized for -m 64, 128 and 256 against the generic kernel, then exit.)\n"
+		"[--benchmark-batch] (Benchmark rounds of batch RFPE updates of 1000 qubits on --threads threads against updating them one by one, then exit.)\n"
+		"[--benchmark-overlap] (Benchmark the latency of an RFPE update once the counts are known, with and without the part precomputed during the circuit, then exit.)\n"
+		"[--realtime] (Lock all memory and prefault the stack before the experiments, and run them without output on the update path. Requires --threads 1.)\n"
+		"[--realtime-priority <priority : int in [1, 99]>] (Run under SCHED_FIFO with this priority. Implies --realtime.)\n"
+		"[--pin-cpu <cpu : int in [0, inf)>] (Pin the thread to this CPU. Implies --realtime.)\n"
+		"[--benchmark-realtime] (Benchmark the p50, p99, p99.9 and maximum latency of AQPE iterations under background load, then exit.)\n"
+		"[--background-load <number_of_threads : int in [0, inf)>] (Threads that sweep memory during --benchmark-realtime. Default: 1)\n"
+		"[--stop-confidence <confidence : double in (0, 1)>] (Stop once the posterior mass within the precision of the estimate reaches the confidence, instead of once the standard deviation is below the precision.)\n"
+		"[--benchmark-stopping] (Benchmark the iterations and errors of -r experiments stopped by the standard deviation against stopping at confidences 0.68, 0.95 and 0.99, then exit.)\n"
+		"[--ancillas <t : int in [1, %d]>] (Read out 2^t outcomes from a textbook phase estimation circuit with t ancilla qubits, which control U^M, U^(2M), ..., U^(2^(t-1) M). Default: 1)\n"
+		"[--amplitude <a : double in [0, 1]>] (Estimate the amplitude a = sin^2(theta_a) by Bayesian amplitude estimation to precision -p in theta_a, with the RFPE updates and -n shots per circuit.)\n"
+		"[--benchmark-amplitude] (Benchmark the oracle calls of -r Bayesian amplitude estimation experiments against maximum likelihood amplitude estimation on exponentially growing Grover powers at the same median and rms error, then exit. Default amplitude: 0.3)\n"
+		"[--check-steady-state] (Run -r experiments on one workspace, and count the heap allocations and system calls of each phase of the iterations after the first experiment. Print a backtrace of the first allocations, and exit with status 1 if there were any allocations or system calls.)\n"
+		"[-h] (Display this help message.)\n", kMinimumPrecision, kMaximumPrecision, kMinimumPrecisionWithoutOffsets, kMaximumNumberOfMixturePhases, kMaximumNumberOfAncillas);
 	fprintf(stdout, "\n");
 }
 
+/**
+ *	@brief	Set all command line arguments to their defaults.
+ *
+ *	@param	arguments	: Pointer to struct to initialize
+ */
+void
+initCommandLineArguments(CommandLineArguments *  arguments)
+{
+	*arguments = (CommandLineArguments) {
+		.targetPhi				= M_PI / 2,
+		.precision				= 1e-4,
+		.alpha					= 0.5,
+		.numberOfEvidenceSamplesPerIteration	= 0,
+		.numberOfPriorTestSamplesPerIteration	= 1000,
+		.numberOfRepetitions			= 1,
+		.verbose				= false,
+		.numberOfThreads			= 1,
+		.schedulerPolicy			= kSchedulerPolicyLongestExpectedFirst,
+		.costTableQueryPath			= NULL,
+		.costTableRefreshPath			= NULL,
+		.benchmarkPipelines			= false,
+		.numberOfMixturePhases			= 0,
+		.mixtureWeightsKnown			= false,
+		.decoherenceRate			= 0.0,
+		.maximumDecoherenceRate			= 0.05,
+		.estimateDecoherence			= false,
+		.resultLogPath				= NULL,
+		.resultStreamName			= NULL,
+		.measureEfficiency			= false,
+		.abortDivergent				= false,
+		.divergenceWindow			= 5,
+		.divergenceSurpriseThreshold		= 5.0,
+		.posteriorEngine			= kPosteriorEngineRFPE,
+		.simulateShotRecords			= false,
+		.readoutFlipProbability			= 0.0,
+		.readoutFlipCorrelation			= 0.0,
+		.shotRecordPath				= NULL,
+		.benchmarkShotRecords			= false,
+		.convergenceCurvesPath			= NULL,
+		.benchmarkKernels			= false,
+		.benchmarkBatch				= false,
+		.benchmarkOverlap			= false,
+		.realTime				= false,
+		.realTimePriority			= 0,
+		.pinnedCPU				= -1,
+		.benchmarkRealTime			= false,
+		.numberOfBackgroundLoadThreads		= 1,
+		.stoppingConfidence			= 0.0,
+		.benchmarkStopping			= false,
+		.numberOfAncillas			= 1,
+		.estimateAmplitude			= false,
+		.targetAmplitude			= 0.3,
+		.benchmarkAmplitude			= false,
+		.checkSteadyState			= false,
+		.quiet					= false,
+	};
+}
+
 /**
  *	@brief	Get command line arguments.
  *
@@ -85,10 +304,11 @@ getCommandLineArguments(int argc, char *  argv[], CommandLineArguments * argumen
 {
 	int	opt;
 	bool	userSpecifiedEvidenceNumber = false;
+	size_t	numberOfMixtureWeights = 0;
 
 	opterr = 0;
 
-	while ((opt = getopt(argc, argv, ":t:p:a:n:m:r:vh")) != EOF)
+	while ((opt = getopt_long(argc, argv, ":t:p:a:n:m:r:vh", kLongOptions, NULL)) != EOF)
 	{
 		switch (opt)
 		{
@@ -175,29 +395,558 @@ getCommandLineArguments(int argc, char *  argv[], CommandLineArguments * argumen
 				arguments->verbose = true;
 				break;
 			}
+			case kLongOptionThreads:
+			{
+				if (atoi(optarg) <= 0)
+				{
+					fprintf(stderr, "\nError: The argument of option --threads (number of worker threads) should be a positive integer.\n");
+
+					return 1;
+				}
+				arguments->numberOfThreads = atoi(optarg);
+
+				break;
+			}
+			case kLongOptionScheduler:
+			{
+				if (strcmp(optarg, "lejf") == 0)
+				{
+					arguments->schedulerPolicy = kSchedulerPolicyLongestExpectedFirst;
+				}
+				else if (strcmp(optarg, "static") == 0)
+				{
+					arguments->schedulerPolicy = kSchedulerPolicyStatic;
+				}
+				else
+				{
+					fprintf(stderr, "\nError: The argument of option --scheduler should be 'lejf' or 'static'.\n");
+
+					return 1;
+				}
+
+				break;
+			}
+			case kLongOptionEngine:
+			{
+				if (strcmp(optarg, "rfpe") == 0)
+				{
+					arguments->posteriorEngine = kPosteriorEngineRFPE;
+				}
+				else if (strcmp(optarg, "mesh") == 0)
+				{
+					arguments->posteriorEngine = kPosteriorEngineMesh;
+				}
+				else if (strcmp(optarg, "tempered") == 0)
+				{
+					arguments->posteriorEngine = kPosteriorEngineTempered;
+				}
+				else if (strcmp(optarg, "stratified") == 0)
+				{
+					arguments->posteriorEngine = kPosteriorEngineStratified;
+				}
+				else
+				{
+					fprintf(stderr, "\nError: The argument of option --engine should be 'rfpe', 'mesh', 'tempered' or 'stratified'.\n");
+
+					return 1;
+				}
+
+				break;
+			}
+			case kLongOptionMixturePhases:
+			{
+				size_t	j;
+
+				arguments->numberOfMixturePhases = parseListOfDoubles(optarg, arguments->mixturePhases, kMaximumNumberOfMixturePhases);
+
+				if (arguments->numberOfMixturePhases == 0)
+				{
+					fprintf(stderr, "\nError: The argument of option --mixture-phases should be a comma-separated list of at most %d eigenphases.\n", kMaximumNumberOfMixturePhases);
+
+					return 1;
+				}
+				for (j = 0; j < arguments->numberOfMixturePhases; j++)
+				{
+					if ((arguments->mixturePhases[j] < kMinimumPhi) || (arguments->mixturePhases[j] > kMaximumPhi))
+					{
+						fprintf(stderr, "\nError: The eigenphases of option --mixture-phases should be in [%le, %le].\n", kMinimumPhi, kMaximumPhi);
+
+						return 1;
+					}
+				}
+
+				break;
+			}
+			case kLongOptionMixtureWeights:
+			{
+				size_t	j;
+
+				numberOfMixtureWeights = parseListOfDoubles(optarg, arguments->mixtureWeights, kMaximumNumberOfMixturePhases);
+
+				if (numberOfMixtureWeights == 0)
+				{
+					fprintf(stderr, "\nError: The argument of option --mixture-weights should be a comma-separated list of at most %d weights.\n", kMaximumNumberOfMixturePhases);
+
+					return 1;
+				}
+				for (j = 0; j < numberOfMixtureWeights; j++)
+				{
+					if (!(arguments->mixtureWeights[j] > 0.0))
+					{
+						fprintf(stderr, "\nError: The weights of option --mixture-weights should be positive.\n");
+
+						return 1;
+					}
+				}
+
+				break;
+			}
+			case kLongOptionKnownWeights:
+			{
+				arguments->mixtureWeightsKnown = true;
+				break;
+			}
+			case kLongOptionDecoherenceRate:
+			{
+				if (atof(optarg) < 0.0)
+				{
+					fprintf(stderr, "\nError: The argument of option --decoherence-rate should be non-negative.\n");
+
+					return 1;
+				}
+				arguments->decoherenceRate = atof(optarg);
+
+				break;
+			}
+			case kLongOptionMaximumDecoherenceRate:
+			{
+				if (!(atof(optarg) > 0.0))
+				{
+					fprintf(stderr, "\nError: The argument of option --maximum-decoherence-rate should be positive.\n");
+
+					return 1;
+				}
+				arguments->maximumDecoherenceRate = atof(optarg);
+
+				break;
+			}
+			case kLongOptionEstimateDecoherence:
+			{
+				arguments->estimateDecoherence = true;
+				break;
+			}
+			case kLongOptionPredictCost:
+			{
+				arguments->costTableQueryPath = optarg;
+				break;
+			}
+			case kLongOptionRefreshCostTable:
+			{
+				arguments->costTableRefreshPath = optarg;
+				break;
+			}
+			case kLongOptionResultLog:
+			{
+				arguments->resultLogPath = optarg;
+				break;
+			}
+			case kLongOptionResultStream:
+			{
+				arguments->resultStreamName = optarg;
+				break;
+			}
+			case kLongOptionEfficiency:
+			{
+				arguments->measureEfficiency = true;
+				break;
+			}
+			case kLongOptionAbortDivergent:
+			{
+				arguments->abortDivergent = true;
+				break;
+			}
+			case kLongOptionDivergenceWindow:
+			{
+				if (atoi(optarg) <= 0)
+				{
+					fprintf(stderr, "\nError: The argument of option --divergence-window should be a positive integer.\n");
+
+					return 1;
+				}
+				arguments->divergenceWindow = atoi(optarg);
+
+				break;
+			}
+			case kLongOptionDivergenceSurprise:
+			{
+				if (!(atof(optarg) > 0.0))
+				{
+					fprintf(stderr, "\nError: The argument of option --divergence-surprise should be positive.\n");
+
+					return 1;
+				}
+				arguments->divergenceSurpriseThreshold = atof(optarg);
+
+				break;
+			}
+			case kLongOptionBenchmarkPipelines:
+			{
+				arguments->benchmarkPipelines = true;
+				break;
+			}
+			case kLongOptionShotRecords:
+			{
+				arguments->simulateShotRecords = true;
+				break;
+			}
+			case kLongOptionReadoutFlip:
+			{
+				if ((atof(optarg) < 0.0) || (atof(optarg) > 0.5))
+				{
+					fprintf(stderr, "\nError: The argument of option --readout-flip should be in [0, 0.5].\n");
+
+					return 1;
+				}
+				arguments->readoutFlipProbability = atof(optarg);
+				arguments->simulateShotRecords = true;
+
+				break;
+			}
+			case kLongOptionReadoutCorrelation:
+			{
+				if ((atof(optarg) < 0.0) || (atof(optarg) >= 1.0))
+				{
+					fprintf(stderr, "\nError: The argument of option --readout-correlation should be in [0, 1).\n");
+
+					return 1;
+				}
+				arguments->readoutFlipCorrelation = atof(optarg);
+
+				break;
+			}
+			case kLongOptionShotRecordFile:
+			{
+				arguments->shotRecordPath = optarg;
+				arguments->simulateShotRecords = true;
+				break;
+			}
+			case kLongOptionBenchmarkShots:
+			{
+				arguments->benchmarkShotRecords = true;
+				break;
+			}
+			case kLongOptionConvergenceCurves:
+			{
+				arguments->convergenceCurvesPath = optarg;
+				break;
+			}
+			case kLongOptionBenchmarkKernels:
+			{
+				arguments->benchmarkKernels = true;
+				break;
+			}
+			case kLongOptionBenchmarkBatch:
+			{
+				arguments->benchmarkBatch = true;
+				break;
+			}
+			case kLongOptionBenchmarkOverlap:
+			{
+				arguments->benchmarkOverlap = true;
+				break;
+			}
+			case kLongOptionRealTime:
+			{
+				arguments->realTime = true;
+				break;
+			}
+			case kLongOptionRealTimePriority:
+			{
+				if ((atoi(optarg) < kRealTimeMinimumPriority) || (atoi(optarg) > kRealTimeMaximumPriority))
+				{
+					fprintf(stderr, "\nError: The argument of option --realtime-priority should be in [%d, %d].\n", kRealTimeMinimumPriority, kRealTimeMaximumPriority);
+
+					return 1;
+				}
+				arguments->realTimePriority = atoi(optarg);
+				arguments->realTime = true;
+
+				break;
+			}
+			case kLongOptionPinCPU:
+			{
+				if (atoi(optarg) < 0)
+				{
+					fprintf(stderr, "\nError: The argument of option --pin-cpu should be a non-negative integer.\n");
+
+					return 1;
+				}
+				arguments->pinnedCPU = atoi(optarg);
+				arguments->realTime = true;
+
+				break;
+			}
+			case kLongOptionBenchmarkRealTime:
+			{
+				arguments->benchmarkRealTime = true;
+				break;
+			}
+			case kLongOptionBackgroundLoad:
+			{
+				if (atoi(optarg) < 0)
+				{
+					fprintf(stderr, "\nError: The argument of option --background-load should be a non-negative integer.\n");
+
+					return 1;
+				}
+				arguments->numberOfBackgroundLoadThreads = atoi(optarg);
+
+				break;
+			}
+			case kLongOptionStopConfidence:
+			{
+				if (!((atof(optarg) > 0.0) && (atof(optarg) < 1.0)))
+				{
+					fprintf(stderr, "\nError: The argument of option --stop-confidence should be in (0, 1).\n");
+
+					return 1;
+				}
+				arguments->stoppingConfidence = atof(optarg);
+
+				break;
+			}
+			case kLongOptionBenchmarkStopping:
+			{
+				arguments->benchmarkStopping = true;
+				break;
+			}
+			case kLongOptionAmplitude:
+			{
+				if (!((atof(optarg) >= 0.0) && (atof(optarg) <= 1.0)))
+				{
+					fprintf(stderr, "\nError: The argument of option --amplitude should be in [0, 1].\n");
+
+					return 1;
+				}
+				arguments->targetAmplitude = atof(optarg);
+				arguments->estimateAmplitude = true;
+
+				break;
+			}
+			case kLongOptionBenchmarkAmplitude:
+			{
+				arguments->benchmarkAmplitude = true;
+				break;
+			}
+			case kLongOptionCheckSteadyState:
+			{
+				arguments->checkSteadyState = true;
+				break;
+			}
+			case kLongOptionAncillas:
+			{
+				if ((atoi(optarg) < 1) || (atoi(optarg) > kMaximumNumberOfAncillas))
+				{
+					fprintf(stderr, "\nError: The argument of option --ancillas should be in [1, %d].\n", kMaximumNumberOfAncillas);
+
+					return 1;
+				}
+				arguments->numberOfAncillas = atoi(optarg);
+
+				break;
+			}
 			case 'h':
 			{
+				/*
+				 *	A library call must neither print to the stdout of its
+				 *	host nor end its process.
+				 */
+				if (arguments->quiet)
+				{
+					fprintf(stderr, "\nError: Option -h is only available in the application.\n");
+
+					return 1;
+				}
 				printUsage();
 				exit(0);
 			}
 			case ':':
 			{
-				fprintf(stderr, "\nError: Option -%c is missing a required argument.\n", optopt);
-				printUsage();
+				if (optopt >= kLongOptionThreads)
+				{
+					fprintf(stderr, "\nError: Option %s is missing a required argument.\n", argv[optind - 1]);
+				}
+				else
+				{
+					fprintf(stderr, "\nError: Option -%c is missing a required argument.\n", optopt);
+				}
+				if (!arguments->quiet)
+				{
+					printUsage();
+				}
 				
 				return 1;
 				break;
 			}
 			case '?':
 			{
-				fprintf(stderr, "\nError: Invalid option: -%c.\n", optopt);
-				printUsage();
+				if (optopt == 0)
+				{
+					fprintf(stderr, "\nError: Invalid option: %s.\n", argv[optind - 1]);
+				}
+				else
+				{
+					fprintf(stderr, "\nError: Invalid option: -%c.\n", optopt);
+				}
+				if (!arguments->quiet)
+				{
+					printUsage();
+				}
 				
 				return 1;
 			}
 		}
 	}
 
+	/*
+	 *	The mesh posterior lives in the workspace of a thread, so its experiments
+	 *	cannot be sliced across workers.
+	 */
+	if ((arguments->posteriorEngine == kPosteriorEngineMesh) && (arguments->numberOfThreads > 1) && (arguments->schedulerPolicy != kSchedulerPolicyStatic))
+	{
+		fprintf(stderr, "\nWarning: The mesh engine runs each experiment to completion on one thread. Continuing with '--scheduler static'.\n");
+		arguments->schedulerPolicy = kSchedulerPolicyStatic;
+	}
+
+	/*
+	 *	The first experiment of the steady-state check warms up the workspace,
+	 *	and the experiments after it are checked.
+	 */
+	if (arguments->checkSteadyState && (arguments->numberOfRepetitions < 2))
+	{
+		fprintf(stderr, "\nError: Option --check-steady-state requires '-r 2' or more.\n");
+
+		return 1;
+	}
+
+	/*
+	 *	Real-time mode pins and prioritizes the calling thread, which worker
+	 *	threads would inherit, and verbose output prints on the update path.
+	 */
+	if (arguments->realTime && (arguments->numberOfThreads > 1))
+	{
+		fprintf(stderr, "\nError: Option --realtime requires '--threads 1'.\n");
+
+		return 1;
+	}
+	if (arguments->realTime && arguments->verbose)
+	{
+		fprintf(stderr, "\nWarning: Verbose output prints on the update path. Continuing without '-v' in real-time mode.\n");
+		arguments->verbose = false;
+	}
+
+	/*
+	 *	The K-outcome likelihood has its own rejection filtering update, and
+	 *	the shot records, efficiency and divergence detectors and the joint
+	 *	estimators assume two outcomes.
+	 */
+	if ((arguments->numberOfAncillas > 1) && ((arguments->posteriorEngine != kPosteriorEngineRFPE) || arguments->simulateShotRecords || arguments->measureEfficiency || arguments->abortDivergent || arguments->estimateDecoherence || (arguments->numberOfMixturePhases > 0)))
+	{
+		fprintf(stderr, "\nError: Option --ancillas requires '--engine rfpe', and cannot be combined with --shot-records, --efficiency, --abort-divergent, --estimate-decoherence or --mixture-phases, which assume two outcomes.\n");
+
+		return 1;
+	}
+
+	/*
+	 *	Amplitude estimation runs the split RFPE update on a single ancilla,
+	 *	and has no stopping rule or divergence detector of its own.
+	 */
+	if (arguments->estimateAmplitude && ((arguments->posteriorEngine != kPosteriorEngineRFPE) || (arguments->numberOfAncillas > 1) || (arguments->stoppingConfidence > 0.0) || arguments->abortDivergent))
+	{
+		fprintf(stderr, "\nError: Option --amplitude requires '--engine rfpe', and cannot be combined with --ancillas, --stop-confidence or --abort-divergent.\n");
+
+		return 1;
+	}
+
+	/*
+	 *	The circuits of all threads would interleave in one shot record file.
+	 */
+	if ((arguments->shotRecordPath != NULL) && (arguments->numberOfThreads > 1))
+	{
+		fprintf(stderr, "\nError: Option --shot-record-file requires '--threads 1'.\n");
+
+		return 1;
+	}
+
+	if (arguments->estimateDecoherence && (arguments->decoherenceRate > arguments->maximumDecoherenceRate))
+	{
+		fprintf(stderr, "\nWarning: The simulated decoherence rate %le lies outside the decoherence rate grid [0, %le]. Use '--maximum-decoherence-rate' to extend the grid.\n", arguments->decoherenceRate, arguments->maximumDecoherenceRate);
+	}
+
+	if (arguments->numberOfMixturePhases > 0)
+	{
+		double	sumOfWeights = 0.0;
+		size_t	j;
+		size_t	k;
+
+		if (numberOfMixtureWeights == 0)
+		{
+			for (j = 0; j < arguments->numberOfMixturePhases; j++)
+			{
+				arguments->mixtureWeights[j] = 1.0;
+			}
+		}
+		else if (numberOfMixtureWeights != arguments->numberOfMixturePhases)
+		{
+			fprintf(stderr, "\nError: Options --mixture-phases and --mixture-weights should have the same number of values.\n");
+
+			return 1;
+		}
+
+		/*
+		 *	Normalize the weights and sort the eigenphases in increasing order,
+		 *	the order in which the estimator reports them.
+		 */
+		for (j = 0; j < arguments->numberOfMixturePhases; j++)
+		{
+			sumOfWeights += arguments->mixtureWeights[j];
+		}
+		for (j = 0; j < arguments->numberOfMixturePhases; j++)
+		{
+			double	phase = arguments->mixturePhases[j];
+			double	weight = arguments->mixtureWeights[j] / sumOfWeights;
+
+			for (k = j; (k > 0) && (arguments->mixturePhases[k - 1] > phase); k--)
+			{
+				arguments->mixturePhases[k] = arguments->mixturePhases[k - 1];
+				arguments->mixtureWeights[k] = arguments->mixtureWeights[k - 1];
+			}
+			arguments->mixturePhases[k] = phase;
+			arguments->mixtureWeights[k] = weight;
+		}
+	}
+	else if (numberOfMixtureWeights > 0 || arguments->mixtureWeightsKnown)
+	{
+		fprintf(stderr, "\nError: Options --mixture-weights and --known-weights require --mixture-phases.\n");
+
+		return 1;
+	}
+
+	/*
+	 *	Only the split RFPE update holds its samples as offsets from the mean
+	 *	and computes large phases in double-double arithmetic. The tempered
+	 *	and stratified engines and the other estimators take absolute phases
+	 *	in plain doubles, and converge to wrong estimates below this
+	 *	precision. The mesh keeps resolving the posterior with its cells, and
+	 *	is limited by the number of samples instead, which is checked below.
+	 */
+	if ((arguments->precision < kMinimumPrecisionWithoutOffsets) && ((arguments->posteriorEngine == kPosteriorEngineTempered) || (arguments->posteriorEngine == kPosteriorEngineStratified) || (arguments->numberOfMixturePhases > 0) || arguments->estimateDecoherence || arguments->benchmarkBatch || arguments->benchmarkPipelines))
+	{
+		fprintf(stderr, "\nError: Precisions below %le require '--engine rfpe' or '--engine mesh', and cannot be combined with --mixture-phases, --estimate-decoherence, --benchmark-batch or --benchmark-pipelines.\n", kMinimumPrecisionWithoutOffsets);
+
+		return 1;
+	}
+
 	if (arguments->numberOfEvidenceSamplesPerIteration == 0)
 	{
 		if (arguments->alpha == 1.0)
@@ -211,12 +960,29 @@ getCommandLineArguments(int argc, char *  argv[], CommandLineArguments * argumen
 		
 		if ((!userSpecifiedEvidenceNumber) && (arguments->numberOfEvidenceSamplesPerIteration > kMaximumNumberOfEvidenceSamples))
 		{
+			/*
+			 *	The mesh does not overstate its convergence, so with fewer shots
+			 *	than the design requires, it needs about as many more circuits
+			 *	at full depth to reach the precision.
+			 */
+			if ((arguments->posteriorEngine == kPosteriorEngineMesh) && (arguments->numberOfEvidenceSamplesPerIteration > (kMaxNumberOfIterations / 2) * kMaximumNumberOfEvidenceSamples))
+			{
+				fprintf(stderr, "\nError: The mesh engine cannot reach the precision %le within %d iterations with N = %"PRIu64" of the required %"PRIu64" samples. Use a larger precision, a larger alpha, or '-n 0'.\n", arguments->precision, kMaxNumberOfIterations, kMaximumNumberOfEvidenceSamples, arguments->numberOfEvidenceSamplesPerIteration);
+
+				return 1;
+			}
+
 			fprintf(stderr, "\nWarning: The number of samples required from the quantum circuit, N = %"PRIu64", has exceeded the allowed maximum limit of %"PRIu64" samples. Using the maximum allowed.\n", arguments->numberOfEvidenceSamplesPerIteration, kMaximumNumberOfEvidenceSamples);
 			fprintf(stderr, "Note: Use '-n 0' to permit the use of high default number of samples. You can also specify custom number of samples by using the '-n' command-line argument option, e.g., '-n %"PRIu64"'.\n", 10 * kMaximumNumberOfEvidenceSamples);
 			arguments->numberOfEvidenceSamplesPerIteration = kMaximumNumberOfEvidenceSamples;
 		}
 	}
 
+	if (arguments->quiet)
+	{
+		return 0;
+	}
+
 	if (arguments->verbose)
 	{
 		printf("\nIn verbose mode!\n");
@@ -228,6 +994,33 @@ getCommandLineArguments(int argc, char *  argv[], CommandLineArguments * argumen
 	printf("numberOfEvidenceSamplesPerIteration = %"PRIu64"\n", arguments->numberOfEvidenceSamplesPerIteration);
 	printf("numberOfPriorTestSamplesPerIteration = %zu\n", arguments->numberOfPriorTestSamplesPerIteration);
 	printf("numberOfRepetitions = %zu\n", arguments->numberOfRepetitions);
+	printf("numberOfThreads = %zu\n", arguments->numberOfThreads);
+	if (arguments->estimateAmplitude || arguments->benchmarkAmplitude)
+	{
+		printf("targetAmplitude = %lf\n", arguments->targetAmplitude);
+	}
+	if (arguments->numberOfAncillas > 1)
+	{
+		printf("numberOfAncillas = %zu\n", arguments->numberOfAncillas);
+	}
+	if (arguments->decoherenceRate > 0.0)
+	{
+		printf("decoherenceRate = %le\n", arguments->decoherenceRate);
+	}
+	if (arguments->readoutFlipProbability > 0.0)
+	{
+		printf("readoutFlipProbability = %le, readoutFlipCorrelation = %lf\n", arguments->readoutFlipProbability, arguments->readoutFlipCorrelation);
+	}
+	if (arguments->numberOfMixturePhases > 0)
+	{
+		size_t	j;
+
+		printf("numberOfMixturePhases = %zu\n", arguments->numberOfMixturePhases);
+		for (j = 0; j < arguments->numberOfMixturePhases; j++)
+		{
+			printf("mixturePhase[%zu] = %lf, mixtureWeight[%zu] = %lf\n", j + 1, arguments->mixturePhases[j], j + 1, arguments->mixtureWeights[j]);
+		}
+	}
 	printf("\nRequired Quantum Circuit Depth = 1 / precision^{alpha} = %"PRIu64"\n", (uint64_t) ceil(1 / pow(arguments->precision, arguments->alpha)));
 	printf("\nRequired Quantum Circuit Samples (N) = %"PRIu64"\n", (arguments->precision == 1.0) ? (uint64_t) ceil(4 * log(1 / arguments->precision)) : (int) ceil((2 / (1 - arguments->alpha)) * (1 / pow(arguments->precision, 2 * (1 - arguments->alpha)) - 1)));
 
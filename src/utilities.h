@@ -40,6 +40,26 @@
 #include <stdbool.h>
 #include <inttypes.h>
 
+typedef enum
+{
+	kMaximumNumberOfMixturePhases = 8,
+	kMaximumNumberOfAncillas = 8,
+} UtilitiesConstants;
+
+typedef enum
+{
+	kSchedulerPolicyLongestExpectedFirst,
+	kSchedulerPolicyStatic,
+} SchedulerPolicy;
+
+typedef enum
+{
+	kPosteriorEngineRFPE,
+	kPosteriorEngineMesh,
+	kPosteriorEngineTempered,
+	kPosteriorEngineStratified,
+} PosteriorEngine;
+
 typedef struct CommandLineArguments
 {
 	double		targetPhi;
@@ -49,6 +69,47 @@ typedef struct CommandLineArguments
 	size_t		numberOfPriorTestSamplesPerIteration;
 	size_t		numberOfRepetitions;
 	bool		verbose;
+	size_t		numberOfThreads;
+	SchedulerPolicy	schedulerPolicy;
+	const char *	costTableQueryPath;
+	const char *	costTableRefreshPath;
+	bool		benchmarkPipelines;
+	size_t		numberOfMixturePhases;
+	double		mixturePhases[kMaximumNumberOfMixturePhases];
+	double		mixtureWeights[kMaximumNumberOfMixturePhases];
+	bool		mixtureWeightsKnown;
+	double		decoherenceRate;
+	double		maximumDecoherenceRate;
+	bool		estimateDecoherence;
+	const char *	resultLogPath;
+	const char *	resultStreamName;
+	bool		measureEfficiency;
+	bool		abortDivergent;
+	size_t		divergenceWindow;
+	double		divergenceSurpriseThreshold;
+	PosteriorEngine	posteriorEngine;
+	bool		simulateShotRecords;
+	double		readoutFlipProbability;
+	double		readoutFlipCorrelation;
+	const char *	shotRecordPath;
+	bool		benchmarkShotRecords;
+	const char *	convergenceCurvesPath;
+	bool		benchmarkKernels;
+	bool		benchmarkBatch;
+	bool		benchmarkOverlap;
+	bool		realTime;
+	int		realTimePriority;
+	int		pinnedCPU;
+	bool		benchmarkRealTime;
+	size_t		numberOfBackgroundLoadThreads;
+	double		stoppingConfidence;
+	bool		benchmarkStopping;
+	size_t		numberOfAncillas;
+	bool		estimateAmplitude;
+	double		targetAmplitude;
+	bool		benchmarkAmplitude;
+	bool		checkSteadyState;
+	bool		quiet;
 } CommandLineArguments;
 
 /**
@@ -56,6 +117,13 @@ typedef struct CommandLineArguments
  */
 void	printUsage(void);
 
+/**
+ *	@brief	Set all command line arguments to their defaults.
+ *
+ *	@param	arguments	: Pointer to struct to initialize
+ */
+void	initCommandLineArguments(CommandLineArguments *  arguments);
+
 /**
  *	@brief	Get command line arguments.
  *
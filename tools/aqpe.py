@@ -0,0 +1,147 @@
+#
+#	Copyright (c) 2026, Signaloid.
+#
+#	All rights reserved.
+#
+#	Redistribution and use in source and binary forms, with or without
+#	modification, are permitted provided that the following conditions
+#	are met:
+#	*	Redistributions of source code must retain the above
+#		copyright notice, this list of conditions and the following
+#		disclaimer.
+#	*	Redistributions in binary form must reproduce the above
+#		copyright notice, this list of conditions and the following
+#		disclaimer in the documentation and/or other materials
+#		provided with the distribution.
+#	*	Neither the name of the author nor the names of its
+#		contributors may be used to endorse or promote products
+#		derived from this software without specific prior written
+#		permission.
+#
+#	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+#	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+#	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+#	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+#	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+#	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+#	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+#	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+#	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+#	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+#	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#	POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""
+Bindings of the AQPE estimator for analysis pipelines, over the shared
+library built from src/ (see the README). A Run takes the command line
+options of the application and keeps the C result buffers. The results are
+memoryviews that alias those buffers without copying, so numpy.asarray()
+of a result is zero-copy as well. The next call of Run.run() overwrites them.
+
+Run.run() releases the GIL, so Python threads can drive several runs in
+parallel, one run per thread.
+"""
+
+import ctypes
+import os
+from collections import namedtuple
+
+_RESULT_FIELDS = (
+	("meanValues", ctypes.c_double, "d", False),
+	("standardDeviations", ctypes.c_double, "d", False),
+	("numbersOfIterations", ctypes.c_uint64, "Q", False),
+	("converged", ctypes.c_uint8, "B", False),
+	("abortReasons", ctypes.c_uint8, "B", False),
+	("totalShots", ctypes.c_uint64, "Q", False),
+	("depthShotProducts", ctypes.c_double, "d", False),
+	("trajectoryMeanValues", ctypes.c_double, "d", True),
+	("trajectoryStandardDeviations", ctypes.c_double, "d", True),
+	("trajectoryMs", ctypes.c_double, "d", True),
+	("trajectoryThetas", ctypes.c_double, "d", True),
+)
+
+
+class _AQPERunResults(ctypes.Structure):
+	_fields_ = [("numberOfExperiments", ctypes.c_uint64), ("maximumNumberOfIterations", ctypes.c_uint64)] + \
+		[(name, ctypes.POINTER(ctype)) for name, ctype, _, _ in _RESULT_FIELDS]
+
+
+Results = namedtuple("Results", [name for name, _, _, _ in _RESULT_FIELDS])
+
+
+def _loadLibrary(path):
+	path = path or os.environ.get("AQPE_LIBRARY", os.path.join(os.path.dirname(os.path.abspath(__file__)), "libaqpe.so"))
+
+	#
+	#	The same library twice: PyDLL holds the GIL, which serializes the
+	#	getopt() parsing of createAQPERun(), and CDLL releases it for runAQPE().
+	#
+	parser = ctypes.PyDLL(path)
+	parser.createAQPERun.argtypes = [ctypes.c_int, ctypes.POINTER(ctypes.c_char_p)]
+	parser.createAQPERun.restype = ctypes.c_void_p
+
+	library = ctypes.CDLL(path)
+	library.runAQPE.argtypes = [ctypes.c_void_p, ctypes.c_ulong]
+	library.runAQPE.restype = ctypes.c_int
+	library.getAQPERunResults.argtypes = [ctypes.c_void_p]
+	library.getAQPERunResults.restype = ctypes.POINTER(_AQPERunResults)
+	library.destroyAQPERun.argtypes = [ctypes.c_void_p]
+	library.destroyAQPERun.restype = None
+
+	return parser, library
+
+
+class Run:
+	"""
+	A run of AQPE experiments, configured by the options of the application,
+	e.g. Run("-p", "1e-4", "-r", "100", "--engine", "mesh").
+	"""
+
+	def __init__(self, *options, library=None):
+		self._parser, self._library = _loadLibrary(library)
+		arguments = [b"aqpe"] + [str(option).encode() for option in options]
+		argv = (ctypes.c_char_p * (len(arguments) + 1))(*arguments, None)
+
+		self._run = self._parser.createAQPERun(len(arguments), argv)
+		if not self._run:
+			raise ValueError("invalid AQPE options: " + " ".join(str(option) for option in options))
+
+	@property
+	def results(self):
+		"""
+		Results of the last run, which alias the C buffers.
+		"""
+		results = self._library.getAQPERunResults(self._run).contents
+		numberOfExperiments = results.numberOfExperiments
+		maximumNumberOfIterations = results.maximumNumberOfIterations
+		views = []
+
+		for name, ctype, code, isTrajectory in _RESULT_FIELDS:
+			shape = (numberOfExperiments, maximumNumberOfIterations) if isTrajectory else (numberOfExperiments,)
+			length = numberOfExperiments * (maximumNumberOfIterations if isTrajectory else 1)
+			buffer = (ctype * length).from_address(ctypes.addressof(getattr(results, name).contents))
+
+			#
+			#	The buffer keeps the run alive for as long as a view of it
+			#	exists, so that the C buffers outlive their views.
+			#
+			buffer._run = self
+			views.append(memoryview(buffer).cast("B").cast(code, shape))
+
+		return Results(*views)
+
+	def run(self, seed=0):
+		"""
+		Run all experiments, releasing the GIL. A seed of 0 seeds from the
+		time of day. Returns the results, which alias the C buffers.
+		"""
+		if self._library.runAQPE(self._run, seed) != 0:
+			raise RuntimeError("AQPE run failed")
+
+		return self.results
+
+	def __del__(self):
+		if getattr(self, "_run", None):
+			self._library.destroyAQPERun(self._run)
+			self._run = None
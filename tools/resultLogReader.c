@@ -0,0 +1,457 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *	Standalone reader for the result logs written with '--result-log'. It
+ *	memory-maps the logs and computes summaries, filters and histograms in a
+ *	single sequential pass, so it needs neither GSL nor the records in memory.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../src/resultLog.h"
+
+const char	kResultLogMagic[8] = {'A', 'Q', 'P', 'E', 'L', 'O', 'G', '1'};
+
+typedef enum
+{
+	kMaximumNumberOfBins = 1024,
+	kDefaultNumberOfBins = 20,
+} ReaderConstants;
+
+typedef enum
+{
+	kHistogramNone,
+	kHistogramIterations,
+	kHistogramError,
+	kHistogramShots,
+} HistogramQuantity;
+
+typedef enum
+{
+	kLongOptionConverged = 256,
+	kLongOptionNotConverged,
+	kLongOptionSeed,
+	kLongOptionMinimumError,
+	kLongOptionMaximumError,
+	kLongOptionHistogram,
+	kLongOptionBins,
+} LongOption;
+
+static const struct option	kLongOptions[] = {
+	{"converged",		no_argument,		NULL,	kLongOptionConverged},
+	{"not-converged",	no_argument,		NULL,	kLongOptionNotConverged},
+	{"seed",		required_argument,	NULL,	kLongOptionSeed},
+	{"min-error",		required_argument,	NULL,	kLongOptionMinimumError},
+	{"max-error",		required_argument,	NULL,	kLongOptionMaximumError},
+	{"histogram",		required_argument,	NULL,	kLongOptionHistogram},
+	{"bins",		required_argument,	NULL,	kLongOptionBins},
+	{NULL,			0,			NULL,	0},
+};
+
+typedef struct Filter
+{
+	bool		convergedOnly;
+	bool		notConvergedOnly;
+	bool		seedKnown;
+	uint64_t	seed;
+	double		minimumError;
+	double		maximumError;
+} Filter;
+
+typedef struct Summary
+{
+	uint64_t	numberOfRecords;
+	uint64_t	numberOfMatchingRecords;
+	uint64_t	numberOfConvergedRecords;
+	double		iterationSum;
+	uint64_t	minimumIterations;
+	uint64_t	maximumIterations;
+	double		errorSum;
+	double		errorSumOfSquares;
+	double		maximumError;
+	uint64_t	totalShots;
+	double		depthShotProduct;
+	uint64_t	maximumDepth;
+} Summary;
+
+/*
+ *	Histograms have fixed ranges so that a single pass suffices: iterations
+ *	are binned linearly over [0, 100], errors and shots over decades.
+ */
+typedef struct Histogram
+{
+	HistogramQuantity	quantity;
+	size_t			numberOfBins;
+	double			lower;
+	double			upper;
+	bool			logarithmic;
+	uint64_t		counts[kMaximumNumberOfBins];
+	uint64_t		underflow;
+	uint64_t		overflow;
+} Histogram;
+
+static void
+printUsage(void)
+{
+	fprintf(stderr, "Usage: resultLogReader [options] <result_log_file>...\n"
+		"[--converged] (Only records of converged experiments.)\n"
+		"[--not-converged] (Only records of experiments that did not converge.)\n"
+		"[--seed <seed : uint64>] (Only records of the run with this random seed.)\n"
+		"[--min-error <error : double>] (Only records with at least this phase estimation error.)\n"
+		"[--max-error <error : double>] (Only records with at most this phase estimation error.)\n"
+		"[--histogram <iterations | error | shots>] (Print a histogram of the quantity over the matching records.)\n"
+		"[--bins <number_of_bins : int in [1, %d]>] (Default: %d)\n", kMaximumNumberOfBins, kDefaultNumberOfBins);
+}
+
+static bool
+recordMatchesFilter(const ResultLogRecord *  record, const Filter *  filter)
+{
+	bool	converged = (record->flags & kResultLogRecordFlagConverged) != 0;
+
+	return	!(filter->convergedOnly && !converged) &&
+		!(filter->notConvergedOnly && converged) &&
+		!(filter->seedKnown && (record->seed != filter->seed)) &&
+		(record->error >= filter->minimumError) &&
+		(record->error <= filter->maximumError);
+}
+
+static void
+addToHistogram(Histogram *  histogram, const ResultLogRecord *  record)
+{
+	double	value;
+	double	position;
+
+	switch (histogram->quantity)
+	{
+		case kHistogramIterations:
+			value = record->numberOfIterations;
+			break;
+		case kHistogramError:
+			value = record->error;
+			break;
+		case kHistogramShots:
+			value = (double) record->totalShots;
+			break;
+		default:
+			return;
+	}
+
+	if (histogram->logarithmic)
+	{
+		value = (value > 0.0) ? log10(value) : -INFINITY;
+	}
+
+	position = (value - histogram->lower) / (histogram->upper - histogram->lower) * histogram->numberOfBins;
+
+	if (position < 0.0)
+	{
+		histogram->underflow++;
+	}
+	else if (position >= histogram->numberOfBins)
+	{
+		histogram->overflow++;
+	}
+	else
+	{
+		histogram->counts[(size_t) position]++;
+	}
+}
+
+static void
+printHistogram(const Histogram *  histogram)
+{
+	uint64_t	maximumCount = 1;
+	size_t		i;
+
+	for (i = 0; i < histogram->numberOfBins; i++)
+	{
+		maximumCount = (histogram->counts[i] > maximumCount) ? histogram->counts[i] : maximumCount;
+	}
+
+	printf("\nHistogram of %s%s:\n", (histogram->quantity == kHistogramIterations) ? "iterations" : (histogram->quantity == kHistogramError) ? "phase estimation errors" : "total shots", histogram->logarithmic ? " (log10)" : "");
+	printf("%12s %12s %12" PRIu64 "\n", "below", "", histogram->underflow);
+
+	for (i = 0; i < histogram->numberOfBins; i++)
+	{
+		double	binLower = histogram->lower + i * (histogram->upper - histogram->lower) / histogram->numberOfBins;
+		double	binUpper = histogram->lower + (i + 1) * (histogram->upper - histogram->lower) / histogram->numberOfBins;
+		int	barLength = (int) (50 * histogram->counts[i] / maximumCount);
+
+		printf("%12.4g %12.4g %12" PRIu64 " %.*s\n", binLower, binUpper, histogram->counts[i], barLength, "##################################################");
+	}
+
+	printf("%12s %12s %12" PRIu64 "\n", "above", "", histogram->overflow);
+}
+
+/*
+ *	Map one result log and fold its records into the summary and histogram.
+ */
+static int
+readResultLog(const char *  path, const Filter *  filter, Summary *  summary, Histogram *  histogram)
+{
+	const ResultLogHeader *	header;
+	const ResultLogRecord *	records;
+	struct stat		status;
+	void *			mapping;
+	size_t			numberOfRecords;
+	size_t			i;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		fprintf(stderr, "\nError: Could not open result log '%s'.\n", path);
+
+		return 1;
+	}
+
+	if ((fstat(fd, &status) != 0) || (status.st_size < (off_t) sizeof(ResultLogHeader)))
+	{
+		fprintf(stderr, "\nError: '%s' is too short to be a result log.\n", path);
+		close(fd);
+
+		return 1;
+	}
+
+	mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+	{
+		fprintf(stderr, "\nError: Could not map result log '%s'.\n", path);
+
+		return 1;
+	}
+
+	madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+
+	header = (const ResultLogHeader *) mapping;
+	if ((memcmp(header->magic, kResultLogMagic, sizeof(header->magic)) != 0) || (header->recordSize != sizeof(ResultLogRecord)))
+	{
+		fprintf(stderr, "\nError: '%s' is not a result log with %zu-byte records.\n", path, sizeof(ResultLogRecord));
+		munmap(mapping, status.st_size);
+
+		return 1;
+	}
+
+	/*
+	 *	A trailing partial record, e.g. from an interrupted run, is ignored.
+	 */
+	records = (const ResultLogRecord *) (header + 1);
+	numberOfRecords = (status.st_size - sizeof(ResultLogHeader)) / sizeof(ResultLogRecord);
+
+	for (i = 0; i < numberOfRecords; i++)
+	{
+		const ResultLogRecord *	record = &records[i];
+
+		summary->numberOfRecords++;
+
+		if (!recordMatchesFilter(record, filter))
+		{
+			continue;
+		}
+
+		summary->numberOfMatchingRecords++;
+		summary->numberOfConvergedRecords += (record->flags & kResultLogRecordFlagConverged) ? 1 : 0;
+		summary->iterationSum += record->numberOfIterations;
+		summary->minimumIterations = (record->numberOfIterations < summary->minimumIterations) ? record->numberOfIterations : summary->minimumIterations;
+		summary->maximumIterations = (record->numberOfIterations > summary->maximumIterations) ? record->numberOfIterations : summary->maximumIterations;
+		summary->errorSum += record->error;
+		summary->errorSumOfSquares += record->error * record->error;
+		summary->maximumError = fmax(summary->maximumError, record->error);
+		summary->totalShots += record->totalShots;
+		summary->depthShotProduct += record->depthShotProduct;
+		summary->maximumDepth = (record->maximumDepth > summary->maximumDepth) ? record->maximumDepth : summary->maximumDepth;
+
+		addToHistogram(histogram, record);
+	}
+
+	munmap(mapping, status.st_size);
+
+	return 0;
+}
+
+int
+main(int argc, char *  argv[])
+{
+	Filter		filter = {
+		.minimumError	= -INFINITY,
+		.maximumError	= INFINITY,
+	};
+	Summary		summary = {
+		.minimumIterations	= UINT64_MAX,
+	};
+	Histogram *	histogram;
+	struct timespec	startTime;
+	struct timespec	endTime;
+	double		elapsedTime;
+	int		opt;
+	int		i;
+
+	histogram = (Histogram *) calloc(1, sizeof(Histogram));
+	histogram->numberOfBins = kDefaultNumberOfBins;
+
+	while ((opt = getopt_long(argc, argv, "h", kLongOptions, NULL)) != EOF)
+	{
+		switch (opt)
+		{
+			case kLongOptionConverged:
+				filter.convergedOnly = true;
+				break;
+			case kLongOptionNotConverged:
+				filter.notConvergedOnly = true;
+				break;
+			case kLongOptionSeed:
+				filter.seedKnown = true;
+				filter.seed = strtoull(optarg, NULL, 10);
+				break;
+			case kLongOptionMinimumError:
+				filter.minimumError = atof(optarg);
+				break;
+			case kLongOptionMaximumError:
+				filter.maximumError = atof(optarg);
+				break;
+			case kLongOptionHistogram:
+				if (strcmp(optarg, "iterations") == 0)
+				{
+					histogram->quantity = kHistogramIterations;
+				}
+				else if (strcmp(optarg, "error") == 0)
+				{
+					histogram->quantity = kHistogramError;
+				}
+				else if (strcmp(optarg, "shots") == 0)
+				{
+					histogram->quantity = kHistogramShots;
+				}
+				else
+				{
+					fprintf(stderr, "\nError: The argument of option --histogram should be 'iterations', 'error' or 'shots'.\n");
+					free(histogram);
+
+					return 1;
+				}
+				break;
+			case kLongOptionBins:
+				if ((atoi(optarg) < 1) || (atoi(optarg) > kMaximumNumberOfBins))
+				{
+					fprintf(stderr, "\nError: The argument of option --bins should be in [1, %d].\n", kMaximumNumberOfBins);
+					free(histogram);
+
+					return 1;
+				}
+				histogram->numberOfBins = atoi(optarg);
+				break;
+			default:
+				printUsage();
+				free(histogram);
+
+				return (opt == 'h') ? 0 : 1;
+		}
+	}
+
+	if (optind >= argc)
+	{
+		printUsage();
+		free(histogram);
+
+		return 1;
+	}
+
+	switch (histogram->quantity)
+	{
+		case kHistogramIterations:
+			histogram->lower = 0.0;
+			histogram->upper = 100.0 + 1.0;
+			break;
+		case kHistogramError:
+			histogram->lower = -16.0;
+			histogram->upper = 1.0;
+			histogram->logarithmic = true;
+			break;
+		case kHistogramShots:
+			histogram->lower = 0.0;
+			histogram->upper = 12.0;
+			histogram->logarithmic = true;
+			break;
+		default:
+			break;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+	for (i = optind; i < argc; i++)
+	{
+		if (readResultLog(argv[i], &filter, &summary, histogram))
+		{
+			free(histogram);
+
+			return 1;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+	elapsedTime = (endTime.tv_sec - startTime.tv_sec) + 1e-9 * (endTime.tv_nsec - startTime.tv_nsec);
+
+	printf("Read %" PRIu64 " records in %lf s (%le records/s), %" PRIu64 " matching the filters.\n", summary.numberOfRecords, elapsedTime, summary.numberOfRecords / fmax(elapsedTime, 1e-9), summary.numberOfMatchingRecords);
+
+	if (summary.numberOfMatchingRecords > 0)
+	{
+		double	n = (double) summary.numberOfMatchingRecords;
+
+		printf("\nConverged experiments: %" PRIu64 " of %" PRIu64 " (%lf%%)\n", summary.numberOfConvergedRecords, summary.numberOfMatchingRecords, 100.0 * summary.numberOfConvergedRecords / n);
+		printf("Iterations: mean %lf, min %" PRIu64 ", max %" PRIu64 "\n", summary.iterationSum / n, summary.minimumIterations, summary.maximumIterations);
+		printf("Phase estimation error: mean %le, rms %le, max %le\n", summary.errorSum / n, sqrt(summary.errorSumOfSquares / n), summary.maximumError);
+		printf("Quantum resources: %" PRIu64 " total shots, %le depth-shot product, %" PRIu64 " maximum circuit depth\n", summary.totalShots, summary.depthShotProduct, summary.maximumDepth);
+	}
+
+	if (histogram->quantity != kHistogramNone)
+	{
+		printHistogram(histogram);
+	}
+
+	free(histogram);
+
+	return 0;
+}
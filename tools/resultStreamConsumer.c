@@ -0,0 +1,309 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *	Standalone live consumer for the shared memory result stream published with
+ *	'--result-stream'. It maps the stream read-only, so any number of consumers
+ *	can follow a run without slowing its writers.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../src/resultStream.h"
+
+typedef enum
+{
+	kLongOptionPrint = 256,
+	kLongOptionInterval,
+	kLongOptionWait,
+} LongOption;
+
+static const struct option	kLongOptions[] = {
+	{"print",	no_argument,		NULL,	kLongOptionPrint},
+	{"interval",	required_argument,	NULL,	kLongOptionInterval},
+	{"wait",	required_argument,	NULL,	kLongOptionWait},
+	{NULL,		0,			NULL,	0},
+};
+
+typedef struct ConsumerStatistics
+{
+	uint64_t	numberOfRecords;
+	uint64_t	numberOfLostRecords;
+	uint64_t	numberOfExperiments;
+	uint64_t	numberOfConvergedExperiments;
+	double		iterationSum;
+	uint64_t	totalShots;
+} ConsumerStatistics;
+
+static double
+monotonicTime(void)
+{
+	struct timespec	time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return time.tv_sec + 1e-9 * time.tv_nsec;
+}
+
+static void
+printUsage(void)
+{
+	fprintf(stderr, "Usage: resultStreamConsumer [options] <shared_memory_name>\n"
+		"[--print] (Print every record instead of periodic summaries.)\n"
+		"[--interval <seconds : double in (0, inf)>] (Time between summaries. Default: 1)\n"
+		"[--wait <seconds : double in [0, inf)>] (Time to wait for the stream to be created. Default: 10)\n");
+}
+
+/*
+ *	Copy the record at position of a ring. Returns false if the writer has
+ *	overwritten or is overwriting the slot.
+ */
+static bool
+readResultStreamSlot(ResultStreamRing *  ring, uint64_t ringCapacity, uint64_t position, ResultStreamRecord *  record)
+{
+	ResultStreamSlot *	slot = &ring->slots[position & (ringCapacity - 1)];
+	uint64_t		sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+	if (sequence != 2 * (position + 1))
+	{
+		return false;
+	}
+
+	*record = slot->record;
+	atomic_thread_fence(memory_order_acquire);
+
+	return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == sequence;
+}
+
+static void
+consumeRecord(const ResultStreamRecord *  record, size_t ringIndex, bool printRecords, ConsumerStatistics *  statistics)
+{
+	statistics->numberOfRecords++;
+
+	if (record->type == kResultStreamRecordExperiment)
+	{
+		statistics->numberOfExperiments++;
+		statistics->numberOfConvergedExperiments += (record->flags & kResultStreamRecordFlagConverged) ? 1 : 0;
+		statistics->iterationSum += record->numberOfIterations;
+		statistics->totalShots += record->totalShots;
+	}
+
+	if (printRecords)
+	{
+		printf("%s thread %zu experiment %" PRIu64 " iteration %" PRIu64 ": Phi %le +- %le, M %le, theta %le, shots %" PRIu64 "%s\n",
+			(record->type == kResultStreamRecordExperiment) ? "finished" : "iteration",
+			ringIndex, record->experimentNo, record->numberOfIterations, record->meanValue, record->standardDeviation, record->M, record->theta, record->totalShots,
+			(record->flags & kResultStreamRecordFlagConverged) ? " (converged)" : "");
+	}
+}
+
+static void
+printConsumerStatistics(const ConsumerStatistics *  statistics, double elapsedTime)
+{
+	printf("%10.3lf s: %" PRIu64 " records (%le records/s), %" PRIu64 " lost, %" PRIu64 " experiments finished, %" PRIu64 " converged, %lf iterations on average, %" PRIu64 " shots\n",
+		elapsedTime, statistics->numberOfRecords, statistics->numberOfRecords / fmax(elapsedTime, 1e-9), statistics->numberOfLostRecords,
+		statistics->numberOfExperiments, statistics->numberOfConvergedExperiments,
+		(statistics->numberOfExperiments > 0) ? statistics->iterationSum / statistics->numberOfExperiments : 0.0, statistics->totalShots);
+	fflush(stdout);
+}
+
+int
+main(int argc, char *  argv[])
+{
+	ResultStreamHeader *	header;
+	ConsumerStatistics	statistics = {0};
+	uint64_t *		cursors;
+	struct stat		status;
+	char			name[256];
+	bool			printRecords = false;
+	double			interval = 1.0;
+	double			waitTime = 10.0;
+	double			startTime;
+	double			nextReportTime;
+	size_t			ringIndex;
+	int			opt;
+	int			fd;
+
+	while ((opt = getopt_long(argc, argv, "h", kLongOptions, NULL)) != EOF)
+	{
+		switch (opt)
+		{
+			case kLongOptionPrint:
+				printRecords = true;
+				break;
+			case kLongOptionInterval:
+				interval = atof(optarg);
+				break;
+			case kLongOptionWait:
+				waitTime = atof(optarg);
+				break;
+			default:
+				printUsage();
+
+				return (opt == 'h') ? 0 : 1;
+		}
+	}
+
+	if ((optind != argc - 1) || !(interval > 0.0))
+	{
+		printUsage();
+
+		return 1;
+	}
+
+	snprintf(name, sizeof(name), "%s%s", (argv[optind][0] == '/') ? "" : "/", argv[optind]);
+
+	/*
+	 *	The consumer may start before the run, so wait for the stream to appear
+	 *	with a complete header.
+	 */
+	startTime = monotonicTime();
+	while (true)
+	{
+		fd = shm_open(name, O_RDONLY, 0);
+		if ((fd >= 0) && (fstat(fd, &status) == 0) && (status.st_size >= (off_t) sizeof(ResultStreamHeader)))
+		{
+			header = (ResultStreamHeader *) mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			close(fd);
+
+			if (header == MAP_FAILED)
+			{
+				fprintf(stderr, "\nError: Could not map the shared memory object '%s'.\n", name);
+
+				return 1;
+			}
+			if (memcmp(header->magic, kResultStreamMagic, sizeof(kResultStreamMagic)) == 0)
+			{
+				break;
+			}
+			munmap(header, status.st_size);
+		}
+		else if (fd >= 0)
+		{
+			close(fd);
+		}
+
+		if (monotonicTime() - startTime > waitTime)
+		{
+			fprintf(stderr, "\nError: No result stream '%s' appeared within %lf s.\n", name, waitTime);
+
+			return 1;
+		}
+		usleep(10000);
+	}
+	atomic_thread_fence(memory_order_acquire);
+
+	if (header->recordSize != sizeof(ResultStreamRecord))
+	{
+		fprintf(stderr, "\nError: '%s' holds %" PRIu32 "-byte records, expected %zu.\n", name, header->recordSize, sizeof(ResultStreamRecord));
+
+		return 1;
+	}
+
+	cursors = (uint64_t *) calloc(header->numberOfRings, sizeof(uint64_t));
+	startTime = monotonicTime();
+	nextReportTime = startTime + interval;
+
+	while (true)
+	{
+		bool	finished = atomic_load_explicit(&header->finished, memory_order_acquire) != 0;
+		bool	idle = true;
+
+		for (ringIndex = 0; ringIndex < header->numberOfRings; ringIndex++)
+		{
+			ResultStreamRing *	ring = resultStreamRing(header, ringIndex);
+			uint64_t		head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+			/*
+			 *	Records older than one ring capacity have been overwritten.
+			 */
+			if (head - cursors[ringIndex] > header->ringCapacity)
+			{
+				statistics.numberOfLostRecords += head - header->ringCapacity - cursors[ringIndex];
+				cursors[ringIndex] = head - header->ringCapacity;
+			}
+
+			while (cursors[ringIndex] < head)
+			{
+				ResultStreamRecord	record;
+
+				if (readResultStreamSlot(ring, header->ringCapacity, cursors[ringIndex], &record))
+				{
+					consumeRecord(&record, ringIndex, printRecords, &statistics);
+				}
+				else
+				{
+					statistics.numberOfLostRecords++;
+				}
+				cursors[ringIndex]++;
+				idle = false;
+			}
+		}
+
+		if (!printRecords && (monotonicTime() >= nextReportTime))
+		{
+			printConsumerStatistics(&statistics, monotonicTime() - startTime);
+			nextReportTime += interval;
+		}
+
+		/*
+		 *	The finished flag was read before the rings, so everything the
+		 *	writers published has been drained once it is set.
+		 */
+		if (finished)
+		{
+			break;
+		}
+		if (idle)
+		{
+			usleep(1000);
+		}
+	}
+
+	printConsumerStatistics(&statistics, monotonicTime() - startTime);
+
+	free(cursors);
+	munmap(header, status.st_size);
+
+	return 0;
+}
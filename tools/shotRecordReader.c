@@ -0,0 +1,268 @@
+/*
+ *	Copyright (c) 2026, Signaloid.
+ *
+ *	All rights reserved.
+ *
+ *	Redistribution and use in source and binary forms, with or without
+ *	modification, are permitted provided that the following conditions
+ *	are met:
+ *	*	Redistributions of source code must retain the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer.
+ *	*	Redistributions in binary form must reproduce the above
+ *		copyright notice, this list of conditions and the following
+ *		disclaimer in the documentation and/or other materials
+ *		provided with the distribution.
+ *	*	Neither the name of the author nor the names of its
+ *		contributors may be used to endorse or promote products
+ *		derived from this software without specific prior written
+ *		permission.
+ *
+ *	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *	"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *	LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *	FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *	COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *	INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *	BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *	LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *	LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *	ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *	POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ *	Standalone reader for the shot record files written with
+ *	'--shot-record-file'. It memory-maps the files and turns the packed shots
+ *	of every circuit back into the outcome counts that the inference engines
+ *	consume, together with the lag-1 autocorrelation of the outcomes, which
+ *	exposes time-correlated readout noise.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <getopt.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../src/shotRecord.h"
+
+typedef enum
+{
+	kLongOptionCounts = 256,
+	kLongOptionExperiment,
+} LongOption;
+
+static const struct option	kLongOptions[] = {
+	{"counts",		no_argument,		NULL,	kLongOptionCounts},
+	{"experiment",		required_argument,	NULL,	kLongOptionExperiment},
+	{NULL,			0,			NULL,	0},
+};
+
+typedef struct Options
+{
+	bool		printCounts;
+	bool		experimentKnown;
+	uint64_t	experimentNo;
+} Options;
+
+typedef struct Summary
+{
+	uint64_t	numberOfCircuits;
+	uint64_t	numberOfShots;
+	uint64_t	numberOfOnes;
+	double		covarianceSum;
+	double		varianceSum;
+	double		expectedNumberOfOnes;
+} Summary;
+
+static void
+printUsage(void)
+{
+	fprintf(stderr, "Usage: shotRecordReader [options] <shot_record_file>...\n"
+		"[--counts] (Print the outcome counts of every circuit.)\n"
+		"[--experiment <experiment_number : uint64>] (Only circuits of this experiment.)\n");
+}
+
+/*
+ *	Map one shot record file and fold its circuits into the summary.
+ */
+static int
+readShotRecordFile(const char *  path, const Options *  options, Summary *  summary)
+{
+	const ShotRecordFileHeader *	header;
+	const char *			cursor;
+	const char *			end;
+	struct stat			status;
+	void *				mapping;
+	int				fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		fprintf(stderr, "\nError: Could not open shot record file '%s'.\n", path);
+
+		return 1;
+	}
+
+	if ((fstat(fd, &status) != 0) || (status.st_size < (off_t) sizeof(ShotRecordFileHeader)))
+	{
+		fprintf(stderr, "\nError: '%s' is too short to be a shot record file.\n", path);
+		close(fd);
+
+		return 1;
+	}
+
+	mapping = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+	{
+		fprintf(stderr, "\nError: Could not map shot record file '%s'.\n", path);
+
+		return 1;
+	}
+
+	madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+
+	header = (const ShotRecordFileHeader *) mapping;
+	if ((memcmp(header->magic, kShotRecordMagic, sizeof(header->magic)) != 0) || (header->circuitHeaderSize != sizeof(ShotRecordCircuitHeader)))
+	{
+		fprintf(stderr, "\nError: '%s' is not a shot record file with %zu-byte circuit headers.\n", path, sizeof(ShotRecordCircuitHeader));
+		munmap(mapping, status.st_size);
+
+		return 1;
+	}
+
+	/*
+	 *	A trailing partial circuit, e.g. from an interrupted run, is ignored.
+	 */
+	cursor = (const char *) (header + 1);
+	end = (const char *) mapping + status.st_size;
+
+	while (end - cursor >= (ptrdiff_t) sizeof(ShotRecordCircuitHeader))
+	{
+		const ShotRecordCircuitHeader *	circuit = (const ShotRecordCircuitHeader *) cursor;
+		const uint64_t *		words = (const uint64_t *) (circuit + 1);
+		uint64_t			numberOfWords = (circuit->numberOfShots + kShotRecordShotsPerWord - 1) / kShotRecordShotsPerWord;
+		uint64_t			numberOfOnes;
+
+		if ((uint64_t) (end - (const char *) words) / sizeof(uint64_t) < numberOfWords)
+		{
+			break;
+		}
+		cursor = (const char *) (words + numberOfWords);
+
+		if (options->experimentKnown && (circuit->experimentNo != options->experimentNo))
+		{
+			continue;
+		}
+
+		numberOfOnes = countShotRecordOnes(words, circuit->numberOfShots);
+
+		/*
+		 *	The autocorrelation is taken about the mean of each circuit, since
+		 *	the circuits have different probabilities.
+		 */
+		if (circuit->numberOfShots > 1)
+		{
+			double	probabilityOfOne = (double) numberOfOnes / circuit->numberOfShots;
+			double	numberOfPairs = (double) (circuit->numberOfShots - 1);
+
+			summary->covarianceSum += countShotRecordOnePairs(words, circuit->numberOfShots) - numberOfPairs * probabilityOfOne * probabilityOfOne;
+			summary->varianceSum += numberOfPairs * probabilityOfOne * (1 - probabilityOfOne);
+		}
+
+		summary->numberOfCircuits++;
+		summary->numberOfShots += circuit->numberOfShots;
+		summary->numberOfOnes += numberOfOnes;
+		summary->expectedNumberOfOnes += (1 - circuit->probabilityOfZero) * circuit->numberOfShots;
+
+		if (options->printCounts)
+		{
+			printf("%" PRIu64 " %" PRIu64 " %.17g %.17g %" PRIu64 " %" PRIu64 "\n", circuit->experimentNo, circuit->iteration, circuit->M, circuit->theta, circuit->numberOfShots - numberOfOnes, numberOfOnes);
+		}
+	}
+
+	munmap(mapping, status.st_size);
+
+	return 0;
+}
+
+int
+main(int argc, char *  argv[])
+{
+	Options		options = {0};
+	Summary		summary = {0};
+	struct timespec	startTime;
+	struct timespec	endTime;
+	double		elapsedTime;
+	int		opt;
+	int		i;
+
+	while ((opt = getopt_long(argc, argv, "h", kLongOptions, NULL)) != EOF)
+	{
+		switch (opt)
+		{
+			case kLongOptionCounts:
+				options.printCounts = true;
+				break;
+			case kLongOptionExperiment:
+				options.experimentKnown = true;
+				options.experimentNo = strtoull(optarg, NULL, 10);
+				break;
+			default:
+				printUsage();
+
+				return (opt == 'h') ? 0 : 1;
+		}
+	}
+
+	if (optind >= argc)
+	{
+		printUsage();
+
+		return 1;
+	}
+
+	if (options.printCounts)
+	{
+		printf("# experiment iteration M theta count_0 count_1\n");
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+	for (i = optind; i < argc; i++)
+	{
+		if (readShotRecordFile(argv[i], &options, &summary))
+		{
+			return 1;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+	elapsedTime = (endTime.tv_sec - startTime.tv_sec) + 1e-9 * (endTime.tv_nsec - startTime.tv_nsec);
+
+	fprintf(options.printCounts ? stderr : stdout, "Read %" PRIu64 " circuits with %" PRIu64 " shots in %lf s (%le shots/s).\n", summary.numberOfCircuits, summary.numberOfShots, elapsedTime, summary.numberOfShots / fmax(elapsedTime, 1e-9));
+
+	if ((summary.numberOfShots > 0) && !options.printCounts)
+	{
+		double	probabilityOfOne = (double) summary.numberOfOnes / summary.numberOfShots;
+
+		printf("\nOutcome 1: %" PRIu64 " of %" PRIu64 " shots (%lf), %lf expected from the noiseless circuits\n", summary.numberOfOnes, summary.numberOfShots, probabilityOfOne, summary.expectedNumberOfOnes / summary.numberOfShots);
+
+		if (summary.varianceSum > 0.0)
+		{
+			printf("Lag-1 autocorrelation of the outcomes: %lf\n", summary.covarianceSum / summary.varianceSum);
+		}
+	}
+
+	return 0;
+}